@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	AssetLoader.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <Color.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class TextureCache;
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// An image that has been read and decoded, waiting to be uploaded to the GPU.
+struct DecodedImage
+{
+	// Constructor
+	DecodedImage();
+
+	std::string name;          // The name the image was requested with.
+	std::vector<Color> pixels; // The image's colors, starting at the top left, one row at a time.
+	unsigned width;
+	unsigned height;
+	bool succeeded;            // Whether the file could be read and decoded.
+};
+
+// Reads and decodes image files on background threads, so loading doesn't block the main thread.
+// Anything that needs the graphics context (such as creating textures) is left to the caller.
+class AssetLoader
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   threadCount = How many worker threads to use, or 0 to choose based on the hardware.
+	AssetLoader(unsigned threadCount = 0);
+
+	// Destructor
+	~AssetLoader();
+
+	// Sets the cache to check before decoding, and to add newly decoded images to.
+	// Must be called before the first request, since the worker threads use it without locking.
+	// Params:
+	//   cache = The cache to use, or nullptr to always decode.
+	void SetCache(const TextureCache* cache);
+
+	// Queues an image file to be read and decoded. The worker threads are started by the first request.
+	// Params:
+	//   name = The name to give back with the decoded image.
+	//   filename = The path of the file to load.
+	void RequestImage(const std::string& name, const std::string& filename);
+
+	// Takes an image that has finished decoding, if there are any.
+	// Params:
+	//   image = The image that finished decoding.
+	// Returns:
+	//   True if an image was taken, false if none are finished.
+	bool PopDecodedImage(DecodedImage& image);
+
+	// Returns how many requested images have not been taken with PopDecodedImage yet.
+	size_t GetPendingCount() const;
+
+	// Forgets every request that hasn't started and every image that hasn't been taken.
+	// Images already being decoded are finished, and can still be popped afterward.
+	void Clear();
+
+	// Reads and decodes an image file on the calling thread, for when the image is needed right away.
+	// Params:
+	//   filename = The path of the file to load.
+	//   image = The image to store the decoded size and colors in.
+	//   cache = The cache to check before decoding, and to add the image to, if any.
+	// Returns:
+	//   True if the file could be read and decoded, false otherwise.
+	static bool DecodeImageFile(const std::string& filename, DecodedImage& image, const TextureCache* cache = nullptr);
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	struct ImageRequest
+	{
+		std::string name;
+		std::string filename;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Disable copying, since the worker threads refer to this loader.
+	AssetLoader(const AssetLoader& other) = delete;
+	AssetLoader& operator=(const AssetLoader& other) = delete;
+
+	// Starts the worker threads if they aren't running.
+	void StartThreads();
+
+	// Decodes requests until the loader is destroyed.
+	void WorkerThread();
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	unsigned threadCount;
+	std::vector<std::thread> threads;
+	const TextureCache* cache;
+
+	// Guards everything below.
+	mutable std::mutex mutex;
+	std::condition_variable requestAdded;
+
+	std::deque<ImageRequest> requests;
+	std::deque<DecodedImage> decodedImages;
+	size_t decodingCount;
+	bool stopping;
+};
+
+//------------------------------------------------------------------------------
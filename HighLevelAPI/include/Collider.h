@@ -26,6 +26,9 @@
 class Transform;
 class Physics;
 class GameObject;
+class SupportShape;
+struct GJKCache;
+struct ContactManifold;
 
 //------------------------------------------------------------------------------
 // Public Consts:
@@ -41,6 +44,13 @@ typedef enum ColliderType
 	ColliderTypeConvex,
 } ColliderType;
 
+typedef enum CollisionEventType
+{
+	CollisionEventEnter, // The colliders started touching this step.
+	CollisionEventStay,  // The colliders are touching this step (sent every step, including the first).
+	CollisionEventExit,  // The colliders stopped touching, or one of them was destroyed.
+} CollisionEventType;
+
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
@@ -92,19 +102,78 @@ public:
 	//	 other = Reference to the second collider component.
 	void CheckCollision(const Collider& other);
 
+	// Checks whether a circle with continuous collision enabled swept through another
+	// collider during the last step, which IsCollidingWith can miss for fast objects.
+	// Params:
+	//	 other = Reference to the second collider component.
+	// Returns:
+	//   True if either collider is a continuous circle that touched the other, false otherwise.
+	bool IsSweptCollidingWith(const Collider& other) const;
+
+	// Calls this collider's handler for a collision event, if it has one.
+	// Params:
+	//   type = Which event happened.
+	//   other = Reference to the other collider in the pair.
+	void SendCollisionEvent(CollisionEventType type, const Collider& other) const;
+
 	// Perform intersection test between two arbitrary colliders.
 	// Params:
 	//	 other = Reference to the second collider component.
 	virtual bool IsCollidingWith(const Collider& other) const = 0;
 
+	// Describes this collider's world space shape for GJK.
+	// Params:
+	//   shape = The shape to fill in.
+	// Returns:
+	//   False if the collider can't be described as a single convex shape (lines, tilemaps).
+	virtual bool GetSupportShape(SupportShape& shape) const;
+
+	// Calculates the contact normal, depth, and points between two colliders.
+	// Params:
+	//   other = Reference to the second collider component.
+	//   manifold = The contact manifold, only valid if the colliders intersect.
+	//   cache = The GJK simplex from the last time this pair was tested, or nullptr.
+	// Returns:
+	//   True if both colliders are convex shapes and they intersect, false otherwise.
+	bool GetContact(const Collider& other, ContactManifold& manifold, GJKCache* cache = nullptr) const;
+
 	// Get the type of this component.
 	ColliderType GetType() const;
 
-	// Sets the collision handler function for the collider.
+	// Records whether the transform has moved since the last collision step. Called once at
+	// the start of each step, before any pairs are tested.
+	void BeginCollisionStep();
+
+	// Checks whether pairs between this collider and another sleeping one can be skipped.
+	// Returns:
+	//   True if the collider belongs to a sleeping physics body, or it has no physics body
+	//   and wasn't moved between the last two collision steps, false otherwise.
+	bool IsAsleep() const;
+
+	// Sets which layers this collider is on, for filtering collision queries.
+	// Params:
+	//   layers = A bitmask of layers. Defaults to 1 (the first layer).
+	void SetLayers(unsigned layers);
+
+	// Gets which layers this collider is on.
+	unsigned GetLayers() const;
+
+	// Sets the collision handler function for the collider, called on every
+	// step while this collider is touching another.
 	// Params:
 	//   handler = A pointer to the collision handler function.
 	void SetCollisionHandler(CollisionEventHandler handler);
 
+	// Sets the function called once when this collider starts touching another.
+	// Params:
+	//   handler = A pointer to the collision handler function.
+	void SetCollisionEnterHandler(CollisionEventHandler handler);
+
+	// Sets the function called once when this collider stops touching another.
+	// Params:
+	//   handler = A pointer to the collision handler function.
+	void SetCollisionExitHandler(CollisionEventHandler handler);
+
 	// Sets the map collision handler function for the collider.
 	// Params:
 	//   handler = A pointer to the collision handler function.
@@ -125,11 +194,24 @@ private:
 	// The type of collider used by this component.
 	ColliderType type;
 
-	// Function pointer for collision handler
+	// Bitmask of layers this collider is on
+	unsigned layers;
+
+	// Function pointer for collision handler, called every step while touching
 	CollisionEventHandler handler;
+
+	// Function pointers for collision handlers called when contact starts and ends
+	CollisionEventHandler enterHandler;
+	CollisionEventHandler exitHandler;
 	
 	// Function pointer for tilemap collision handling
 	MapCollisionEventHandler mapHandler;
+
+	// The transform's matrix version at the start of the last collision step, and whether
+	// the step before that saw the same version. Only used by colliders without physics.
+	unsigned stepVersion;
+	bool stepped;
+	bool unmoved;
 };
 
 //------------------------------------------------------------------------------
@@ -20,6 +20,9 @@
 // Forward Declarations
 //------------------------------------------------------------------------------
 struct LineSegment;
+struct SoAPoints;
+class Vector2D;
+class Transform;
 
 //------------------------------------------------------------------------------
 // Public Structures
@@ -34,6 +37,30 @@ private:
 
 	// The local points of the collider
 	std::vector<LineSegment> localLines;
+
+	// World space copies of the line segments, their end points, and their normals.
+	// Rebuilt only when the transform's matrix changes, and reused between tests.
+	mutable std::vector<LineSegment> worldLines;
+	mutable std::vector<Vector2D> worldVertices;
+	mutable std::vector<Vector2D> worldNormals;
+
+	// The same vertices split into x and y arrays, and the normals with parallel duplicates
+	// removed, so the separating axis test can project several points at a time.
+	mutable std::vector<float> worldX;
+	mutable std::vector<float> worldY;
+	mutable std::vector<float> axesX;
+	mutable std::vector<float> axesY;
+
+	// The transform and matrix version the world space data was built from.
+	mutable const Transform* cachedTransform;
+	mutable unsigned cachedVersion;
+
+	//------------------------------------------------------------------------------
+	// Private Functions
+	//------------------------------------------------------------------------------
+
+	// Rebuilds the world space line segments, vertices, normals, and axes if the transform has changed.
+	void UpdateWorldData() const;
 public:
 	//------------------------------------------------------------------------------
 	// Public Functions
@@ -84,6 +111,13 @@ public:
 	//	Whether the two colliders are colliding with each other
 	bool IsCollidingWith(const Collider& with) const override;
 
+	// Describes this collider's world space shape for GJK.
+	// Params:
+	//   shape = The shape to fill in.
+	// Returns:
+	//   False if the collider has no sides.
+	bool GetSupportShape(SupportShape& shape) const override;
+
 	// Gets the line segments of the convex collider in local space
 	// Returns:
 	//	A list with the line segments of the line collider
@@ -92,6 +126,26 @@ public:
 	// Gets the line segments transformed to world space
 	// Returns:
 	//	A list with the line segments transformed to world space
-	std::vector<LineSegment> GetLineSegments() const;
+	const std::vector<LineSegment>& GetLineSegments() const;
+
+	// Gets the end point of every line segment in world space
+	// Returns:
+	//	A list with the vertices of the convex polygon in world space
+	const std::vector<Vector2D>& GetWorldVertices() const;
+
+	// Gets the normal of every line segment in world space
+	// Returns:
+	//	A list with the edge normals of the convex polygon in world space
+	const std::vector<Vector2D>& GetWorldNormals() const;
+
+	// Gets the world space vertices as separate x and y arrays
+	// Returns:
+	//	A view of the vertices, valid until the transform changes
+	SoAPoints GetWorldPoints() const;
+
+	// Gets the world space edge normals, skipping any that are parallel to an earlier one
+	// Returns:
+	//	A view of the axes, valid until the transform changes
+	SoAPoints GetWorldAxes() const;
 
 };
\ No newline at end of file
@@ -25,6 +25,7 @@
 //------------------------------------------------------------------------------
 
 class Vector2D;
+class Transform;
 
 //------------------------------------------------------------------------------
 // Public Consts:
@@ -86,9 +87,55 @@ public:
 	// Gets a line segment that incorporates the transform of the object
 	// Params:
 	//   index = The index of the line within the array of line segments.
-	LineSegment GetLineWithTransform(unsigned index) const;
+	// Returns:
+	//   The world space segment, cached until the transform or segments change.
+	const LineSegment& GetLineWithTransform(unsigned index) const;
+
+	// Gets how many line segments the collider has.
+	unsigned GetLineCount() const;
 
 private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A node in the bounding volume hierarchy over the (local space) segments.
+	// Children of a node are stored right after it, so only the second child's index is kept.
+	struct BVHNode
+	{
+		Vector2D boundsMin;   // Bottom left of the box around every segment under this node.
+		Vector2D boundsMax;   // Top right of the box around every segment under this node.
+		unsigned first;       // For leaves, the first entry in bvhSegments.
+		unsigned count;       // For leaves, how many segments there are. 0 for branches.
+		unsigned secondChild; // For branches, the index of the second child.
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Recalculates the world space segments if the transform or segments changed.
+	void UpdateWorldData() const;
+
+	// Finds the segment a moving point hits first.
+	// Params:
+	//   movingPoint = The world space movement of the point.
+	//   index = The index of the segment that was hit.
+	//   intersection = Where the point hit the segment.
+	//   t = How far along the movement the hit happened.
+	//   findFirst = False to stop at any hit instead of finding the earliest.
+	// Returns:
+	//   True if the point hit any segment, false otherwise.
+	bool FindIntersection(const LineSegment& movingPoint, unsigned& index, Vector2D& intersection, float& t, bool findFirst) const;
+
+	// Rebuilds the hierarchy over the segments, or clears it if there are too few segments to need one.
+	void BuildBVH() const;
+
+	// Builds a node, and the nodes below it, for a range of bvhSegments.
+	// Params:
+	//   first = The first entry in bvhSegments under the node.
+	//   count = How many entries are under the node.
+	void BuildBVHNode(unsigned first, unsigned count) const;
 
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -102,6 +149,18 @@ private:
 
 	// Should the collider perform reflection
 	bool reflection;
+
+	// World space segments, cached between collision checks.
+	mutable std::vector<LineSegment> worldSegments;
+
+	// The transform and matrix version the world space segments were built from.
+	mutable const Transform* cachedTransform;
+	mutable unsigned cachedVersion;
+
+	// Hierarchy over the local space segments, rebuilt when segments are added.
+	mutable std::vector<BVHNode> bvhNodes;
+	mutable std::vector<unsigned> bvhSegments;
+	mutable bool bvhDirty;
 };
 
 //------------------------------------------------------------------------------
@@ -51,6 +51,13 @@ public:
 	// Returns:
 	//	 Return the results of the collision check.
 	bool IsCollidingWith(const Collider& other) const override;
+
+	// Describes this collider's world space shape for GJK.
+	// Params:
+	//   shape = The shape to fill in.
+	// Returns:
+	//   True, points are always convex.
+	bool GetSupportShape(SupportShape& shape) const override;
 };
 
 //------------------------------------------------------------------------------
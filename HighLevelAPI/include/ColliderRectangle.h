@@ -17,6 +17,16 @@
 
 #include "Collider.h"
 #include "Vector2D.h"
+#include "Shapes2D.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward Declarations:
+//------------------------------------------------------------------------------
+
+class Transform;
+struct SoAPoints;
 
 //------------------------------------------------------------------------------
 
@@ -75,13 +85,62 @@ public:
 	//	 Return the results of the collision check.
 	bool IsCollidingWith(const Collider& other) const override;
 
+	// Describes this collider's world space shape for GJK.
+	// Params:
+	//   shape = The shape to fill in.
+	// Returns:
+	//   True, rectangles are always convex.
+	bool GetSupportShape(SupportShape& shape) const override;
+
+	// Get the rectangle's corners in world space, recalculated only when the transform changes.
+	// Returns:
+	//	 A pointer to the four corners, in the same order as GetOBBCorners.
+	const Vector2D* GetWorldCorners() const;
+
+	// Get the world space axis-aligned box around the rectangle. For rectangles
+	// whose transform is axis-aligned, this is the rectangle itself.
+	// Returns:
+	//	 A reference to the bounding rectangle.
+	const BoundingRectangle& GetWorldBounds() const;
+
+	// Get the world space corners as separate x and y arrays.
+	// Returns:
+	//	 A view of the four corners, valid until the transform changes.
+	SoAPoints GetWorldCornerPoints() const;
+
+	// Get the rectangle's two world space axes. The other two sides are parallel to these.
+	// Returns:
+	//	 A view of the two axes, valid until the transform changes.
+	SoAPoints GetWorldAxes() const;
+
 private:
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Recalculates the world space corners, bounds, and axes if the transform or extents changed.
+	void UpdateWorldData() const;
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
 
 	// Extents of the rectangle collider.
 	Vector2D extents;
+
+	// World space corners and bounds, cached between collision tests.
+	mutable Vector2D worldCorners[4];
+	mutable BoundingRectangle worldBounds;
+
+	// The corners and axes split into x and y arrays for the SIMD separating axis test.
+	mutable float cornersX[4];
+	mutable float cornersY[4];
+	mutable float axesX[2];
+	mutable float axesY[2];
+
+	// The transform and matrix version the world space data was built from.
+	mutable const Transform* cachedTransform;
+	mutable unsigned cachedVersion;
 };
 
 //------------------------------------------------------------------------------
@@ -25,22 +25,26 @@
 //------------------------------------------------------------------------------
 
 class Tilemap;
-struct BoundingRectangle;
+
+namespace CS230
+{
+	class Matrix2D;
+}
 
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
 
-// Enum for sides of bounding rectangle
-enum RectangleSide
+// Where a ray or shape cast first touched a solid tile.
+struct TilemapRaycastHit
 {
-	SideBottom,
-	SideTop,
-	SideLeft,
-	SideRight,
+	TilemapRaycastHit();
 
-	// Number of sides
-	SideCount,
+	float distance;     // How far along the cast (in world units) the hit occurred.
+	Vector2D position;  // Where the ray, or the center of the shape, was at the time of the hit.
+	Vector2D normal;    // The face of the tile that was hit, pointing back toward the cast.
+	int column;         // The column of the tile that was hit.
+	int row;            // The row of the tile that was hit.
 };
 
 // Tilemap collider class - goes on Tilemap object
@@ -74,45 +78,140 @@ public:
 	//   map = A pointer to the tilemap resource.
 	void SetTilemap(const Tilemap* map);
 
+	// Gets the tilemap this collider uses.
+	const Tilemap* GetTilemap() const;
+
+	// Finds the first solid tile along a ray, visiting only the cells the ray passes through.
+	// Params:
+	//   start = Where the ray starts, in world space.
+	//   direction = Which way the ray goes. Doesn't need to be normalized.
+	//   maxDistance = How far the ray goes, in world units.
+	//   hit = Information about the first tile hit, only valid if this returns true.
+	// Returns:
+	//   True if the ray hit a solid tile, false otherwise.
+	bool Raycast(const Vector2D& start, const Vector2D& direction, float maxDistance, TilemapRaycastHit& hit) const;
+
+	// Finds the first solid tile an axis-aligned box touches as it moves along a ray.
+	// Params:
+	//   center = Where the center of the box starts, in world space.
+	//   extents = The half-width and half-height of the box, in world units.
+	//   direction = Which way the box moves. Doesn't need to be normalized.
+	//   maxDistance = How far the box moves, in world units.
+	//   hit = Information about the first tile hit, only valid if this returns true.
+	// Returns:
+	//   True if the box hit a solid tile, false otherwise.
+	bool BoxCast(const Vector2D& center, const Vector2D& extents, const Vector2D& direction, float maxDistance, TilemapRaycastHit& hit) const;
+
+	// Same as the member version, but for callers that keep their own copy of the map's
+	// placement instead of reading it from a live transform (e.g. collision query snapshots).
+	// Params:
+	//   map = The tilemap to cast against.
+	//   inverse = The inverse of the map's world matrix.
+	//   scale = The map's world scale (the size of one tile).
+	//   center = Where the center of the box starts, in world space.
+	//   extents = The half-width and half-height of the box, in world units.
+	//   direction = Which way the box moves. Doesn't need to be normalized.
+	//   maxDistance = How far the box moves, in world units.
+	//   hit = Information about the first tile hit, only valid if this returns true.
+	// Returns:
+	//   True if the box hit a solid tile, false otherwise.
+	static bool BoxCast(const Tilemap& map, const CS230::Matrix2D& inverse, const Vector2D& scale, const Vector2D& center,
+		const Vector2D& extents, const Vector2D& direction, float maxDistance, TilemapRaycastHit& hit);
+
+	// Checks many line segments against the map at once, e.g. for AI line of sight.
+	// Params:
+	//   starts = The start point of each segment, in world space.
+	//   ends = The end point of each segment, in world space.
+	//   count = How many segments there are.
+	//   blocked = Output array, set to whether each segment hit a solid tile.
+	//   hits = Optional output array of hit information, only valid where blocked is true.
+	// Returns:
+	//   How many segments were blocked.
+	size_t RaycastBatch(const Vector2D* starts, const Vector2D* ends, size_t count, bool* blocked, TilemapRaycastHit* hits = nullptr) const;
+
+	// Determines whether a cell in a tilemap is solid.
+	// Params:
+	//   map = The tilemap to check.
+	//   column = The column of the cell.
+	//   row = The row of the cell.
+	// Returns:
+	//   False if the cell is outside the map or empty, true if there is a tile there.
+	static bool IsCellSolid(const Tilemap& map, int column, int row);
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
 
-	// Checks whether the specified side of a given rectangle is colliding with the tilemap.
+	// Moves a box along one axis through the grid, stopping it at the first solid cell
+	// in its way. Only the cells the leading edge crosses are visited.
+	// Params:
+	//   position = The center of the box in grid space.
+	//   extents = The half-size of the box in grid space.
+	//   distance = How far the box moves along the axis.
+	//   axis = 0 for the x-axis (columns), 1 for the y-axis (rows).
+	//   sides = Updated with the side of the box that hit a cell, if any.
+	// Returns:
+	//   The box's new position along the axis.
+	float SweepAxis(const Vector2D& position, const Vector2D& extents, float distance, unsigned axis, MapCollision& sides) const;
+
+	// Moves a box through the grid along a straight line, finding the first solid cell it
+	// touches. Steps from one cell boundary to the next (Amanatides-Woo), checking only the
+	// cells the box's leading edges enter. A ray is a box with no size.
+	// Params:
+	//   map = The tilemap to walk through.
+	//   start = The center of the box in grid space.
+	//   extents = The half-size of the box in grid space.
+	//   movement = How far the box moves, in grid space.
+	//   time = How far along the movement (0 to 1) the box first touched a solid cell.
+	//   column = The column of the cell that was hit.
+	//   row = The row of the cell that was hit.
+	//   normal = The world space face normal of the cell that was hit.
+	// Returns:
+	//   True if a solid cell was touched, false otherwise.
+	static bool CastGrid(const Tilemap& map, const Vector2D& start, const Vector2D& extents, const Vector2D& movement, float& time, int& column, int& row, Vector2D& normal);
+
+	// Checks which sides of a box overlap solid cells, without moving it.
 	// Params:
-	//   rectangle = The bounding rectangle for an object.
-	//   side = The side that needs to be tested for collision.
+	//   position = The center of the box in grid space.
+	//   extents = The half-size of the box in grid space.
+	//   sides = Updated with the sides of the box facing each solid cell it overlaps.
 	// Returns:
-	//   True if there is a collision, false otherwise.
-	bool IsSideColliding(const BoundingRectangle& rectangle, RectangleSide side) const;
+	//   True if the box overlaps any solid cell, false otherwise.
+	bool FindOverlapSides(const Vector2D& position, const Vector2D& extents, MapCollision& sides) const;
 
-	// Determines whether a point is within a collidable cell in the tilemap.
+	// Moves a box out of the solid cells it overlaps, along whichever direction needs
+	// the shortest move. Sweeps can't see cells a box is already inside, so this runs first.
 	// Params:
-	//   x = The x component of the point, in world coordinates.
-	//   y = The y component of the point, in world coordinates.
+	//   position = The center of the box in grid space.
+	//   extents = The half-size of the box in grid space.
+	//   sides = Updated with the side of the box the cells were pushed away from, if any.
 	// Returns:
-	//   False if the point is outside the map or the map is empty at that position, 
-	//   or true if there is a tile at that position.
-	bool IsCollidingAtPosition(float x, float y) const;
+	//   The box's new position.
+	Vector2D PushOutOfCells(const Vector2D& position, const Vector2D& extents, MapCollision& sides) const;
 
-	// Moves an object and sets its velocity based on where it collided with the tilemap.
+	// Determines whether a cell in the tilemap is solid.
 	// Params:
-	//   objectRectangle = A bounding rectangle that encompasses the object.
-	//   objectTransform = Pointer to the object's transform component.
-	//   objectPhysics = Pointer to the object's physics component.
-	//   collisions = True/false values from map collision checks.
-	void ResolveCollisions(const BoundingRectangle& objectRectangle, Transform* objectTransform, 
-		Physics* objectPhysics, const MapCollision& collisions) const;
-
-	// Returns the center of the next tile on the x-axis or y-axis.
-	// Used for assisting in collision resolution on a particular side.
+	//   column = The column of the cell.
+	//   row = The row of the cell.
+	// Returns:
+	//   False if the cell is outside the map or empty, true if there is a tile there.
+	bool IsCellSolid(int column, int row) const;
+
+	// Converts a world space position into grid space, where cell (column, row)
+	// covers [column, column + 1) x [row, row + 1) and rows grow downward.
+	// Params:
+	//   position = The world space position.
+	// Returns:
+	//   The position in grid space.
+	Vector2D WorldToGrid(const Vector2D& position) const;
+
+	// Converts a grid space position back into world space.
 	// Params:
-	//   side = Which side the collision is occurring on.
-	//   sidePosition = The x or y value of that side.
+	//   position = The grid space position.
 	// Returns:
-	//   The center of the next tile for the given position on the given side.
-	float GetNextTileCenter(RectangleSide side, float sidePosition) const;
+	//   The position in world space.
+	Vector2D GridToWorld(const Vector2D& position) const;
 
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	CollisionQueries.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <Vector2D.h>
+#include "GJK.h"
+#include "Matrix2DStudent.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward Declarations:
+//------------------------------------------------------------------------------
+
+class GameObject;
+class Tilemap;
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+// A layer mask containing every layer, for queries that shouldn't filter anything out.
+const unsigned QueryAllLayers = 0xFFFFFFFF;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// An object found by a collision query.
+struct QueryHit
+{
+	QueryHit();
+
+	GameObject* object;  // The object that was found.
+	float distance;      // Raycasts: how far along the ray the hit was. Other queries: how far the
+	                     // query point or shape is from the object's surface (0 if they overlap).
+	Vector2D point;      // Raycasts: where the ray hit. Other queries: the closest point on the object.
+	Vector2D normal;     // Raycasts only: the surface normal where the ray hit.
+};
+
+// A raycast submitted as part of a batch.
+struct RaycastQuery
+{
+	RaycastQuery(const Vector2D& start = Vector2D(), const Vector2D& direction = Vector2D(1.0f, 0.0f),
+		float maxDistance = 0.0f, unsigned layerMask = QueryAllLayers);
+
+	Vector2D start;      // Where the ray starts.
+	Vector2D direction;  // Which way the ray goes. Doesn't need to be normalized.
+	float maxDistance;   // How far the ray goes.
+	unsigned layerMask;  // Which collider layers the ray can hit.
+};
+
+// Answers raycast, overlap, and nearest object queries against a snapshot of every
+// collider in a space. The snapshot copies each collider's world space shape and bounds,
+// so the query functions never touch the objects themselves. Tilemaps copy their matrices
+// but share their tile data, so changing a tilemap's cells isn't safe while queries run.
+// Queries can be called from any number of threads at once, as long as nobody rebuilds
+// the snapshot at the same time.
+// There is no broadphase yet, so queries test every collider's bounds before its shape.
+class CollisionQueries
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Creates an empty snapshot.
+	CollisionQueries();
+
+	// Takes a new snapshot of the colliders on a list of objects. Destroyed objects,
+	// objects without colliders, and line colliders are skipped.
+	// Params:
+	//   objects = The objects to take the snapshot of.
+	void Rebuild(const std::vector<GameObject*>& objects);
+
+	// Empties the snapshot, e.g. before the objects in it are deleted.
+	void Clear();
+
+	// Gets how many colliders are in the snapshot.
+	size_t GetColliderCount() const;
+
+	// Finds the first collider along a ray.
+	// Params:
+	//   start = Where the ray starts.
+	//   direction = Which way the ray goes. Doesn't need to be normalized.
+	//   maxDistance = How far the ray goes.
+	//   hit = Information about the closest hit, only valid if this returns true.
+	//   layerMask = Which collider layers the ray can hit.
+	// Returns:
+	//   True if the ray hit something, false otherwise.
+	bool Raycast(const Vector2D& start, const Vector2D& direction, float maxDistance, QueryHit& hit,
+		unsigned layerMask = QueryAllLayers) const;
+
+	// Runs many raycasts at once.
+	// Params:
+	//   queries = The raycasts to run.
+	//   count = How many raycasts there are.
+	//   results = Output array, set to whether each ray hit something.
+	//   hits = Output array of hit information, only valid where results is true.
+	// Returns:
+	//   How many rays hit something.
+	size_t RaycastBatch(const RaycastQuery* queries, size_t count, bool* results, QueryHit* hits) const;
+
+	// Finds every collider that overlaps a circle.
+	// Params:
+	//   center = The center of the circle.
+	//   radius = The radius of the circle.
+	//   results = Filled with the colliders that overlap the circle.
+	//   layerMask = Which collider layers can be found.
+	// Returns:
+	//   How many colliders were found.
+	size_t OverlapCircle(const Vector2D& center, float radius, std::vector<QueryHit>& results,
+		unsigned layerMask = QueryAllLayers) const;
+
+	// Finds every collider that overlaps an axis-aligned box.
+	// Params:
+	//   center = The center of the box.
+	//   extents = The half-width and half-height of the box.
+	//   results = Filled with the colliders that overlap the box.
+	//   layerMask = Which collider layers can be found.
+	// Returns:
+	//   How many colliders were found.
+	size_t OverlapBox(const Vector2D& center, const Vector2D& extents, std::vector<QueryHit>& results,
+		unsigned layerMask = QueryAllLayers) const;
+
+	// Finds the colliders closest to a point, nearest first. Tilemaps are ignored.
+	// Params:
+	//   point = The point to search around.
+	//   count = The most colliders to find.
+	//   results = Filled with the closest colliders.
+	//   layerMask = Which collider layers can be found.
+	// Returns:
+	//   How many colliders were found.
+	size_t FindNearest(const Vector2D& point, unsigned count, std::vector<QueryHit>& results,
+		unsigned layerMask = QueryAllLayers) const;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A collider in the snapshot.
+	struct Entry
+	{
+		GameObject* object;              // The object the collider belongs to.
+		const Tilemap* map;              // The tile data, if the collider is a tilemap.
+		CS230::Matrix2D matrix;          // Tilemaps only: the map's world matrix.
+		CS230::Matrix2D inverse;         // Tilemaps only: the inverse of the map's world matrix.
+		Vector2D scale;                  // Tilemaps only: the map's world scale (the size of one tile).
+		unsigned layers;                 // Which layers the collider is on.
+		Vector2D boundsMin;              // Bottom left of the collider's world space bounds.
+		Vector2D boundsMax;              // Top right of the collider's world space bounds.
+		unsigned firstVertex;            // Where the collider's core starts in the vertex list.
+		unsigned vertexCount;            // How many vertices the core has.
+		float radius;                    // How much the core is rounded by.
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Gets the shape of a (non-tilemap) entry.
+	SupportShape GetShape(const Entry& entry) const;
+
+	// Finds every collider that overlaps a query shape.
+	// Params:
+	//   query = The query shape.
+	//   boundsMin = Bottom left of the query shape's bounds.
+	//   boundsMax = Top right of the query shape's bounds.
+	//   results = Filled with the colliders that overlap the shape.
+	//   layerMask = Which collider layers can be found.
+	// Returns:
+	//   How many colliders were found.
+	size_t Overlap(const SupportShape& query, const Vector2D& boundsMin, const Vector2D& boundsMax,
+		std::vector<QueryHit>& results, unsigned layerMask) const;
+
+	// Checks whether a query shape overlaps any solid tile in a tilemap entry.
+	// Params:
+	//   query = The query shape.
+	//   boundsMin = Bottom left of the query shape's bounds.
+	//   boundsMax = Top right of the query shape's bounds.
+	//   entry = The tilemap entry.
+	//   point = The closest point on the first tile found to overlap the shape.
+	// Returns:
+	//   True if the shape overlaps a solid tile, false otherwise.
+	bool OverlapTiles(const SupportShape& query, const Vector2D& boundsMin, const Vector2D& boundsMax,
+		const Entry& entry, Vector2D& point) const;
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Every collider in the snapshot.
+	std::vector<Entry> entries;
+
+	// The world space core vertices of every collider, end to end.
+	std::vector<Vector2D> vertices;
+};
+
+//------------------------------------------------------------------------------
@@ -48,6 +48,13 @@ public:
 
 	// Retrieve component's owner object (if any).
 	GameObject* GetOwner() const;
+
+	// Whether FixedUpdate can run on a worker thread, alongside other objects' fixed updates.
+	// Components that only change their own object can return true. Components that use
+	// other objects or the engine's systems (input, graphics, sound) must run on the main thread.
+	// Returns:
+	//   False by default.
+	virtual bool IsFixedUpdateThreadSafe() const;
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GJK.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <Vector2D.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// A convex shape described by its support function: a point or convex polygon
+// (the core), optionally rounded by a radius. Points are cores of one vertex and
+// circles are points with a radius.
+class SupportShape
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Creates an empty shape.
+	SupportShape();
+
+	// Creates a shape for a single point.
+	// Params:
+	//   point = The point in world space.
+	static SupportShape FromPoint(const Vector2D& point);
+
+	// Creates a shape for a circle.
+	// Params:
+	//   center = The center of the circle in world space.
+	//   radius = The radius of the circle.
+	static SupportShape FromCircle(const Vector2D& center, float radius);
+
+	// Creates a shape for an oriented box. The corners are copied into the shape.
+	// Params:
+	//   corners = The world space corners of the box, in order around the box.
+	static SupportShape FromBox(const Vector2D corners[4]);
+
+	// Creates a shape for a convex polygon. The vertices are NOT copied, so they
+	// must outlive the shape.
+	// Params:
+	//   vertices = The world space vertices of the polygon, in order around the polygon.
+	//   size = How many vertices there are.
+	//   radius = How much to round the polygon by.
+	static SupportShape FromPolygon(const Vector2D* vertices, unsigned size, float radius = 0.0f);
+
+	// Finds the vertex of the core that is farthest along a direction.
+	// Params:
+	//   direction = The direction to search in. Doesn't need to be normalized.
+	// Returns:
+	//   The index of the farthest vertex.
+	unsigned GetSupportIndex(const Vector2D& direction) const;
+
+	// Gets a vertex of the core.
+	// Params:
+	//   index = The index of the vertex.
+	const Vector2D& GetVertex(unsigned index) const;
+
+	// Gets how many vertices the core has.
+	unsigned GetVertexCount() const;
+
+	// Gets the radius the core is rounded by.
+	float GetRadius() const;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Storage for shapes with four or fewer vertices.
+	Vector2D localVertices[4];
+
+	// Storage for larger shapes, owned by someone else. Null when localVertices is used.
+	const Vector2D* vertices;
+
+	// How many vertices are in the core.
+	unsigned count;
+
+	// How much the core is rounded by.
+	float radius;
+};
+
+// The vertices of the last simplex found for a pair of shapes. Passing it back in
+// the next time the same pair is tested lets GJK start from where it left off,
+// which usually means only one or two iterations for resting contacts.
+struct GJKCache
+{
+	GJKCache();
+
+	unsigned count;       // How many vertices are in the simplex, 0 if the cache is empty.
+	unsigned indexA[3];   // Vertices of the first shape used by the simplex.
+	unsigned indexB[3];   // Vertices of the second shape used by the simplex.
+};
+
+// Describes how two shapes are touching.
+struct ContactManifold
+{
+	ContactManifold();
+
+	Vector2D normal;      // Unit vector pointing from the first shape toward the second.
+	float depth;          // How far the shapes overlap along the normal.
+	Vector2D points[2];   // World space contact points.
+	unsigned pointCount;  // How many contact points are valid.
+};
+
+//------------------------------------------------------------------------------
+// Public Function Declarations:
+//------------------------------------------------------------------------------
+
+// Finds the closest points between the cores of two shapes using GJK. Radii are ignored.
+// Params:
+//   shapeA = The first shape.
+//   shapeB = The second shape.
+//   pointA = The closest point on the first core.
+//   pointB = The closest point on the second core.
+//   cache = The simplex from the previous test of the same pair, or nullptr. Updated on return.
+// Returns:
+//   The distance between the cores, zero if they overlap.
+float GJKDistance(const SupportShape& shapeA, const SupportShape& shapeB, Vector2D& pointA, Vector2D& pointB, GJKCache* cache = nullptr);
+
+// Checks whether two shapes intersect and, if so, calculates the contact manifold.
+// Uses GJK for separated or shallow contacts (including rounded shapes) and EPA when
+// the cores overlap. Polygon pairs get up to two contact points from edge clipping.
+// Params:
+//   shapeA = The first shape.
+//   shapeB = The second shape.
+//   manifold = The contact manifold, only valid if the shapes intersect.
+//   cache = The simplex from the previous test of the same pair, or nullptr. Updated on return.
+// Returns:
+//   True if intersection, false otherwise.
+bool ComputeContact(const SupportShape& shapeA, const SupportShape& shapeB, ContactManifold& manifold, GJKCache* cache = nullptr);
+
+// Finds when a circle moving in a straight line first touches a shape, using
+// conservative advancement: the circle is repeatedly moved forward by its GJK
+// distance to the shape, which can never step past the first point of contact.
+// Params:
+//   start = The center of the circle at the start of the movement.
+//   end = The center of the circle at the end of the movement.
+//   radius = The radius of the circle.
+//   target = The shape the circle is moving toward. Should not move during the sweep.
+//   t = How far along the movement (0 to 1) the circle first touches the shape.
+//   normal = Unit vector pointing from the shape toward the circle at that time.
+// Returns:
+//   True if the circle touches the shape during the movement, false otherwise. A circle
+//   still closing in when the iterations run out is treated as touching at that point.
+bool SweptCircleIntersection(const Vector2D& start, const Vector2D& end, float radius, const SupportShape& target, float& t, Vector2D& normal);
+
+//------------------------------------------------------------------------------
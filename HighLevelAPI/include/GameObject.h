@@ -17,6 +17,7 @@
 
 #include <BetaObject.h>
 #include "Serializable.h"
+#include "ResourceTable.h" // Handle
 
 //------------------------------------------------------------------------------
 
@@ -76,6 +77,12 @@ public:
 	//	 dt = A fixed change in time, usually 1/60th of a second.
 	void FixedUpdate(float dt) override;
 
+	// Updates only the components that are, or aren't, safe to update on a worker thread.
+	// Params:
+	//	 dt = A fixed change in time, usually 1/60th of a second.
+	//   threadSafe = Whether to update the components whose IsFixedUpdateThreadSafe returns true, or the rest.
+	void FixedUpdate(float dt, bool threadSafe);
+
 	// Draw any visible components attached to the game object.
 	void Draw() override;
 	
@@ -119,6 +126,17 @@ public:
 	// Get the space that contains this object.
 	Space* GetSpace() const;
 
+	// Gets a handle to this object, which can be kept instead of a pointer
+	// and looked up later, even after the object has been destroyed.
+	Handle<GameObject> GetHandle() const;
+
+	// Finds the object a handle refers to. Safe to call from any thread, and doesn't take a lock.
+	// Params:
+	//   handle = The handle to look up.
+	// Returns:
+	//   The object, or nullptr if it has been destroyed or the handle is invalid.
+	static GameObject* GetObjectByHandle(Handle<GameObject> handle);
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -129,6 +147,9 @@ private:
 
 	// Whether the object has been marked for destruction.
 	bool isDestroyed;
+
+	// This object's slot in the table of live objects.
+	Handle<GameObject> handle;
 };
 
 //------------------------------------------------------------------------------
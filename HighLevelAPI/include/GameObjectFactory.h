@@ -60,6 +60,9 @@ public:
 	// Saves an object to an archetype file so it can be loaded later.
 	void SaveObjectToFile(GameObject* object);
 
+	// Forgets every object loaded from a file, so the next CreateObject reads the file again.
+	void ClearObjectCache();
+
 	// Register a component so it can be created on the fly.
 	// Template parameters:
 	//   ComponentType = The type of the component to be registered.
@@ -82,6 +85,9 @@ private:
 
 	std::string objectFilePath;
 
+	// Objects that have already been read from files, so levels that share objects don't parse them again.
+	std::map<std::string, GameObject*> objectCache;
+
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
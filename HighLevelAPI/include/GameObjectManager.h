@@ -17,6 +17,8 @@
 
 #include <BetaObject.h>
 #include "GameObject.h"
+#include "GJK.h"
+#include "CollisionQueries.h"
 
 //------------------------------------------------------------------------------
 
@@ -26,6 +28,8 @@
 
 class Space;
 class Vector2D;
+class Collider;
+class Physics;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -90,6 +94,57 @@ public:
 	//   objectName = The name of the objects that should be counted.
 	unsigned GetObjectCount(const std::string& objectName) const;
 
+	// Gets the contact manifold between two objects that were touching in the last fixed step.
+	// The manifold is only computed the first time it is asked for after each step, from the
+	// colliders' current positions, so this should be called from the main thread.
+	// Params:
+	//   object1 = The first object. The normal points away from this object.
+	//   object2 = The second object.
+	//   manifold = The manifold, only valid if this returns true.
+	// Returns:
+	//   True if the objects are touching and both have convex colliders, false otherwise.
+	bool GetContactManifold(GameObject& object1, GameObject& object2, ContactManifold& manifold) const;
+
+	// Gets the raycast, overlap, and nearest-collider queries for this space. They see the
+	// colliders as they were at the end of the last update, and can be used from any thread
+	// as long as the objects aren't being updated. The snapshot is only rebuilt by the first
+	// call after the objects have changed, so paused spaces and spaces nobody queries skip it.
+	const CollisionQueries& GetCollisionQueries() const;
+
+	// Sets how many fixed (physics) steps run per second of game time.
+	// Params:
+	//   stepsPerSecond = The fixed update rate, 60 by default.
+	void SetFixedUpdateRate(float stepsPerSecond);
+
+	// Gets the length of a fixed step, in seconds.
+	float GetFixedUpdateDt() const;
+
+	// Sets the most game time the fixed steps will try to catch up on in one frame.
+	// Anything past this is dropped, so a slow frame can't cause an ever-growing backlog.
+	// Params:
+	//   maxTime = The most time simulated per frame, in seconds.
+	void SetMaxFixedUpdateTime(float maxTime);
+
+	// Gets the total game time, in seconds, that was dropped instead of simulated.
+	float GetDroppedFixedUpdateTime() const;
+
+	// Gets how many frames had to drop game time.
+	unsigned GetDroppedFixedUpdateFrames() const;
+
+	// Gets how far the current frame is between the last fixed step and the next one.
+	// Returns:
+	//   A value from 0 to 1, used to blend the previous and current physics state when drawing.
+	float GetInterpolationAlpha() const;
+
+	// Gets how many physics bodies were awake after the last fixed step.
+	unsigned GetAwakeBodyCount() const;
+
+	// Gets how many physics bodies were asleep after the last fixed step.
+	unsigned GetSleepingBodyCount() const;
+
+	// Gets how many collider pairs were skipped in the last fixed step because both bodies were asleep.
+	unsigned GetSleepingPairCount() const;
+
 private:
 	// Disable copy constructor and assignment operator
 	GameObjectManager(const GameObjectManager&) = delete;
@@ -109,6 +164,71 @@ private:
 
 	// Check for collisions between each pair of objects
 	void CheckCollisions();
+
+	// Sends exit events for, and forgets, every contact involving a destroyed object.
+	void RemoveDestroyedContacts();
+
+	// Groups touching physics bodies into islands, then puts islands where every
+	// body is resting to sleep and wakes islands where any body is moving.
+	void UpdateSleeping();
+
+	// Finds the island a body belongs to.
+	// Params:
+	//   body = The index of the body in sleepBodies.
+	// Returns:
+	//   The index of the first body in the island.
+	size_t FindIsland(size_t body);
+
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// Handle indices of the objects in a contact, smallest first, so each pair has one key.
+	// Unlike addresses, these don't depend on the heap, so contacts are always visited
+	// (and their exit events sent) in the same order.
+	typedef std::pair<unsigned, unsigned> ContactKey;
+
+	// State kept for a pair of colliders for as long as they are touching.
+	struct Contact
+	{
+		// The colliders in the contact, in the same order as their objects in the key.
+		const Collider* collider1;
+		const Collider* collider2;
+
+		// The last collision step the pair was found touching.
+		unsigned lastStep;
+
+		// Whether the manifold has been computed since the pair was last tested. Sleeping
+		// pairs aren't tested, so theirs stays current.
+		mutable bool manifoldCurrent;
+
+		// Whether the manifold is valid (both colliders are convex shapes).
+		mutable bool hasManifold;
+
+		// Normal, depth, and points from the first collider toward the second.
+		mutable ContactManifold manifold;
+
+		// Last GJK simplex, so the next manifold for this pair can start from it.
+		mutable GJKCache cache;
+	};
+
+	// Whether a pair of colliders has been tested yet this step, and the result.
+	enum PairState
+	{
+		PairUntested,
+		PairTouching,
+		PairSeparate,
+	};
+
+	// A pair of colliders to check in a collision step.
+	struct CollisionPair
+	{
+		Collider* collider1;
+		Collider* collider2;
+		unsigned version1;	// The first collider's matrix version when the pair was tested.
+		unsigned version2;	// The second collider's matrix version when the pair was tested.
+		PairState state;
+	};
 	
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -120,10 +240,38 @@ private:
 	// Archetypes
 	std::vector<GameObject*> gameObjectArchetypes;
 	
+	// Contacts that persist between fixed steps
+	std::map<ContactKey, Contact> contacts;
+	unsigned collisionStep;
+
+	// Colliders and pairs checked in the current collision step, kept to avoid reallocating
+	std::vector<Collider*> stepColliders;
+	std::vector<unsigned> stepVersions;
+	std::vector<CollisionPair> collisionPairs;
+
+	// Snapshot of every collider, rebuilt when it is asked for after the objects have changed
+	mutable CollisionQueries collisionQueries;
+	mutable bool collisionQueriesDirty;
+	mutable std::mutex collisionQueriesMutex;
+
+	// Sleeping islands, kept between steps to avoid reallocating
+	std::vector<Physics*> sleepBodies;
+	std::vector<size_t> islandParents;
+	std::vector<bool> islandsMoving;
+
+	// Sleeping stats from the last fixed step
+	unsigned awakeBodyCount;
+	unsigned sleepingBodyCount;
+	unsigned sleepingPairCount;
+
 	// Time
-	const float fixedUpdateDt;
-	const float maxFixedUpdateTime;
+	float fixedUpdateDt;
+	float maxFixedUpdateTime;
 	float timeAccumulator;
+
+	// Time that couldn't be simulated
+	float droppedTime;
+	unsigned droppedFrames;
 };
 
 //------------------------------------------------------------------------------
@@ -77,6 +77,10 @@ bool RectangleRectangleIntersection(const BoundingRectangle& rect1, const Boundi
 //   True if intersection, false otherwise.
 bool RectangleCircleIntersection(const BoundingRectangle& rect, const Circle& circle);
 
+// Returns whether separating axis tests are currently being visualized. They are drawn
+// in debug builds whenever DebugDraw is enabled, along with the colliders themselves.
+bool IsCollisionDebugDrawEnabled();
+
 // Checks for an intersection using the separating axis theorem.
 // Params:
 //   axes = The array of axes to check.
@@ -135,6 +139,14 @@ bool OBBCircleIntersection(const ColliderRectangle& rect, const Circle& circle);
 //	max: The maximum value of the polygon as a result of projection it into the normal
 void ProjectPolygon(const Vector2D& normal, const std::vector<Vector2D>& vertices, float& min, float& max);
 
+// Checks whether two axes are parallel (or anti-parallel), in which case testing both is redundant.
+// Params:
+//	axis1: The first axis
+//	axis2: The second axis
+// Returns:
+//	True if the axes are parallel, false otherwise
+bool AreAxesParallel(const Vector2D& axis1, const Vector2D& axis2);
+
 // Check whether two convex polygons interact
 // Params:
 //	lineSegments1: The line segments of the first convex polygon
@@ -143,6 +155,27 @@ void ProjectPolygon(const Vector2D& normal, const std::vector<Vector2D>& vertice
 //	True if intersection, false otherwise
 bool ConvexHullIntersection(const std::vector<LineSegment>& lineSegments1, const std::vector<LineSegment>& lineSegments2);
 
+// Check whether two convex polygons intersect, without allocating.
+// Params:
+//	vertices1: The world space vertices of the first polygon
+//	normals1: The world space edge normals of the first polygon
+//	size1: How many vertices (and normals) the first polygon has
+//	vertices2: The world space vertices of the second polygon
+//	normals2: The world space edge normals of the second polygon
+//	size2: How many vertices (and normals) the second polygon has
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullIntersection(const Vector2D* vertices1, const Vector2D* normals1, size_t size1,
+	const Vector2D* vertices2, const Vector2D* normals2, size_t size2);
+
+// Check whether two convex colliders intersect, using the world space data cached on them.
+// Params:
+//	convex1: The first convex collider
+//	convex2: The second convex collider
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullIntersection(const ColliderConvex& convex1, const ColliderConvex& convex2);
+
 // Check whether a convex polygon interacts with a rectangle collider
 //	Params:
 //	convexSegments: The line segments of the convex polygon
@@ -152,15 +185,51 @@ bool ConvexHullIntersection(const std::vector<LineSegment>& lineSegments1, const
 //	True if interesction, false otherwise
 bool ConvexHullToOBBIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& extents, Transform& rectTransform);
 
+// Check whether a convex polygon intersects a rectangle collider, without allocating.
+// Params:
+//	vertices: The world space vertices of the convex polygon
+//	normals: The world space edge normals of the convex polygon
+//	size: How many vertices (and normals) the polygon has
+//	rect: The rectangle collider
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToOBBIntersection(const Vector2D* vertices, const Vector2D* normals, size_t size, const ColliderRectangle& rect);
+
+// Check whether a convex collider intersects a rectangle collider, using the world space data cached on them.
+// Params:
+//	convex: The convex collider
+//	rect: The rectangle collider
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToOBBIntersection(const ColliderConvex& convex, const ColliderRectangle& rect);
+
 // Check whether a circle is colliding with the convex collider
 //	Params:
 //	convexSegments: The line segments of the convex polygon
-//	convexTransform: The transforma of the convex figure
+//	convexTransform: The transform of the convex figure (unused, the axes come from the segments)
 //	circle: The circle we are testing against
 // Returns:
 //	True if intersection, false otherwise
 bool ConvexHullToCircleInteresction(const std::vector<LineSegment>& convexSegments, const Transform& convexTransform, const Circle& circle);
 
+// Check whether a convex polygon intersects a circle, without allocating.
+// Params:
+//	vertices: The world space vertices of the convex polygon
+//	normals: The world space edge normals of the convex polygon
+//	size: How many vertices (and normals) the polygon has
+//	circle: The circle we are testing against
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToCircleIntersection(const Vector2D* vertices, const Vector2D* normals, size_t size, const Circle& circle);
+
+// Check whether a convex collider intersects a circle, using the world space data cached on the collider.
+// Params:
+//	convex: The convex collider
+//	circle: The circle we are testing against
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToCircleIntersection(const ColliderConvex& convex, const Circle& circle);
+
 // Checks whether a point is inside a convex shape
 // Params:
 //	point: The point we are testing
@@ -169,6 +238,24 @@ bool ConvexHullToCircleInteresction(const std::vector<LineSegment>& convexSegmen
 //	True if intersection, false otherwise
 bool ConvexHullToPointIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& point);
 
+// Checks whether a point is inside a convex polygon, without allocating.
+// Params:
+//	vertices: The world space vertices of the convex polygon
+//	normals: The world space edge normals of the convex polygon
+//	size: How many vertices (and normals) the polygon has
+//	point: The point we are testing
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToPointIntersection(const Vector2D* vertices, const Vector2D* normals, size_t size, const Vector2D& point);
+
+// Checks whether a point is inside a convex collider, using the world space data cached on the collider.
+// Params:
+//	convex: The convex collider
+//	point: The point we are testing
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToPointIntersection(const ColliderConvex& convex, const Vector2D& point);
+
 // Check whether a moving point and line intersect.
 // Params:
 //  staticLine   = Start and end of first line segment.
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	IntersectionSIMD.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Instruction sets the projection kernels can use.
+enum class SIMDLevel
+{
+	Scalar,
+	SSE2,
+	AVX
+};
+
+// A read-only view of points stored as separate x and y arrays (structure of arrays),
+// so several points can be loaded into one register at a time.
+struct SoAPoints
+{
+	// Constructor
+	// Params:
+	//   x = The x coordinates of the points.
+	//   y = The y coordinates of the points.
+	//   size = How many points there are.
+	SoAPoints(const float* x = nullptr, const float* y = nullptr, size_t size = 0);
+
+	const float* x; // X coordinates.
+	const float* y; // Y coordinates.
+	size_t size;    // How many points there are.
+};
+
+//------------------------------------------------------------------------------
+// Public Function Declarations:
+//------------------------------------------------------------------------------
+
+// Returns the best instruction set supported by this CPU and operating system.
+SIMDLevel GetSupportedSIMDLevel();
+
+// Checks for an intersection using the separating axis theorem, with the axes and points
+// in structure of arrays form. Stops at the first separating axis.
+// Params:
+//   axes1 = The first set of axes to check (usually the first hull's edge normals).
+//   axes2 = The second set of axes to check.
+//   points1 = The points in the first convex hull.
+//   points2 = The points in the second convex hull.
+//   radius = A value to add to/subtract from the second convex hull's projected points, essentially a radius for each point.
+// Returns:
+//   True if intersection, false otherwise.
+bool SATIntersection(const SoAPoints& axes1, const SoAPoints& axes2, const SoAPoints& points1, const SoAPoints& points2, float radius = 0.0f);
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	JobSystem.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <BetaObject.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// A function run by a job.
+// Params:
+//   data = The data the job was started with.
+//   begin = The first index the job covers.
+//   end = One past the last index the job covers.
+typedef void (*JobFunction)(const void* data, size_t begin, size_t end);
+
+// Counts how many jobs in a group haven't finished, so the group can be waited on.
+// Groups are waited on in order to run the phases of a frame one after another.
+struct JobCounter
+{
+	// Constructor
+	JobCounter();
+
+	// Returns whether every job in the group has finished.
+	bool IsDone() const;
+
+	std::atomic<unsigned> remaining;
+};
+
+// Runs jobs on a pool of worker threads. Every worker has its own queue of jobs,
+// and workers that run out of jobs steal from the other queues. Threads that wait
+// on a group of jobs help run jobs until the group is done, rather than blocking.
+class JobSystem : public BetaObject
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   workerCount = How many worker threads to start. If 0, one per core, leaving a core for the main thread.
+	JobSystem(unsigned workerCount = 0);
+
+	// Destructor - finishes the queued jobs, then stops the workers.
+	~JobSystem();
+
+	// Queues a job to be run on a worker thread.
+	// Params:
+	//   function = The function to run.
+	//   data = Passed to the function. Must stay valid until the job finishes.
+	//   counter = Counts the job until it finishes.
+	//   begin = Passed to the function.
+	//   end = Passed to the function.
+	void Run(JobFunction function, const void* data, JobCounter& counter, size_t begin = 0, size_t end = 0);
+
+	// Runs jobs until every job in a group has finished.
+	// Params:
+	//   counter = The counter the jobs were started with.
+	void Wait(JobCounter& counter);
+
+	// Calls a function for every index in a range, split into batches run in parallel.
+	// Returns once every index has been handled.
+	// Template parameters:
+	//   Function = A function or lambda taking a size_t index.
+	// Params:
+	//   count = How many indices there are.
+	//   batchSize = How many indices each job handles. Should be big enough that
+	//     a batch takes much longer than queueing it.
+	//   function = The function to call for each index.
+	template<typename Function>
+	void ParallelFor(size_t count, size_t batchSize, const Function& function)
+	{
+		// Not worth queueing anything if there's only one batch.
+		if (workers.empty() || count <= batchSize)
+		{
+			for (size_t i = 0; i < count; i++)
+				function(i);
+			return;
+		}
+
+		JobCounter counter;
+		Push(&RunRange<Function>, &function, counter, 0, count, batchSize);
+		Wait(counter);
+	}
+
+	// Gets how many worker threads there are, not counting threads that help while waiting.
+	unsigned GetWorkerCount() const;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A single job waiting to run.
+	struct Job
+	{
+		JobFunction function;
+		const void* data;
+		size_t begin;
+		size_t end;
+		JobCounter* counter;
+	};
+
+	// The jobs queued by one thread. The owner takes the newest job, and other threads steal the oldest.
+	struct JobQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Disable copy constructor and assignment operator
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Calls a function for every index in a job's range.
+	template<typename Function>
+	static void RunRange(const void* data, size_t begin, size_t end)
+	{
+		const Function& function = *static_cast<const Function*>(data);
+		for (size_t i = begin; i < end; i++)
+			function(i);
+	}
+
+	// Adds jobs covering a range to the calling thread's queue and wakes the workers.
+	// Params:
+	//   function = The function each job runs.
+	//   data = Passed to the function.
+	//   counter = Counts the jobs until they finish.
+	//   begin = The first index in the range.
+	//   end = One past the last index in the range.
+	//   batchSize = How many indices each job covers, or 0 for a single job covering the whole range.
+	void Push(JobFunction function, const void* data, JobCounter& counter, size_t begin, size_t end, size_t batchSize);
+
+	// Runs a job from the calling thread's queue, or steals one from another queue.
+	// Returns:
+	//   True if a job was run, false if every queue was empty.
+	bool RunNextJob();
+
+	// The main function of a worker thread.
+	// Params:
+	//   index = The worker's queue.
+	void WorkerMain(unsigned index);
+
+	// Gets the queue the calling thread should add jobs to.
+	unsigned GetQueueIndex() const;
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// One queue per worker, plus queue 0 for every thread that isn't a worker.
+	std::vector<JobQueue*> queues;
+	std::vector<std::thread> workers;
+
+	// Lets idle workers sleep until jobs are added.
+	std::mutex sleepMutex;
+	std::condition_variable jobAdded;
+	std::atomic<int> queuedCount;
+	bool stopping;
+};
+
+//------------------------------------------------------------------------------
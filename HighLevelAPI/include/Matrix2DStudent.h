@@ -19,6 +19,14 @@
 
 //------------------------------------------------------------------------------
 
+//------------------------------------------------------------------------------
+// Forward Declarations:
+//------------------------------------------------------------------------------
+
+struct LineSegment;
+
+//------------------------------------------------------------------------------
+
 namespace CS230
 {
 	//------------------------------------------------------------------------------
@@ -77,6 +85,27 @@ namespace CS230
 		// Result = Mtx * Vec.
 		Vector2D operator*(const Vector2D& vec) const;
 
+		// Returns whether the bottom row is (0, 0, 1), meaning the matrix is only a
+		// combination of translation, rotation, scale, and shear.
+		bool IsAffine() const;
+
+		// Multiplies many points by this matrix at once, two at a time using SSE.
+		// The bottom row is ignored, so the matrix must be affine.
+		// Params:
+		//   points = The points to transform.
+		//   result = Where to store the transformed points. Can be the same array as points.
+		//   count = How many points there are.
+		void TransformPoints(const Vector2D* points, Vector2D* result, size_t count) const;
+
+		// Multiplies the ends of many line segments by this matrix at once, and
+		// recalculates their directions and normals. Both ends of a segment are transformed
+		// together using SSE. The bottom row is ignored, so the matrix must be affine.
+		// Params:
+		//   segments = The line segments to transform.
+		//   result = Where to store the transformed segments. Can be the same array as segments.
+		//   count = How many segments there are.
+		void TransformSegments(const LineSegment* segments, LineSegment* result, size_t count) const;
+
 		//------------------------------------------------------------------------------
 		// Public Data
 		//------------------------------------------------------------------------------
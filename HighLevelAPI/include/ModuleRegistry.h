@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ModuleRegistry.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class BetaObject;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Keeps track of the modules added to the engine by type, and the order they should be updated in.
+// Looking up a module is a single read of a static pointer for that type, instead of searching
+// every module like Engine::GetModule does. Every module the game adds to the engine is added
+// through here, so game code should look modules up here rather than through the engine.
+class ModuleRegistry
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Registers a module so it can be looked up by type. The module is added to the
+	// engine by AddModulesToEngine, after every module it depends on.
+	// Template parameters:
+	//   ModuleType = The type the module will be looked up by.
+	//   Dependencies = The types of the modules that must be updated before this one.
+	// Params:
+	//   module = The module. It should be dynamically allocated, since the engine will own it.
+	template<typename ModuleType, typename... Dependencies>
+	void RegisterModule(ModuleType* module)
+	{
+		// Remember to empty the slot once the engine releases the module.
+		if (ModuleSlot<ModuleType>::module == nullptr)
+			slotClearers.push_back(&ClearSlot<ModuleType>);
+
+		ModuleSlot<ModuleType>::module = module;
+
+		ModuleEntry entry;
+		entry.module = module;
+		entry.key = GetKey<ModuleType>();
+		entry.dependencies = { GetKey<Dependencies>()... };
+		entries.push_back(entry);
+	}
+
+	// Retrieves the registered module with the given type. Asserts in debug builds
+	// if no module of that type was registered, or if it has been released.
+	// Template parameters:
+	//   ModuleType = The type the module was registered with.
+	// Returns:
+	//   A pointer to the module, or nullptr if it was never registered or has been released.
+	template<typename ModuleType>
+	static ModuleType* GetModule()
+	{
+		ModuleType* module = ModuleSlot<ModuleType>::module;
+		_ASSERTE(module != nullptr && "Module was not registered, or has been released");
+		return module;
+	}
+
+	// Retrieves the registered module with the given type, for modules that are optional.
+	// Template parameters:
+	//   ModuleType = The type the module was registered with.
+	// Returns:
+	//   A pointer to the module, or nullptr if it was never registered or has been released.
+	template<typename ModuleType>
+	static ModuleType* FindModule()
+	{
+		return ModuleSlot<ModuleType>::module;
+	}
+
+	// Adds every registered module to the engine, ordered so each module is
+	// updated after the modules it depends on.
+	void AddModulesToEngine();
+
+	// Forgets every registered module. Must be called once the engine has deleted
+	// its modules, so lookups return nullptr instead of freed pointers.
+	void ReleaseModules();
+
+	// Gets the order the registered modules will be (or were) added to the engine in.
+	// Modules with no path of dependencies between them could be updated in parallel.
+	const std::vector<BetaObject*>& GetUpdateOrder() const;
+
+	// Returns an instance of the registry.
+	static ModuleRegistry& GetInstance();
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The registered module of a single type.
+	template<typename ModuleType>
+	struct ModuleSlot
+	{
+		static ModuleType* module;
+	};
+
+	// A registered module and the types it depends on.
+	struct ModuleEntry
+	{
+		BetaObject* module;
+		const void* key;						// Identifies the module's type.
+		std::vector<const void*> dependencies;	// The keys of the types this module depends on.
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor is private to prevent accidental instantiation
+	ModuleRegistry();
+
+	// Disable copy constructor and assignment operator
+	ModuleRegistry(const ModuleRegistry&) = delete;
+	ModuleRegistry& operator=(const ModuleRegistry&) = delete;
+
+	// Gets a value that is different for every module type.
+	// Template parameters:
+	//   ModuleType = The type of the module.
+	// Returns:
+	//   The address of the type's slot.
+	template<typename ModuleType>
+	static const void* GetKey()
+	{
+		return &ModuleSlot<ModuleType>::module;
+	}
+
+	// Empties the slot for a module type.
+	// Template parameters:
+	//   ModuleType = The type of the module.
+	template<typename ModuleType>
+	static void ClearSlot()
+	{
+		ModuleSlot<ModuleType>::module = nullptr;
+	}
+
+	// Sorts the registered modules so every module comes after its dependencies.
+	void SortModules();
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Modules in the order they were registered.
+	std::vector<ModuleEntry> entries;
+
+	// Modules in the order they are updated.
+	std::vector<BetaObject*> updateOrder;
+
+	// Empties each slot that has been filled, for ReleaseModules.
+	std::vector<void (*)()> slotClearers;
+};
+
+template<typename ModuleType>
+ModuleType* ModuleRegistry::ModuleSlot<ModuleType>::module = nullptr;
+
+//------------------------------------------------------------------------------
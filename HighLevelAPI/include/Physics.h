@@ -67,6 +67,9 @@ public:
 	//	 dt = Change in time (in seconds) since the last fixed update.
 	void FixedUpdate(float dt) override;
 
+	// Physics only moves its own transform, so bodies are stepped in parallel.
+	bool IsFixedUpdateThreadSafe() const override;
+
 	// Set the velocity of a physics component.
 	// Params:
 	//	 velocity = Pointer to a velocity vector.
@@ -112,6 +115,39 @@ public:
 	//   A reference to the component's oldTranslation structure.
 	const Vector2D& GetOldTranslation() const;
 
+	// Enables or disables continuous collision detection. Fast, small objects like bullets
+	// should enable this so they can't pass through thin colliders in a single step.
+	// Params:
+	//   enabled = Whether collisions should be swept from the old to the new translation.
+	void SetContinuousCollision(bool enabled);
+
+	// Returns whether continuous collision detection is enabled.
+	bool IsContinuousCollision() const;
+
+	// Allows or prevents this body from falling asleep. Bodies that are moved by
+	// something other than forces and velocity every step may want to disable this.
+	// Params:
+	//   allowed = Whether the body can sleep.
+	void SetSleepingAllowed(bool allowed);
+
+	// Returns whether this body can fall asleep.
+	bool IsSleepingAllowed() const;
+
+	// Returns whether this body has rested long enough that it can fall asleep.
+	// Bodies only actually sleep when everything they are touching can sleep too.
+	bool IsResting() const;
+
+	// Returns whether this body is asleep, meaning it doesn't move and doesn't
+	// need to be checked against other sleeping bodies.
+	bool IsAsleep() const;
+
+	// Puts this body to sleep, stopping it.
+	void Sleep();
+
+	// Wakes this body up, so it moves and collides normally again. Adding a force,
+	// changing the velocity, or moving the transform wakes a body automatically.
+	void Wake();
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -135,6 +171,15 @@ private:
 	// Previous position.  May be used for resolving collisions.
 	Vector2D	oldTranslation;
 
+	// Whether collisions are swept along the movement from oldTranslation.
+	bool		continuousCollision;
+
+	// Sleeping state
+	bool		sleepingAllowed;
+	bool		asleep;
+	float		restingTime;         // How long the body has been moving slowly enough to sleep.
+	unsigned	sleepMatrixVersion;  // The transform's matrix version when the body fell asleep.
+
 	// Transform component
 	Transform*	transform;
 };
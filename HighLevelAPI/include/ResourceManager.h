@@ -15,9 +15,12 @@
 // Include Files:
 //------------------------------------------------------------------------------
 
-#include <map>
 #include <Vector2D.h>
 #include <Color.h>
+#include "ResourceTable.h"
+#include "AssetLoader.h"
+#include "TextureCache.h"
+#include "TextureAtlas.h"
 
 //------------------------------------------------------------------------------
 
@@ -33,6 +36,12 @@ class Texture;
 // Public Structures:
 //------------------------------------------------------------------------------
 
+// The resources a level uses, so they can be loaded before the level is.
+struct ResourceManifest
+{
+	std::vector<std::string> textures;
+};
+
 class ResourceManager
 {
 public:
@@ -46,6 +55,10 @@ public:
 	// Destructor
 	~ResourceManager();
 
+	// Finishes loading textures that have been decoded in the background, until the upload budget is spent.
+	// At least one texture is finished per call, so loading always makes progress.
+	void Update();
+
 	// Retrieve an existing mesh required by a game object.
 	// Params:
 	//   objectName = The name of the mesh.
@@ -92,7 +105,20 @@ public:
 	//   The mesh with the specified name.
 	Mesh* GetMesh(const std::string& objectName, const Color& color0, const Color& color1, const Color& color2);
 
+	// Retrieves a quad mesh with UVs the size of one frame of a sprite source. A sprite source in an atlas only
+	// covers a region of its page, so a quad made without it, such as "Quad", would show the whole page.
+	// Params:
+	//   mesh = The mesh the sprite source is drawn with.
+	//   spriteSource = The sprite source.
+	// Returns:
+	//   A copy of the quad with the same extents but UVs sized to the frame, or the mesh itself if the sprite
+	//   source has no region, the UVs already fit, or the mesh isn't a quad made by this resource manager.
+	Mesh* FitMesh(Mesh* mesh, const SpriteSource* spriteSource);
+
 	// Retrieve a sprite source that uses a given texture, create it if not found.
+	// If the texture is in a loaded atlas, the sprite source uses its region of the atlas page. Meshes for
+	// such sprite sources should be made with the GetMesh overload that takes a sprite source, or fitted with FitMesh.
+	// If asynchronous loading is enabled, a new sprite source uses a placeholder texture until its texture is loaded.
 	// Params:
 	//	 textureName = Filename of the texture used by the sprite source.
 	//	 numCols = The number of columns in the sprite sheet.
@@ -134,6 +160,48 @@ public:
 	//   The texture that was added.
 	Texture* AddTexture(const std::string& objectName, Texture* texture);
 
+	// Finds an existing mesh without creating or referencing it.
+	// Params:
+	//   objectName = The name of the mesh.
+	// Returns:
+	//   A handle to the mesh, or an invalid handle if no mesh has that name.
+	Handle<Mesh> FindMesh(const std::string& objectName) const;
+
+	// Finds an existing sprite source without creating or referencing it.
+	// Params:
+	//   textureName = Filename of the texture used by the sprite source.
+	// Returns:
+	//   A handle to the sprite source, or an invalid handle if there is none for that texture.
+	Handle<SpriteSource> FindSpriteSource(const std::string& textureName) const;
+
+	// Finds an existing texture without creating or referencing it.
+	// Params:
+	//   textureName = Filename of the texture.
+	// Returns:
+	//   A handle to the texture, or an invalid handle if no texture has that name.
+	Handle<Texture> FindTexture(const std::string& textureName) const;
+
+	// Retrieves the mesh a handle refers to, without looking up its name.
+	// Params:
+	//   handle = A handle from FindMesh.
+	// Returns:
+	//   The mesh, or nullptr if it has been unloaded.
+	Mesh* GetMesh(Handle<Mesh> handle) const;
+
+	// Retrieves the sprite source a handle refers to, without looking up its name.
+	// Params:
+	//   handle = A handle from FindSpriteSource.
+	// Returns:
+	//   The sprite source, or nullptr if it has been unloaded.
+	SpriteSource* GetSpriteSource(Handle<SpriteSource> handle) const;
+
+	// Retrieves the texture a handle refers to, without looking up its name.
+	// Params:
+	//   handle = A handle from FindTexture.
+	// Returns:
+	//   The texture, or nullptr if it has been unloaded.
+	Texture* GetTexture(Handle<Texture> handle) const;
+
 	// To be called when a level has finished loading its resources.
 	void OnLevelLoad();
 
@@ -143,81 +211,95 @@ public:
 	// Unloads all resources used by the resource manager.
 	void Unload();
 
-private:
-	//------------------------------------------------------------------------------
-	// Private Structures:
-	//------------------------------------------------------------------------------
+	// Sets whether sprite sources load their textures in the background.
+	// Params:
+	//   enabled = Whether to load asynchronously. Textures requested directly are always loaded immediately.
+	void SetAsyncLoading(bool enabled);
+
+	// Sets how long Update may spend uploading textures each frame.
+	// Params:
+	//   seconds = The upload time budget.
+	void SetUploadBudget(float seconds);
+
+	// Returns whether any textures are still loading in the background.
+	bool IsLoading() const;
 
-	enum class ResourceType
-	{
-		MESH = 0,
-		SPRITESOURCE,
-		TEXTURE,
-		RESOURCETYPE_MAX
-	};
-
-	struct Resource
-	{
-	public:
-		//------------------------------------------------------------------------------
-		// Public Functions:
-		//------------------------------------------------------------------------------
-
-		// Conversion constructor
-		// Params:
-		//   mesh = The mesh resource.
-		Resource(Mesh* mesh);
-
-		// Conversion constructor
-		// Params:
-		//   spriteSource = The sprite source resource.
-		Resource(SpriteSource* spriteSource);
-
-		// Conversion constructor
-		// Params:
-		//   texture = The texture resource.
-		Resource(Texture* texture);
-
-		// Destructor
-		~Resource();
-
-		//------------------------------------------------------------------------------
-		// Public Variables:
-		//------------------------------------------------------------------------------
-
-		ResourceType type;
-		unsigned references;
-		union
-		{
-			void* genericPointer;
-			Mesh* mesh;
-			SpriteSource* spriteSource;
-			Texture* texture;
-		};
-	};
+	// Returns the resources in use since the last level was unloaded, including textures that are still loading.
+	ResourceManifest GetManifest() const;
 
+	// Starts loading the textures in a manifest in the background, without referencing them.
+	// Preloaded textures that the next level doesn't use are removed once it has loaded.
+	// Params:
+	//   manifest = The resources to load.
+	void Preload(const ResourceManifest& manifest);
+
+	// Reads an atlas manifest saved with TextureAtlas::Save. Sprite sources created afterward for
+	// textures in the atlas use the atlas pages instead of their own textures.
+	// Params:
+	//   atlasName = The name of the atlas.
+	// Returns:
+	//   True if the manifest was read, false otherwise.
+	bool LoadAtlas(const std::string& atlasName);
+
+	// Packs textures into atlas pages now, for textures that weren't packed ahead of time.
+	// Call this before creating the sprite sources. If the pages are still loaded from an earlier level, they are reused.
+	// Params:
+	//   atlasName = The name of the atlas, used to name its pages.
+	//   textureNames = The filenames of the textures to pack. Textures that don't fit are loaded on their own.
+	//   pageSize = The width and height of each page, in pixels.
+	void BuildAtlas(const std::string& atlasName, const std::vector<std::string>& textureNames, unsigned pageSize = 1024);
+
+private:
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
 
+	// Creates a quad mesh, remembering its shape so that FitMesh can make copies of it.
+	// Params:
+	//   objectName = The name of the mesh.
+	//   textureSize = The UV size of the mesh.
+	//   extents = The extents of the mesh.
+	Mesh* AddQuadMesh(const std::string& objectName, Vector2D textureSize, Vector2D extents);
+
 	// Creates a texture if the given texture name is not "none"
 	// Params:
 	//   textureName = The file to load the texture from.
 	Texture* CreateTextureFromFile(const std::string& textureName);
 
-	// Gets the number of references to the specified resource.
+	// Creates the texture for a decoded image and gives it to the sprite source waiting on it.
 	// Params:
-	//   objectName = The name of the object.
-	// Returns:
-	//   How many times the resource has been referenced.
-	unsigned GetResourceReferenceCount(const std::string& objectName);
-	
+	//   image = The decoded image.
+	void FinishTextureLoad(DecodedImage& image);
+
+	// Returns the texture used by sprite sources whose textures are still loading.
+	Texture* GetPlaceholderTexture();
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
 
-	// Container for all resources
-	std::map<std::string, Resource*> resources;
+	// Containers for each type of resource, keyed by name
+	ResourceTable<Mesh> meshes;
+	ResourceTable<SpriteSource> spriteSources;
+	ResourceTable<Texture> textures;
+
+	// Decoded copies of image files, used by both direct and background loading. Declared before
+	// the loader so that it outlives the loader's threads.
+	TextureCache textureCache;
+
+	// Background loading
+	AssetLoader loader;
+	std::vector<std::string> pendingTextures;
+	Texture* placeholderTexture;
+	bool asyncLoading;
+	float uploadBudget;
+
+	// Atlas regions by texture name, and the pages that were built at runtime rather than loaded from files
+	std::map<std::string, AtlasRegion> atlasRegions;
+	std::vector<std::string> builtAtlasPages;
+
+	// The UV size and extents of each quad mesh that has been created, by name
+	std::map<std::string, std::pair<Vector2D, Vector2D>> quadShapes;
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,362 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ResourceTable.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Hashes a resource name using 32-bit FNV-1a.
+// Params:
+//   name = The name to hash.
+// Returns:
+//   The hash of the name.
+unsigned HashResourceName(const std::string& name);
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// A reference to a resource in a ResourceTable. Unlike a pointer, a handle to a
+// resource that has been unloaded is detected, since the slot's generation changes.
+template<typename ResourceType>
+struct Handle
+{
+	// Creates an invalid handle.
+	Handle() : index(0), generation(0)
+	{
+	}
+
+	// Creates a handle to a slot.
+	// Params:
+	//   index = The index of the slot.
+	//   generation = The generation of the slot when the handle was made.
+	Handle(unsigned index, unsigned generation) : index(index), generation(generation)
+	{
+	}
+
+	// Returns whether the handle was ever given a resource. It may still be stale.
+	bool IsValid() const
+	{
+		return generation != 0;
+	}
+
+	bool operator==(const Handle& other) const
+	{
+		return index == other.index && generation == other.generation;
+	}
+
+	bool operator!=(const Handle& other) const
+	{
+		return !(*this == other);
+	}
+
+	unsigned index;      // The slot the resource is in.
+	unsigned generation; // The slot's generation, 0 for invalid handles.
+};
+
+// Stores resources of a single type by name, using open addressing on the name's hash.
+// Resources are owned by the table, but are only deleted by RemoveUnreferenced and Clear.
+template<typename ResourceType>
+class ResourceTable
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	ResourceTable() : count(0)
+	{
+	}
+
+	// Finds a resource by name.
+	// Params:
+	//   name = The name of the resource.
+	// Returns:
+	//   A handle to the resource, or an invalid handle if there is none with that name.
+	Handle<ResourceType> Find(const std::string& name) const
+	{
+		return Find(name, HashResourceName(name));
+	}
+
+	// Finds a resource by name, with the name's hash already calculated.
+	// Params:
+	//   name = The name of the resource.
+	//   hash = The result of HashResourceName(name).
+	// Returns:
+	//   A handle to the resource, or an invalid handle if there is none with that name.
+	Handle<ResourceType> Find(const std::string& name, unsigned hash) const
+	{
+		if (buckets.empty())
+			return Handle<ResourceType>();
+
+		// Walk the buckets from the hash's position until an empty one is found.
+		size_t mask = buckets.size() - 1;
+		for (size_t bucket = hash & mask; buckets[bucket] != emptyBucket; bucket = (bucket + 1) & mask)
+		{
+			const Slot& slot = slots[buckets[bucket]];
+			if (slot.hash == hash && slot.name == name)
+				return Handle<ResourceType>(buckets[bucket], slot.generation);
+		}
+
+		return Handle<ResourceType>();
+	}
+
+	// Adds a resource. If one with the same name already exists, the new one is deleted.
+	// Params:
+	//   name = The name of the resource.
+	//   resource = The resource to add. The table takes ownership of it.
+	//   reference = Whether to reference the resource. Unreferenced resources are removed by the next RemoveUnreferenced.
+	// Returns:
+	//   A handle to the resource with that name.
+	Handle<ResourceType> Add(const std::string& name, ResourceType* resource, bool reference = true)
+	{
+		unsigned hash = HashResourceName(name);
+
+		Handle<ResourceType> existing = Find(name, hash);
+		if (existing.IsValid())
+		{
+			delete resource;
+			if (reference)
+				slots[existing.index].referenced = true;
+			return existing;
+		}
+
+		// Reuse a slot left by a removed resource if there is one.
+		unsigned index;
+		if (!freeSlots.empty())
+		{
+			index = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		{
+			index = static_cast<unsigned>(slots.size());
+			slots.push_back(Slot());
+		}
+
+		Slot& slot = slots[index];
+		slot.name = name;
+		slot.hash = hash;
+		slot.resource = resource;
+		slot.referenced = reference;
+		slot.occupied = true;
+
+		// Keep the buckets at most half full so probes stay short.
+		++count;
+		if (count * 2 > buckets.size())
+		{
+			size_t bucketCount = buckets.size() * 2;
+			if (bucketCount < minimumBuckets)
+				bucketCount = minimumBuckets;
+			RebuildIndex(bucketCount);
+		}
+		else
+			InsertIntoIndex(index);
+
+		return Handle<ResourceType>(index, slot.generation);
+	}
+
+	// Gets the resource a handle refers to.
+	// Params:
+	//   handle = The handle to the resource.
+	// Returns:
+	//   The resource, or nullptr if the handle is invalid or the resource was removed.
+	ResourceType* Get(Handle<ResourceType> handle) const
+	{
+		if (!IsCurrent(handle))
+			return nullptr;
+
+		return slots[handle.index].resource;
+	}
+
+	// Marks a resource as used by the current level, so RemoveUnreferenced keeps it.
+	// Params:
+	//   handle = The handle to the resource.
+	// Returns:
+	//   The resource, or nullptr if the handle is invalid or the resource was removed.
+	ResourceType* Reference(Handle<ResourceType> handle)
+	{
+		if (!IsCurrent(handle))
+			return nullptr;
+
+		// Resources may be null (such as the "none" texture), so the slot is checked instead of the resource.
+		Slot& slot = slots[handle.index];
+		slot.referenced = true;
+		return slot.resource;
+	}
+
+	// Forgets every reference, e.g. when the level using the resources is unloaded.
+	void ClearReferences()
+	{
+		for (auto it = slots.begin(); it != slots.end(); ++it)
+			it->referenced = false;
+	}
+
+	// Deletes every resource that isn't referenced.
+	void RemoveUnreferenced()
+	{
+		bool removed = false;
+		for (unsigned i = 0; i < slots.size(); ++i)
+		{
+			if (!slots[i].occupied || slots[i].referenced)
+				continue;
+
+			Remove(i);
+			removed = true;
+		}
+
+		// Open addressing can't simply empty a bucket, so the index is rebuilt once for everything removed.
+		if (removed)
+			RebuildIndex(buckets.size());
+	}
+
+	// Deletes every resource.
+	void Clear()
+	{
+		for (unsigned i = 0; i < slots.size(); ++i)
+		{
+			if (slots[i].occupied)
+				Remove(i);
+		}
+
+		RebuildIndex(buckets.size());
+	}
+
+	// Adds the name of every referenced resource to an array.
+	// Params:
+	//   names = The array to add the names to.
+	void GetReferencedNames(std::vector<std::string>& names) const
+	{
+		for (auto it = slots.begin(); it != slots.end(); ++it)
+		{
+			if (it->occupied && it->referenced)
+				names.push_back(it->name);
+		}
+	}
+
+	// Gets how many resources are in the table.
+	size_t GetCount() const
+	{
+		return count;
+	}
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	struct Slot
+	{
+		Slot() : hash(0), resource(nullptr), generation(1), referenced(false), occupied(false)
+		{
+		}
+
+		std::string name;
+		unsigned hash;
+		ResourceType* resource;
+		unsigned generation;
+		bool referenced;	// Whether the current level uses the resource. Not a count; one use is enough to keep it.
+		bool occupied;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Returns whether a handle refers to a resource that is still in the table.
+	// Params:
+	//   handle = The handle to check.
+	bool IsCurrent(Handle<ResourceType> handle) const
+	{
+		return handle.index < slots.size() && slots[handle.index].occupied && slots[handle.index].generation == handle.generation;
+	}
+
+	// Deletes the resource in a slot and frees the slot, without updating the index.
+	// Params:
+	//   index = The index of the slot.
+	void Remove(unsigned index)
+	{
+		Slot& slot = slots[index];
+		delete slot.resource;
+		slot.resource = nullptr;
+		slot.name.clear();
+		slot.occupied = false;
+
+		// Any handles to the old resource are now stale. Generation 0 is never used, since it marks invalid handles.
+		if (++slot.generation == 0)
+			slot.generation = 1;
+
+		freeSlots.push_back(index);
+		--count;
+	}
+
+	// Puts a slot in the first empty bucket at or after its hash's position.
+	// Params:
+	//   index = The index of the slot.
+	void InsertIntoIndex(unsigned index)
+	{
+		size_t mask = buckets.size() - 1;
+		size_t bucket = slots[index].hash & mask;
+		while (buckets[bucket] != emptyBucket)
+			bucket = (bucket + 1) & mask;
+
+		buckets[bucket] = index;
+	}
+
+	// Rebuilds the buckets from the occupied slots.
+	// Params:
+	//   bucketCount = How many buckets to use. Must be a power of two.
+	void RebuildIndex(size_t bucketCount)
+	{
+		buckets.assign(bucketCount, static_cast<unsigned>(emptyBucket));
+		for (unsigned i = 0; i < slots.size(); ++i)
+		{
+			if (slots[i].occupied)
+				InsertIntoIndex(i);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Marks a bucket that doesn't refer to a slot.
+	static const unsigned emptyBucket = 0xFFFFFFFF;
+
+	// The smallest number of buckets used once anything is added.
+	static const size_t minimumBuckets = 16;
+
+	// Resources, in the order they were added. Handles index into this.
+	std::vector<Slot> slots;
+
+	// Slots whose resources were removed, to be reused.
+	std::vector<unsigned> freeSlots;
+
+	// Indices of slots, placed by the hashes of their names.
+	std::vector<unsigned> buckets;
+
+	// How many slots are occupied.
+	size_t count;
+};
+
+//------------------------------------------------------------------------------
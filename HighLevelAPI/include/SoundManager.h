@@ -32,6 +32,18 @@
 // Public Structures:
 //------------------------------------------------------------------------------
 
+// Memory and load time statistics for audio.
+struct SoundMetrics
+{
+	int currentMemory;			// Bytes FMOD currently has allocated.
+	int peakMemory;				// The most bytes FMOD has had allocated at once.
+	float soundLoadTime;		// Total seconds spent creating sounds and opening music streams.
+	float bankLoadTime;			// Total seconds banks took to load, from being added until Update saw them finish.
+	size_t soundCount;			// How many sounds are loaded.
+	size_t bankCount;			// How many banks have finished loading.
+	size_t pendingBankCount;	// How many banks are still loading.
+};
+
 // You are free to change the contents of this structure as long as you do not
 //   change the public functions declared in the header.
 class SoundManager : public BetaObject
@@ -65,11 +77,22 @@ public:
 	//	 filename = Name of the music file (MP3).
 	void AddMusic(const std::string& filename);
 
-	// Creates an FMOD sound bank
+	// Starts loading an FMOD sound bank in the background. Its events
+	// can't be played until IsBankLoaded returns true.
 	// Params:
 	//   filename = Name of the FMOD bank file.
 	void AddBank(const std::string& filename);
 
+	// Checks whether a bank has finished loading.
+	// Params:
+	//   filename = Name of the FMOD bank file.
+	// Returns:
+	//   True if the bank is loaded, false if it is still loading, failed, or was never added.
+	bool IsBankLoaded(const std::string& filename) const;
+
+	// Checks whether any banks are still loading.
+	bool IsLoading() const;
+
 	// Plays a sound with the specified name.
 	// Params:
 	//	 name = The name of the sound to be played.
@@ -77,10 +100,22 @@ public:
 	//   The channel that was used to play the given sound.
 	FMOD::Channel* PlaySound(const std::string& name);
 
+	// Plays a sound with the specified name and priority.
+	// Params:
+	//	 name = The name of the sound to be played.
+	//   priority = How important the sound is, from 0 (most) to 256 (least). If every
+	//     effect voice is busy, the least important effect that is not more important
+	//     than this one is stopped to make room.
+	// Return:
+	//   The channel that was used to play the given sound, or nullptr if there was no room.
+	FMOD::Channel* PlaySound(const std::string& name, int priority);
+
 	// Starts an audio event with the given name.
 	// The event must be in one of the loaded banks.
 	// Params:
 	//	 name = The name of the event that will be started.
+	// Returns:
+	//   The new event instance, or nullptr if the event could not be found.
 	FMOD::Studio::EventInstance* PlayEvent(const std::string& name);
 
 	// Set the volume of the music channel.
@@ -103,15 +138,61 @@ public:
 	//	 volume = Current value for the FX volume.
 	float GetEffectsVolume() const;
 
+	// Set how many sound effects can play at once.
+	// Params:
+	//   count = The number of effect voices.
+	void SetMaxEffectVoices(unsigned count);
+
+	// Gets memory and load time statistics for audio.
+	SoundMetrics GetMetrics() const;
+
 private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A slot that a single sound effect can play on.
+	struct Voice
+	{
+		FMOD::Channel* channel; // The channel playing on this voice, or nullptr if the voice is free.
+		int priority;			// The priority of the effect on this voice.
+		unsigned startOrder;	// When the effect started, so older effects are stolen first.
+	};
+
+	// A bank that is loading in the background.
+	struct PendingBank
+	{
+		std::string filename;								// The name the bank was added with.
+		FMOD::Studio::Bank* bank;							// The bank being loaded.
+		std::chrono::steady_clock::time_point startTime;	// When the bank started loading.
+	};
+
+
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
 
 	// Different behaviors for SFX vs BGM
-	FMOD::Channel* PlayEffect(FMOD::Sound* sound) const;
+	FMOD::Channel* PlayEffect(FMOD::Sound* sound, int priority);
 	FMOD::Channel* PlayMusic(FMOD::Sound* sound);
 
+	// Finds a voice for a new effect, stopping a less important one if every voice is busy.
+	Voice* AcquireVoice(int priority);
+
+	// Picks the voice a new effect should use, without touching any channels.
+	// Params:
+	//   voices = The voices to pick from.
+	//   priority = The priority of the new effect.
+	// Returns:
+	//   The index of a free voice, or else of the voice to steal, or voices.size() if there is no room.
+	static size_t FindVoice(const std::vector<Voice>& voices, int priority);
+
+	// Frees the voices whose effects have finished playing.
+	void UpdateVoices();
+
+	// Moves banks that have finished loading into the bank list.
+	void UpdateBanks();
+
 	// Add FX/BGM helper
 	void AddSound(const std::string& filename, FMOD_MODE mode);
 
@@ -120,14 +201,26 @@ private:
 	//------------------------------------------------------------------------------
 
 	// Individual sound files
-	static const unsigned maxNumSounds = 30;
-	size_t numSounds;
-	FMOD::Sound* soundList[maxNumSounds];
+	std::vector<FMOD::Sound*> soundList;
+	std::unordered_map<std::string, FMOD::Sound*> soundsByName; // Loaded sounds, by the name FMOD gives them.
 
 	// Sound banks
-	static const unsigned maxNumBanks = 10;
-	size_t numBanks;
-	FMOD::Studio::Bank* bankList[maxNumBanks];  // List of all loaded sound banks.
+	std::vector<FMOD::Studio::Bank*> bankList;  // List of all loaded sound banks.
+	std::vector<std::string> bankNames;			// The names the loaded banks were added with.
+	std::vector<PendingBank> pendingBanks;		// Banks that are still loading.
+
+	// Events that have been looked up, by their full path.
+	std::unordered_map<std::string, FMOD::Studio::EventDescription*> eventDescriptions;
+
+	// Load times
+	float soundLoadTime;
+	float bankLoadTime;
+
+	// Effect voices
+	static const int defaultPriority = 128;
+	static const unsigned defaultMaxEffectVoices = 32;
+	std::vector<Voice> effectVoices;
+	unsigned effectStartCount; // How many effects have been started, for ordering voices.
 
 	// Channels
 	FMOD::Channel* musicChannel;				// The channel most recently used to play music
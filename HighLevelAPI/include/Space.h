@@ -85,6 +85,9 @@ public:
 
 		// Set the next level's parent to this space (necessary for Level::GetParent to work properly).
 		nextLevel->SetParent(this);
+
+		// Start on the level's textures now, so fewer are left to load when the level changes.
+		PreloadLevel(nextLevel->GetName());
 	}
 
 	// Sets the level that the space is using after unloading the current level.
@@ -95,6 +98,23 @@ public:
 
 	// Restarts the current level (next level = current)
 	void RestartLevel();
+
+	// Starts loading a level's textures in the background while the current level runs.
+	// Only levels that have been loaded before, in this run or an earlier one, have a known manifest; others are ignored.
+	// SetLevel already calls this, so only call it to start even earlier.
+	// Params:
+	//   levelName = The name of the level that will be loaded.
+	void PreloadLevel(const std::string& levelName);
+
+	// Returns how long, in seconds, the most recent change to the current level took to load and initialize.
+	float GetLevelLoadTime() const;
+
+	// Returns how long, in seconds, a level took to load and initialize the last time it was changed to.
+	// Params:
+	//   levelName = The name of the level.
+	// Returns:
+	//   The load time, or 0 if the level hasn't been loaded in this space.
+	float GetLevelLoadTime(const std::string& levelName) const;
 	
 	// Returns the object manager, which you can use to retrieve and add objects.
 	GameObjectManager& GetObjectManager();
@@ -110,6 +130,25 @@ private:
 	// Updates current/next level pointers and calls shutdown/unload/load/init
 	void ChangeLevel();
 
+	// Returns the file a level's manifest is kept in between runs.
+	// Params:
+	//   levelName = The name of the level.
+	static std::string GetManifestPath(const std::string& levelName);
+
+	// Reads a level's manifest from the last run that loaded it.
+	// Params:
+	//   levelName = The name of the level.
+	//   manifest = The manifest to fill in.
+	// Returns:
+	//   True if the manifest was read, false otherwise.
+	static bool LoadManifest(const std::string& levelName, ResourceManifest& manifest);
+
+	// Writes a level's manifest, so later runs can preload the level the first time it is loaded.
+	// Params:
+	//   levelName = The name of the level.
+	//   manifest = The manifest to save.
+	static void SaveManifest(const std::string& levelName, const ResourceManifest& manifest);
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
@@ -119,6 +158,12 @@ private:
 	Level* nextLevel;
 	GameObjectManager objectManager;
 	ResourceManager resourceManager;
+
+	// The resources each level used the last time it was loaded, by level name.
+	std::map<std::string, ResourceManifest> levelManifests;
+
+	// How long each level took to load the last time it was changed to, in seconds, by level name.
+	std::map<std::string, float> levelLoadTimes;
 };
 
 //------------------------------------------------------------------------------
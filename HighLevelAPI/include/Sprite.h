@@ -115,6 +115,13 @@ protected:
 	Transform* transform;
 
 private:
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Picks the mesh to draw with, once the sprite is in a space that can make fitted meshes.
+	void FitMesh();
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
@@ -128,6 +135,9 @@ private:
 	// The mesh used to draw the sprite.
 	Mesh* mesh;
 
+	// The mesh actually drawn, which has UVs fitted to the sprite source if it is in an atlas.
+	Mesh* fittedMesh;
+
 	// Color used for blending/tint
 	Color color;
 };
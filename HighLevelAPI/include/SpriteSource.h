@@ -15,6 +15,8 @@
 // Include Files:
 //------------------------------------------------------------------------------
 
+#include <Vector2D.h>
+
 //------------------------------------------------------------------------------
 
 //------------------------------------------------------------------------------
@@ -22,7 +24,6 @@
 //------------------------------------------------------------------------------
 
 class Texture;
-class Vector2D;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -48,6 +49,19 @@ public:
 	//	 A pointer to the sprite source texture.
 	Texture* GetTexture() const;
 
+	// Sets the texture once it has finished loading, marking the sprite source as ready.
+	// Params:
+	//   texture = The loaded texture.
+	void SetTexture(Texture* texture);
+
+	// Uses a stand-in texture until the real one is given with SetTexture.
+	// Params:
+	//   placeholder = The texture to draw with while loading.
+	void SetPlaceholder(Texture* placeholder);
+
+	// Returns whether the texture has finished loading. If not, GetTexture returns a placeholder.
+	bool IsReady() const;
+
 	// Returns the maximum number of frames possible, given the dimensions of the sprite sheet.
 	// Returns:
 	//	 The calculated frame count.
@@ -65,6 +79,18 @@ public:
 	// Returns the number of columns in the sprite source.
 	unsigned GetNumCols() const;
 
+	// Limits the sprite sheet to a region of the texture, such as when it has been packed into an atlas.
+	// Params:
+	//   offset = The UV coordinates of the top left of the region.
+	//   size = The UV size of the region.
+	void SetRegion(const Vector2D& offset, const Vector2D& size);
+
+	// Returns whether the sprite sheet only covers a region of the texture.
+	bool HasRegion() const;
+
+	// Returns the UV size of a single frame, taking the region into account.
+	Vector2D GetFrameSize() const;
+
 private:
 	// The dimensions of the sprite sheet.
 	unsigned numRows;
@@ -72,6 +98,13 @@ private:
 
 	// Pointer to a texture created using the Alpha Engine.
 	Texture* texture;
+
+	// Whether the texture is the real one rather than a placeholder.
+	bool ready;
+
+	// The part of the texture the sprite sheet covers.
+	Vector2D regionOffset;
+	Vector2D regionSize;
 };
 
 //----------------------------------------------------------------------------
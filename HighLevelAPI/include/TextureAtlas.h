@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TextureAtlas.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <map>
+#include <Vector2D.h>
+#include <Color.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Where a texture ended up in an atlas.
+struct AtlasRegion
+{
+	std::string page;  // The texture name of the page the region is on.
+	Vector2D uvOffset; // The UV coordinates of the top left of the region.
+	Vector2D uvSize;   // The UV size of the region.
+};
+
+// Packs small images into larger pages, so sprites using different images can share a texture.
+// Atlases can be built when a level loads, or saved ahead of time with Save and read with LoadManifest.
+class TextureAtlas
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   pageWidth = The width of each page, in pixels.
+	//   pageHeight = The height of each page, in pixels.
+	//   padding = How many pixels to leave around each image. The padding is filled with
+	//     copies of the image's edges, so filtering near the edge doesn't pick up neighboring images.
+	TextureAtlas(unsigned pageWidth = 1024, unsigned pageHeight = 1024, unsigned padding = 2);
+
+	// Adds an image to be packed.
+	// Params:
+	//   name = The texture name of the image.
+	//   pixels = The image's colors, starting at the top left, one row at a time.
+	//   width = The width of the image.
+	//   height = The height of the image.
+	// Returns:
+	//   True if the image was added, false if it is too large to fit on a page.
+	bool AddImage(const std::string& name, const std::vector<Color>& pixels, unsigned width, unsigned height);
+
+	// Reads, decodes, and adds an image from the texture folder.
+	// Params:
+	//   textureName = The filename of the texture.
+	// Returns:
+	//   True if the image was added, false if it couldn't be read or is too large to fit on a page.
+	bool AddImageFile(const std::string& textureName);
+
+	// Adds every PNG in the texture folder, except the pages of an earlier save of the same atlas.
+	// Images that can't be added are reported and left out, to be loaded on their own.
+	// Params:
+	//   atlasName = The name the atlas will be saved as.
+	// Returns:
+	//   True if any images were added, false otherwise.
+	bool AddAllImageFiles(const std::string& atlasName);
+
+	// Places every image that has been added on a page.
+	void Pack();
+
+	// Returns how many pages the images were packed into.
+	unsigned GetPageCount() const;
+
+	// Creates the colors of a page, including the padding around each image.
+	// Params:
+	//   page = The index of the page.
+	//   pixels = The page's colors, starting at the top left, one row at a time.
+	void GetPagePixels(unsigned page, std::vector<Color>& pixels) const;
+
+	// Returns the width of each page, in pixels.
+	unsigned GetPageWidth() const;
+
+	// Returns the height of each page, in pixels.
+	unsigned GetPageHeight() const;
+
+	// Gets where each image was packed.
+	// Params:
+	//   atlasName = The name of the atlas, used to name the pages.
+	//   regions = The map to add the regions to, by texture name.
+	void GetRegions(const std::string& atlasName, std::map<std::string, AtlasRegion>& regions) const;
+
+	// Saves the pages as PNG files and writes a manifest listing where each image was packed.
+	// Everything is written to the texture folder, so the pages can be loaded like any other texture.
+	// Params:
+	//   atlasName = The name of the atlas. The manifest is saved as atlasName.txt.
+	// Returns:
+	//   True if every file was written, false otherwise.
+	bool Save(const std::string& atlasName) const;
+
+	// Reads a manifest written by Save.
+	// Params:
+	//   atlasName = The name of the atlas.
+	//   regions = The map to add the regions to, by texture name.
+	// Returns:
+	//   True if the manifest was read, false otherwise.
+	static bool LoadManifest(const std::string& atlasName, std::map<std::string, AtlasRegion>& regions);
+
+	// Returns the texture name of a page of an atlas.
+	// Params:
+	//   atlasName = The name of the atlas.
+	//   page = The index of the page.
+	static std::string GetPageName(const std::string& atlasName, unsigned page);
+
+	// Returns the name of the atlas packed ahead of time with the "-atlas" command line option.
+	static const std::string& GetDefaultName();
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	struct Image
+	{
+		std::string name;
+		std::vector<Color> pixels;
+		unsigned width;
+		unsigned height;
+
+		// Where the image and its padding were placed.
+		unsigned page;
+		unsigned x;
+		unsigned y;
+	};
+
+	// A horizontal span of the top edge of everything packed so far on a page.
+	struct SkylineNode
+	{
+		unsigned x;
+		unsigned y;
+		unsigned width;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Finds the lowest spot on a page that a rectangle fits in.
+	// Params:
+	//   skyline = The page's skyline.
+	//   width = The width of the rectangle.
+	//   height = The height of the rectangle.
+	//   x = The left of the spot that was found.
+	//   y = The top of the spot that was found.
+	//   index = The skyline node the spot starts at.
+	// Returns:
+	//   True if the rectangle fits on the page, false otherwise.
+	bool FindPosition(const std::vector<SkylineNode>& skyline, unsigned width, unsigned height,
+		unsigned& x, unsigned& y, size_t& index) const;
+
+	// Raises the skyline over a rectangle that was just placed.
+	// Params:
+	//   skyline = The page's skyline.
+	//   index = The skyline node the rectangle starts at.
+	//   x = The left of the rectangle.
+	//   y = The top of the rectangle.
+	//   width = The width of the rectangle.
+	//   height = The height of the rectangle.
+	static void AddToSkyline(std::vector<SkylineNode>& skyline, size_t index, unsigned x, unsigned y, unsigned width, unsigned height);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	unsigned pageWidth;
+	unsigned pageHeight;
+	unsigned padding;
+	unsigned pageCount;
+
+	std::vector<Image> images;
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TextureCache.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+struct DecodedImage;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Stores decoded images on disk, so image files only have to be decoded once.
+// Each entry is keyed by the source file's size and last write time, so entries for changed files are
+// ignored and replaced. Cooking also checks a hash of the source file's contents.
+// The methods don't change the cache object, so it can be used from several threads at once,
+// as long as they aren't working on the same file.
+class TextureCache
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   directory = The folder to keep cache entries in.
+	TextureCache(const std::string& directory = "Assets/Cache/");
+
+	// Reads the cached image for a source file, if there is one and it is up to date.
+	// Entries are matched on the source file's size and last write time, so the source is never read.
+	// Params:
+	//   filename = The path of the source file.
+	//   image = The image to store the cached size and colors in.
+	// Returns:
+	//   True if a matching entry was found, false otherwise.
+	bool Read(const std::string& filename, DecodedImage& image) const;
+
+	// Writes a decoded image to the cache, replacing any older entry for the same file.
+	// Params:
+	//   filename = The path of the source file.
+	//   sourceData = The contents of the source file.
+	//   image = The decoded image.
+	// Returns:
+	//   True if the entry was written, false otherwise.
+	bool Write(const std::string& filename, const std::vector<char>& sourceData, const DecodedImage& image) const;
+
+	// Decodes an image file and writes it to the cache, unless an up to date entry already exists.
+	// Unlike Read, this hashes the source file, so entries whose source changed without its
+	// size or write time changing (or that were copied from elsewhere) are rebuilt.
+	// Params:
+	//   filename = The path of the source file.
+	// Returns:
+	//   True if the cache has an up to date entry afterward, false otherwise.
+	bool Cook(const std::string& filename) const;
+
+	// Cooks every PNG file in the texture folder. Problems are reported with OutputDebugString,
+	// since this runs before the engine (and its console) starts.
+	// Returns:
+	//   True if at least one file was found and every file was cooked, false otherwise.
+	bool CookAll() const;
+
+	// Returns the path of the cache entry for a source file.
+	// Params:
+	//   filename = The path of the source file.
+	std::string GetEntryPath(const std::string& filename) const;
+
+	// Returns the format version written to new entries. Entries with other versions are ignored.
+	static unsigned GetVersion();
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	std::string directory;
+};
+
+//------------------------------------------------------------------------------
@@ -71,6 +71,12 @@ public:
 	//	 A reference to the component's inverse matrix.
 	const CS230::Matrix2D& GetInverseMatrix();
 
+	// Get a counter that changes every time the transform matrix changes.
+	// Lets other components cache data derived from the matrix.
+	// Returns:
+	//	 The current version of the transform matrix.
+	unsigned GetMatrixVersion();
+
 	// Set the translation of a transform component.
 	// Params:
 	//	 translation = Reference to a translation vector.
@@ -91,6 +97,16 @@ public:
 	//	 The component's rotation value (in radians).
 	float GetRotation() const;
 
+	// Get the direction the object's x-axis points in, (cos, sin) of the rotation.
+	// Cached with the matrix, so it is cheaper than calling cos and sin directly.
+	// Returns:
+	//	 A reference to the unit vector.
+	const Vector2D& GetRotationDirection();
+
+	// Get whether the rotation is a multiple of 90 degrees, so anything
+	// aligned with the object's axes is also aligned with the world's axes.
+	bool IsAxisAligned();
+
 	// Set the scale of a transform component.
 	// Params:
 	//	 translation = Reference to a scale vector.
@@ -101,6 +117,24 @@ public:
 	//	 A reference to the component's scale structure.
 	const Vector2D& GetScale() const;
 
+	// Remembers the current translation, rotation, and scale as the start of a fixed step,
+	// so drawing can blend between them and the state at the end of the step.
+	void SavePreviousState();
+
+	// Forgets the previous state so the object is drawn exactly where it is.
+	// Call this after teleporting an object so it doesn't smear across the screen.
+	void ResetInterpolation();
+
+	// Blends the previous and current state to get the matrix used for drawing.
+	// Params:
+	//   alpha = How far between the last fixed step and the next one the frame is (0 to 1).
+	void Interpolate(float alpha);
+
+	// Get the matrix objects should be drawn with.
+	// Returns:
+	//	 The blended matrix if the object has moved since its last fixed step, the transform matrix otherwise.
+	const CS230::Matrix2D& GetDrawMatrix();
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Functions:
@@ -128,8 +162,25 @@ private:
 	CS230::Matrix2D	matrix;
 	CS230::Matrix2D inverseMatrix;
 
+	// Cached (cos, sin) of the rotation, and whether it is a multiple of 90 degrees.
+	Vector2D	rotationDirection;
+	bool	isAxisAligned;
+
 	// True if the transformation matrix needs to be recalculated.
 	bool	isDirty;
+
+	// Incremented every time the matrices are recalculated.
+	unsigned	matrixVersion;
+
+	// The state at the start of the current fixed step.
+	Vector2D	previousTranslation;
+	float	previousRotation;
+	Vector2D	previousScale;
+	bool	hasPreviousState;
+
+	// The blended matrix used for drawing, only valid if isDrawInterpolated is true.
+	CS230::Matrix2D	drawMatrix;
+	bool	isDrawInterpolated;
 };
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 // Windows
 #include <windows.h>
 #include <gdiplus.h>
+#include <wincodec.h>
 
 #define _USE_MATH_DEFINES
 #include <cmath> // M_PI
@@ -25,8 +26,15 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <list>
 #include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
 
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
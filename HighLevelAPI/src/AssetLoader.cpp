@@ -0,0 +1,341 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	AssetLoader.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "AssetLoader.h"
+
+// Systems
+#include "TextureCache.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// The most worker threads to start when the count is chosen automatically.
+	// Loading is mostly waiting on the disk, so more threads don't help much.
+	const unsigned maxAutomaticThreads = 4;
+
+	// Reads an entire file into memory.
+	// Params:
+	//   filename = The path of the file.
+	//   data = The contents of the file.
+	// Returns:
+	//   True if the file could be read, false otherwise.
+	bool ReadFileData(const std::string& filename, std::vector<char>& data)
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+			return false;
+
+		std::streamoff size = file.tellg();
+		if (size <= 0)
+			return false;
+
+		data.resize(static_cast<size_t>(size));
+		file.seekg(0, std::ios::beg);
+		return static_cast<bool>(file.read(data.data(), size));
+	}
+
+	// Decodes an image file's contents into colors using the Windows Imaging Component.
+	// Params:
+	//   factory = The imaging factory belonging to the current thread.
+	//   data = The contents of the image file.
+	//   image = The image to store the decoded size and colors in.
+	// Returns:
+	//   True if the image could be decoded, false otherwise.
+	bool DecodeImageData(IWICImagingFactory* factory, std::vector<char>& data, DecodedImage& image)
+	{
+		IWICStream* stream = nullptr;
+		IWICBitmapDecoder* decoder = nullptr;
+		IWICBitmapFrameDecode* frame = nullptr;
+		IWICFormatConverter* converter = nullptr;
+		std::vector<BYTE> bytes;
+
+		HRESULT result = factory->CreateStream(&stream);
+		if (SUCCEEDED(result))
+			result = stream->InitializeFromMemory(reinterpret_cast<BYTE*>(data.data()), static_cast<DWORD>(data.size()));
+		if (SUCCEEDED(result))
+			result = factory->CreateDecoderFromStream(stream, nullptr, WICDecodeMetadataCacheOnDemand, &decoder);
+		if (SUCCEEDED(result))
+			result = decoder->GetFrame(0, &frame);
+
+		// Convert whatever format the file uses to 8 bits per channel with straight alpha.
+		if (SUCCEEDED(result))
+			result = factory->CreateFormatConverter(&converter);
+		if (SUCCEEDED(result))
+			result = converter->Initialize(frame, GUID_WICPixelFormat32bppBGRA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+		if (SUCCEEDED(result))
+			result = converter->GetSize(&image.width, &image.height);
+		if (SUCCEEDED(result))
+		{
+			bytes.resize(static_cast<size_t>(image.width) * image.height * 4);
+			result = converter->CopyPixels(nullptr, image.width * 4, static_cast<UINT>(bytes.size()), bytes.data());
+		}
+
+		if (converter != nullptr)
+			converter->Release();
+		if (frame != nullptr)
+			frame->Release();
+		if (decoder != nullptr)
+			decoder->Release();
+		if (stream != nullptr)
+			stream->Release();
+
+		if (FAILED(result))
+			return false;
+
+		// Textures are made from colors, so the conversion is done here rather than on the main thread.
+		const float scale = 1.0f / 255.0f;
+		image.pixels.resize(static_cast<size_t>(image.width) * image.height);
+		for (size_t i = 0; i < image.pixels.size(); i++)
+		{
+			const BYTE* pixel = &bytes[i * 4];
+			image.pixels[i] = Color(pixel[2] * scale, pixel[1] * scale, pixel[0] * scale, pixel[3] * scale);
+		}
+
+		return true;
+	}
+
+	// Loads an image from its cached copy if it is up to date, and reads and decodes the file otherwise.
+	// Params:
+	//   factory = The imaging factory belonging to the current thread.
+	//   cache = The cache to check before decoding, and to add the image to, if any.
+	//   filename = The path of the image file.
+	//   image = The image to store the size and colors in.
+	// Returns:
+	//   True if the image was loaded, false otherwise.
+	bool LoadImageData(IWICImagingFactory* factory, const TextureCache* cache, const std::string& filename, DecodedImage& image)
+	{
+		// A cache hit doesn't need the source file at all.
+		if (cache != nullptr && cache->Read(filename, image))
+			return true;
+
+		std::vector<char> data;
+		if (factory == nullptr || !ReadFileData(filename, data) || !DecodeImageData(factory, data, image))
+			return false;
+
+		if (cache != nullptr)
+			cache->Write(filename, data, image);
+
+		return true;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Constructor
+DecodedImage::DecodedImage() : width(0), height(0), succeeded(false)
+{
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   threadCount = How many worker threads to use, or 0 to choose based on the hardware.
+AssetLoader::AssetLoader(unsigned threadCount_) : threadCount(threadCount_), cache(nullptr), decodingCount(0), stopping(false)
+{
+	// Leave a core for the main thread.
+	if (threadCount == 0)
+	{
+		unsigned hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = hardwareThreads > 1 ? min(hardwareThreads - 1, maxAutomaticThreads) : 1;
+	}
+}
+
+// Destructor
+AssetLoader::~AssetLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	requestAdded.notify_all();
+
+	for (auto it = threads.begin(); it != threads.end(); ++it)
+		it->join();
+}
+
+// Sets the cache to check before decoding, and to add newly decoded images to.
+// Must be called before the first request, since the worker threads use it without locking.
+// Params:
+//   cache = The cache to use, or nullptr to always decode.
+void AssetLoader::SetCache(const TextureCache* cache_)
+{
+	cache = cache_;
+}
+
+// Queues an image file to be read and decoded. The worker threads are started by the first request.
+// Params:
+//   name = The name to give back with the decoded image.
+//   filename = The path of the file to load.
+void AssetLoader::RequestImage(const std::string& name, const std::string& filename)
+{
+	StartThreads();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		ImageRequest request;
+		request.name = name;
+		request.filename = filename;
+		requests.push_back(request);
+	}
+
+	requestAdded.notify_one();
+}
+
+// Takes an image that has finished decoding, if there are any.
+// Params:
+//   image = The image that finished decoding.
+// Returns:
+//   True if an image was taken, false if none are finished.
+bool AssetLoader::PopDecodedImage(DecodedImage& image)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (decodedImages.empty())
+		return false;
+
+	image = std::move(decodedImages.front());
+	decodedImages.pop_front();
+	return true;
+}
+
+// Returns how many requested images have not been taken with PopDecodedImage yet.
+size_t AssetLoader::GetPendingCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return requests.size() + decodingCount + decodedImages.size();
+}
+
+// Forgets every request that hasn't started and every image that hasn't been taken.
+// Images already being decoded are finished, and can still be popped afterward.
+void AssetLoader::Clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	requests.clear();
+	decodedImages.clear();
+}
+
+// Reads and decodes an image file on the calling thread, for when the image is needed right away.
+// Params:
+//   filename = The path of the file to load.
+//   image = The image to store the decoded size and colors in.
+//   cache = The cache to check before decoding, and to add the image to, if any.
+// Returns:
+//   True if the file could be read and decoded, false otherwise.
+bool AssetLoader::DecodeImageFile(const std::string& filename, DecodedImage& image, const TextureCache* cache)
+{
+	// Skip reading the file and setting up the decoder entirely when the cache has the image.
+	image.succeeded = false;
+	if (cache != nullptr && cache->Read(filename, image))
+	{
+		image.succeeded = true;
+		return true;
+	}
+
+	std::vector<char> data;
+	if (!ReadFileData(filename, data))
+		return false;
+
+	// COM may already be set up on this thread in another mode, which is fine as long as it isn't shut down here.
+	HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	IWICImagingFactory* factory = nullptr;
+	CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory));
+
+	// The cache was already checked, so only write to it.
+	image.succeeded = factory != nullptr && DecodeImageData(factory, data, image);
+	if (image.succeeded && cache != nullptr)
+		cache->Write(filename, data, image);
+
+	if (factory != nullptr)
+		factory->Release();
+	if (SUCCEEDED(comResult))
+		CoUninitialize();
+
+	return image.succeeded;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Starts the worker threads if they aren't running.
+void AssetLoader::StartThreads()
+{
+	if (!threads.empty())
+		return;
+
+	threads.reserve(threadCount);
+	for (unsigned i = 0; i < threadCount; i++)
+		threads.push_back(std::thread(&AssetLoader::WorkerThread, this));
+}
+
+// Decodes requests until the loader is destroyed.
+void AssetLoader::WorkerThread()
+{
+	// Each thread needs COM, and its own imaging factory.
+	HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	IWICImagingFactory* factory = nullptr;
+	if (SUCCEEDED(comResult))
+		CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory));
+
+	for (;;)
+	{
+		ImageRequest request;
+
+		// Wait for something to load.
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			requestAdded.wait(lock, [this]() { return stopping || !requests.empty(); });
+
+			if (stopping)
+				break;
+
+			request = std::move(requests.front());
+			requests.pop_front();
+			++decodingCount;
+		}
+
+		DecodedImage image;
+		image.name = request.name;
+
+		image.succeeded = LoadImageData(factory, cache, request.filename, image);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			decodedImages.push_back(std::move(image));
+			--decodingCount;
+		}
+	}
+
+	if (factory != nullptr)
+		factory->Release();
+	if (SUCCEEDED(comResult))
+		CoUninitialize();
+}
+
+//------------------------------------------------------------------------------
@@ -19,6 +19,8 @@
 
 // Systems
 #include "GameObject.h"
+#include "GJK.h"
+#include "ColliderCircle.h"
 
 // Components
 #include "Transform.h"
@@ -50,7 +52,8 @@ MapCollision::MapCollision(bool bottom, bool top, bool left, bool right) : botto
 // Params:
 //   owner = Reference to the object that owns this component.
 Collider::Collider(ColliderType type) : Component("Collider"), transform(nullptr), physics(nullptr),
-	type(type), handler(nullptr)
+	type(type), layers(1), handler(nullptr), enterHandler(nullptr), exitHandler(nullptr), mapHandler(nullptr),
+	stepVersion(0), stepped(false), unmoved(false)
 {
 }
 
@@ -60,6 +63,10 @@ void Collider::Initialize()
 	// Store the required components for ease of access.
 	transform = GetOwner()->GetComponent<Transform>();
 	physics = GetOwner()->GetComponent<Physics>();
+
+	// A new (or cloned) collider hasn't been tested anywhere yet.
+	stepped = false;
+	unmoved = false;
 }
 
 // Check if two objects are colliding and send collision events.
@@ -67,15 +74,100 @@ void Collider::Initialize()
 //	 other = Reference to the second collider component.
 void Collider::CheckCollision(const Collider& other)
 {
-	// Check if the two colliders are colliding.
-	if (IsCollidingWith(other))
+	// Check if the two colliders are colliding, or passed through each other this step.
+	if (IsCollidingWith(other) || IsSweptCollidingWith(other))
 	{
 		// Run collision event handlers if they exist.
-		if (handler != nullptr)
-			handler(*GetOwner(), *other.GetOwner());
-		if (other.handler != nullptr)
-			other.handler(*other.GetOwner(), *GetOwner());
+		SendCollisionEvent(CollisionEventStay, other);
+		other.SendCollisionEvent(CollisionEventStay, *this);
+	}
+}
+
+// Checks whether a circle with continuous collision enabled swept through another
+// collider during the last step, which IsCollidingWith can miss for fast objects.
+// Params:
+//	 other = Reference to the second collider component.
+// Returns:
+//   True if either collider is a continuous circle that touched the other, false otherwise.
+bool Collider::IsSweptCollidingWith(const Collider& other) const
+{
+	// Figure out which collider (if either) is a continuous circle.
+	const Collider* moving = this;
+	const Collider* target = &other;
+	if (!(type == ColliderTypeCircle && physics != nullptr && physics->IsContinuousCollision()))
+	{
+		if (!(other.type == ColliderTypeCircle && other.physics != nullptr && other.physics->IsContinuousCollision()))
+			return false;
+
+		std::swap(moving, target);
+	}
+
+	SupportShape targetShape;
+	if (!target->GetSupportShape(targetShape))
+		return false;
+
+	// Sweep relative to the target, as if it had been at its new position for the whole step.
+	Vector2D start = moving->physics->GetOldTranslation();
+	Vector2D end = moving->transform->GetTranslation();
+	if (target->physics != nullptr)
+		start += target->transform->GetTranslation() - target->physics->GetOldTranslation();
+
+	float t;
+	Vector2D normal;
+	float radius = static_cast<const ColliderCircle*>(moving)->GetRadius();
+	return SweptCircleIntersection(start, end, radius, targetShape, t, normal);
+}
+
+// Calls this collider's handler for a collision event, if it has one.
+// Params:
+//   type = Which event happened.
+//   other = Reference to the other collider in the pair.
+void Collider::SendCollisionEvent(CollisionEventType eventType, const Collider& other) const
+{
+	CollisionEventHandler eventHandler = nullptr;
+	switch (eventType)
+	{
+	case CollisionEventEnter:
+		eventHandler = enterHandler;
+		break;
+	case CollisionEventStay:
+		eventHandler = handler;
+		break;
+	case CollisionEventExit:
+		eventHandler = exitHandler;
+		break;
 	}
+
+	if (eventHandler != nullptr)
+		eventHandler(*GetOwner(), *other.GetOwner());
+}
+
+// Describes this collider's world space shape for GJK.
+// Params:
+//   shape = The shape to fill in.
+// Returns:
+//   False if the collider can't be described as a single convex shape (lines, tilemaps).
+bool Collider::GetSupportShape(SupportShape& shape) const
+{
+	UNREFERENCED_PARAMETER(shape);
+	return false;
+}
+
+// Calculates the contact normal, depth, and points between two colliders.
+// Params:
+//   other = Reference to the second collider component.
+//   manifold = The contact manifold, only valid if the colliders intersect.
+//   cache = The GJK simplex from the last time this pair was tested, or nullptr.
+// Returns:
+//   True if both colliders are convex shapes and they intersect, false otherwise.
+bool Collider::GetContact(const Collider& other, ContactManifold& manifold, GJKCache* cache) const
+{
+	SupportShape shape;
+	SupportShape otherShape;
+	if (!GetSupportShape(shape) || !other.GetSupportShape(otherShape))
+		return false;
+
+	return ComputeContact(shape, otherShape, manifold, cache);
 }
 
 // Get the type of this component.
@@ -84,7 +176,45 @@ ColliderType Collider::GetType() const
 	return type;
 }
 
-// Sets the collision handler function for the collider.
+// Records whether the transform has moved since the last collision step. Called once at
+// the start of each step, before any pairs are tested.
+void Collider::BeginCollisionStep()
+{
+	unsigned version = transform->GetMatrixVersion();
+	unmoved = stepped && version == stepVersion;
+	stepVersion = version;
+	stepped = true;
+}
+
+// Checks whether pairs between this collider and another sleeping one can be skipped.
+// Returns:
+//   True if the collider belongs to a sleeping physics body, or it has no physics body
+//   and wasn't moved between the last two collision steps, false otherwise.
+bool Collider::IsAsleep() const
+{
+	// Bodies wake themselves up when moved, so only colliders without one need the version check.
+	if (physics != nullptr)
+		return physics->IsAsleep();
+
+	return unmoved;
+}
+
+// Sets which layers this collider is on, for filtering collision queries.
+// Params:
+//   layers = A bitmask of layers. Defaults to 1 (the first layer).
+void Collider::SetLayers(unsigned layers_)
+{
+	layers = layers_;
+}
+
+// Gets which layers this collider is on.
+unsigned Collider::GetLayers() const
+{
+	return layers;
+}
+
+// Sets the collision handler function for the collider, called on every
+// step while this collider is touching another.
 // Params:
 //   handler = A pointer to the collision handler function.
 void Collider::SetCollisionHandler(CollisionEventHandler handler_)
@@ -92,6 +222,22 @@ void Collider::SetCollisionHandler(CollisionEventHandler handler_)
 	handler = handler_;
 }
 
+// Sets the function called once when this collider starts touching another.
+// Params:
+//   handler = A pointer to the collision handler function.
+void Collider::SetCollisionEnterHandler(CollisionEventHandler handler_)
+{
+	enterHandler = handler_;
+}
+
+// Sets the function called once when this collider stops touching another.
+// Params:
+//   handler = A pointer to the collision handler function.
+void Collider::SetCollisionExitHandler(CollisionEventHandler handler_)
+{
+	exitHandler = handler_;
+}
+
 // Sets the map collision handler function for the collider.
 // Params:
 //   handler = A pointer to the collision handler function.
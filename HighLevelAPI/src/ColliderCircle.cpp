@@ -22,6 +22,7 @@
 #include <Graphics.h>
 #include "Intersection2D.h"
 #include "GameObject.h"
+#include "GJK.h"
 #include "Parser.h"
 
 // Components
@@ -126,4 +127,15 @@ bool ColliderCircle::IsCollidingWith(const Collider& other) const
 	return other.IsCollidingWith(*this);
 }
 
+// Describes this collider's world space shape for GJK.
+// Params:
+//   shape = The shape to fill in.
+// Returns:
+//   True, circles are always convex.
+bool ColliderCircle::GetSupportShape(SupportShape& shape) const
+{
+	shape = SupportShape::FromCircle(transform->GetTranslation(), radius);
+	return true;
+}
+
 //------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 #include <Shapes2D.h>					// 2D Shapes
 #include <Intersection2D.h>				// Intersection
+#include <IntersectionSIMD.h>			// SoAPoints
 #include <Transform.h>					// Transform
 #include <Vector2D.h>					// Vector2D
 #include <Parser.h>						// Parser
@@ -24,6 +25,7 @@
 
 #include <DebugDraw.h>					// Debug Draw
 #include <Graphics.h>					// Graphics
+#include <GJK.h>						// GJK
 
 #include <ColliderRectangle.h>			// Rectangle Collider
 #include <ColliderCircle.h>				// Circle Collider
@@ -32,13 +34,13 @@
 // Public Class Member Functions
 //------------------------------------------------------------------------------
 ColliderConvex::ColliderConvex()
-	: Collider(ColliderType::ColliderTypeConvex)
+	: Collider(ColliderType::ColliderTypeConvex), cachedTransform(nullptr), cachedVersion(0)
 {
 
 }
 
 ColliderConvex::ColliderConvex(const std::vector<LineSegment>& localLines_)
-	: Collider(ColliderType::ColliderTypeConvex), localLines()
+	: Collider(ColliderType::ColliderTypeConvex), localLines(), cachedTransform(nullptr), cachedVersion(0)
 {
 	// Save the vertices of the collider
 	localLines.reserve(localLines_.size());
@@ -49,7 +51,7 @@ ColliderConvex::ColliderConvex(const std::vector<LineSegment>& localLines_)
 }
 
 ColliderConvex::ColliderConvex(const LineSegment* localPoints_, size_t size)
-	: Collider(ColliderType::ColliderTypeConvex), localLines()
+	: Collider(ColliderType::ColliderTypeConvex), localLines(), cachedTransform(nullptr), cachedVersion(0)
 {
 	// Save the vertices of the collider
 	localLines.reserve(size);
@@ -98,15 +100,22 @@ void ColliderConvex::Deserialize(Parser& parser)
 	}
 	// Skip over the ending scope
 	parser.ReadSkip('}');
+
+	// The world space data no longer matches the local lines
+	cachedTransform = nullptr;
 }
 
 void ColliderConvex::Draw()
 {
 	// Get the debug draw
 	DebugDraw& debug = DebugDraw::GetInstance();
-	Graphics& graphics = Graphics::GetInstance();
+
+	// Don't bother transforming segments that will never be drawn.
+	if (!debug.IsEnabled())
+		return;
+
 	// Iterate through every point in the convex shape
-	std::vector<LineSegment> transformed = GetLineSegments();
+	const std::vector<LineSegment>& transformed = GetLineSegments();
 	auto begin = transformed.cbegin();
 	for (; begin < transformed.cend(); ++begin)
 	{
@@ -116,48 +125,57 @@ void ColliderConvex::Draw()
 		Vector2D midpoint = begin->start.Midpoint(begin->end);
 		debug.AddLineToStrip(midpoint, midpoint + begin->normal * 20, Colors::Blue);
 	}
-	// Draw a line between the last point in the convex shape and the first in green
-	// End the line strip so it shows up
-	debug.EndLineStrip(graphics.GetCurrentCamera());
 }
 
 bool ColliderConvex::IsCollidingWith(const Collider& other) const
 {
+	// Make sure the world space hull is up to date before testing against it
+	UpdateWorldData();
+
 	// Only bother colliding with with other convex colliders and rectangles
 	switch (other.GetType())
 	{
 	case ColliderType::ColliderTypeConvex:
 	{
 		const ColliderConvex& convex = static_cast<const ColliderConvex&>(other);
-		return ConvexHullIntersection(GetLineSegments(), convex.GetLineSegments());
+		return ConvexHullIntersection(*this, convex);
 	}
 	case ColliderType::ColliderTypeRectangle:
 	{
 		const ColliderRectangle& rectangle = static_cast<const ColliderRectangle&>(other);
-		Transform* rectTransform = other.GetOwner()->GetComponent<Transform>();
-		return ConvexHullToOBBIntersection(GetLineSegments(), rectangle.GetExtents(), *rectTransform);
+		return ConvexHullToOBBIntersection(*this, rectangle);
 	}
 	case ColliderType::ColliderTypeCircle:
 	{
 		const ColliderCircle& circle = static_cast<const ColliderCircle&>(other);
-		const Transform* convexTransform = GetOwner()->GetComponent<Transform>();
-		const Transform* circleTransform = other.GetOwner()->GetComponent<Transform>();
-		return ConvexHullToCircleInteresction(GetLineSegments(), *convexTransform, 
-			Circle(circleTransform->GetTranslation(), circle.GetRadius()));
+		return ConvexHullToCircleIntersection(*this, Circle(other.transform->GetTranslation(), circle.GetRadius()));
 	}
 	case ColliderType::ColliderTypePoint:
 	{
-		Transform* point = other.GetOwner()->GetComponent<Transform>();
-		return ConvexHullToPointIntersection(GetLineSegments(), point->GetTranslation());
+		return ConvexHullToPointIntersection(*this, other.transform->GetTranslation());
 	}
 	default:
 		return false;
 	}
 }
 
+bool ColliderConvex::GetSupportShape(SupportShape& shape) const
+{
+	// The shape points straight at the cached world vertices, so no copies are made
+	UpdateWorldData();
+	if (worldVertices.empty())
+		return false;
+
+	shape = SupportShape::FromPolygon(worldVertices.data(), static_cast<unsigned>(worldVertices.size()));
+	return true;
+}
+
 void ColliderConvex::AddSide(const LineSegment& segment)
 {
 	localLines.push_back(LineSegment(segment));
+
+	// The world space data no longer matches the local lines
+	cachedTransform = nullptr;
 }
 
 const std::vector<LineSegment>& ColliderConvex::GetLocalLineSegments() const
@@ -165,16 +183,78 @@ const std::vector<LineSegment>& ColliderConvex::GetLocalLineSegments() const
 	return localLines;
 }
 
-std::vector<LineSegment> ColliderConvex::GetLineSegments() const
+const std::vector<LineSegment>& ColliderConvex::GetLineSegments() const
+{
+	UpdateWorldData();
+	return worldLines;
+}
+
+const std::vector<Vector2D>& ColliderConvex::GetWorldVertices() const
 {
-	std::vector<LineSegment> transformed;
-	transformed.reserve(localLines.size());
+	UpdateWorldData();
+	return worldVertices;
+}
 
-	for (auto begin = localLines.cbegin(); begin < localLines.cend(); ++begin)
+const std::vector<Vector2D>& ColliderConvex::GetWorldNormals() const
+{
+	UpdateWorldData();
+	return worldNormals;
+}
+
+SoAPoints ColliderConvex::GetWorldPoints() const
+{
+	UpdateWorldData();
+	return SoAPoints(worldX.data(), worldY.data(), worldX.size());
+}
+
+SoAPoints ColliderConvex::GetWorldAxes() const
+{
+	UpdateWorldData();
+	return SoAPoints(axesX.data(), axesY.data(), axesX.size());
+}
+
+//------------------------------------------------------------------------------
+// Private Class Member Functions
+//------------------------------------------------------------------------------
+void ColliderConvex::UpdateWorldData() const
+{
+	// Nothing to do if the transform hasn't changed since the last rebuild
+	unsigned version = transform->GetMatrixVersion();
+	if (cachedTransform == transform && cachedVersion == version)
+		return;
+
+	// Resizing keeps the old capacity, so this only allocates the first time through
+	worldLines.resize(localLines.size());
+	worldVertices.resize(localLines.size());
+	worldNormals.resize(localLines.size());
+	worldX.resize(localLines.size());
+	worldY.resize(localLines.size());
+	axesX.clear();
+	axesY.clear();
+
+	transform->GetMatrix().TransformSegments(localLines.data(), worldLines.data(), localLines.size());
+	for (size_t i = 0; i < localLines.size(); ++i)
 	{
-		LineSegment transformedSegment(transform->GetMatrix() * begin->start, transform->GetMatrix() * begin->end);
-		transformed.push_back(transformedSegment);
+		worldVertices[i] = worldLines[i].end;
+		worldNormals[i] = worldLines[i].normal;
+		worldX[i] = worldLines[i].end.x;
+		worldY[i] = worldLines[i].end.y;
+
+		// Opposite sides of a symmetric hull share an axis, so only the first one needs testing
+		const Vector2D& axis = worldLines[i].normal;
+		bool duplicate = false;
+		for (size_t j = 0; j < axesX.size() && !duplicate; ++j)
+		{
+			duplicate = AreAxesParallel(axis, Vector2D(axesX[j], axesY[j]));
+		}
+
+		if (!duplicate)
+		{
+			axesX.push_back(axis.x);
+			axesY.push_back(axis.y);
+		}
 	}
 
-	return transformed;
-}
\ No newline at end of file
+	cachedTransform = transform;
+	cachedVersion = version;
+}
@@ -30,6 +30,23 @@
 
 //------------------------------------------------------------------------------
 
+namespace
+{
+	// Colliders with fewer segments than this don't build a hierarchy, since testing every segment is cheap.
+	const unsigned bvhMinSegments = 16;
+
+	// The most segments in a leaf of the hierarchy.
+	const unsigned bvhLeafSize = 4;
+
+	// Enough room for the nodes waiting to be searched, since the tree is split evenly.
+	const unsigned bvhStackSize = 64;
+
+	// How much to grow a movement's box by, so segments it ends right on aren't missed.
+	const float bvhPadding = 0.001f;
+}
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
@@ -41,7 +58,8 @@
 // Create a new (line) collider component.
 // Params:
 //   reflection = Whether points should be reflected off this collider.
-ColliderLine::ColliderLine(bool reflection) : maxResolutions(4), Collider(ColliderTypeLines), reflection(reflection)
+ColliderLine::ColliderLine(bool reflection) : maxResolutions(4), Collider(ColliderTypeLines), reflection(reflection),
+	cachedTransform(nullptr), cachedVersion(0), bvhDirty(false)
 {
 }
 
@@ -58,18 +76,19 @@ void ColliderLine::Draw()
 {
 	DebugDraw& debugDraw = DebugDraw::GetInstance();
 
+	// Don't bother transforming segments that will never be drawn.
+	if (!debugDraw.IsEnabled())
+		return;
+
 	// Add every line segment on this collider to the current line strip.
 	for (unsigned i = 0; i < lineSegments.size(); i++)
 	{
-		// Apply the transform to the line.
-		LineSegment transformedSegment = GetLineWithTransform(i);
+		// Get the line with the transform applied.
+		const LineSegment& transformedSegment = GetLineWithTransform(i);
 		debugDraw.AddLineToStrip(transformedSegment.start, transformedSegment.end, Colors::Green);
 		Vector2D midpoint = transformedSegment.start.Midpoint(transformedSegment.end);
 		debugDraw.AddLineToStrip(midpoint, midpoint + transformedSegment.normal * 20.0f, Colors::Red);
 	}
-	
-	// Draw the line strip.
-	debugDraw.EndLineStrip(Graphics::GetInstance().GetCurrentCamera());
 }
 
 // Add a line segment to the line collider's line segment list.
@@ -79,35 +98,10 @@ void ColliderLine::Draw()
 void ColliderLine::AddLineSegment(const Vector2D& p0, const Vector2D& p1)
 {
 	lineSegments.push_back(LineSegment(p0, p1));
-}
-
-namespace
-{
-	// Helper struct for containing intersection data.
-	struct IntersectionData
-	{
-		// Constructor
-		// Params:
-		//   index = The index of the line segment this intersection data is for.
-		//   intersection = The actual intersection point.
-		//   t = How far into the moving point's movement the collision occured.
-		//   intersected = Whether an intersection occurred.
-		IntersectionData(unsigned index = 0, Vector2D intersection = Vector2D(), float t = 0.0f, bool intersected = false) : index(index), intersection(intersection), t(t), intersected(intersected)
-		{
-		}
-
-		// The index of the line segment this intersection data is for.
-		int index;
-
-		// The actual intersection point.
-		Vector2D intersection;
-
-		// How far into the moving point's movement the collision occured.
-		float t;
 
-		// Whether an intersection occurred.
-		bool intersected;
-	};
+	// The cached world segments and hierarchy no longer match.
+	cachedTransform = nullptr;
+	bvhDirty = true;
 }
 
 // Check for collision between a line collider and another arbitrary collider.
@@ -127,13 +121,10 @@ bool ColliderLine::IsCollidingWith(const Collider& other) const
 		if (lineSegments.size() == 0)
 			return false;
 
-		int resolutionCount = 0;
-
-		IntersectionData* intersections = nullptr;
+		// Make sure the world space segments are up to date before testing against them.
+		UpdateWorldData();
 
-		// If we have reflections, we're gonna need a list of intersections.
-		if (reflection)
-			intersections = new IntersectionData[lineSegments.size()];
+		int resolutionCount = 0;
 
 		// This is in a loop to handle multiple collisions & resolutions in a single update.
 		do
@@ -141,53 +132,22 @@ bool ColliderLine::IsCollidingWith(const Collider& other) const
 			// Create the current moving point's line segment.
 			LineSegment movingPoint(other.physics->GetOldTranslation(), other.transform->GetTranslation());
 
-			// Iterate over every line segment and check collisions on each.
-			for (unsigned i = 0; i < lineSegments.size(); i++)
-			{
-				Vector2D intersection;
-				float t;
-
-				// Clear the current intersection data for this line segment.
-				if (reflection)
-					intersections[i] = { i, Vector2D(), 0.0f, false };
-
-				// If the lines are not intersecting, skip this line segment.
-				if (!MovingPointLineIntersection(GetLineWithTransform(i), movingPoint, intersection, t))
-					continue;
-
-				if (reflection)
-					// Save the current intersction data for this line segment
-					intersections[i] = { i, intersection, t, true };
-				else
-					// If reflection is not enabled, we do not need to handle any resolutions, the event was enough.
-					return true;
-			}
+			// Find the first intersection, the one with the lowest t. If reflection is
+			// not enabled, any intersection will do, since the event is all that's needed.
+			unsigned index;
+			Vector2D intersection;
+			float t;
+			if (!FindIntersection(movingPoint, index, intersection, t, reflection))
+				break;
 
-			// Find the first intersection, the one with the lowest t.
-			// Defaults to the first element, though if `intersected` is false it'll just ignore it.
-			IntersectionData& firstIntersection = intersections[0];
-			for (unsigned i = 0; i < lineSegments.size(); i++)
-			{
-				if (intersections[i].intersected && (intersections[i].t < firstIntersection.t || !firstIntersection.intersected))
-					firstIntersection = intersections[i];
-			}
+			if (!reflection)
+				return true;
 
-			// Handle reflection with the first intersection, if there was one.
-			if (firstIntersection.intersected)
-			{
-				MovingPointLineReflection(*other.transform, *other.physics, GetLineWithTransform(firstIntersection.index), movingPoint, firstIntersection.intersection);
-				++resolutionCount;
-			}
-			else
-			{
-				// There were no intersections, so there's no point doing another loop.
-				break;
-			}
+			// Handle reflection with the first intersection.
+			MovingPointLineReflection(*other.transform, *other.physics, worldSegments[index], movingPoint, intersection);
+			++resolutionCount;
 		} while (resolutionCount < maxResolutions); // Limit the number of resolutions for performance reasons.
 
-		// Delete the dynamically allocated intersections.
-		delete[] intersections;
-
 		return resolutionCount > 0;
 	}
 	}
@@ -230,17 +190,199 @@ void ColliderLine::Deserialize(Parser & parser)
 		lineSegments.push_back(lineSegment);
 	}
 	parser.ReadSkip("}");
+
+	cachedTransform = nullptr;
+	bvhDirty = true;
 }
 
 // Gets a line segment that incorporates the transform of the object
 // Params:
 //   index = The index of the line within the array of line segments.
-LineSegment ColliderLine::GetLineWithTransform(unsigned index) const
+// Returns:
+//   The world space segment, cached until the transform or segments change.
+const LineSegment& ColliderLine::GetLineWithTransform(unsigned index) const
+{
+	UpdateWorldData();
+
+	return worldSegments[index];
+}
+
+// Gets how many line segments the collider has.
+unsigned ColliderLine::GetLineCount() const
+{
+	return static_cast<unsigned>(lineSegments.size());
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Recalculates the world space segments if the transform or segments changed.
+void ColliderLine::UpdateWorldData() const
+{
+	if (bvhDirty)
+		BuildBVH();
+
+	// Nothing to do if the transform hasn't changed since the last rebuild.
+	unsigned version = transform->GetMatrixVersion();
+	if (cachedTransform == transform && cachedVersion == version)
+		return;
+
+	// Resizing keeps the old capacity, so this only allocates when segments are added.
+	worldSegments.resize(lineSegments.size());
+	transform->GetMatrix().TransformSegments(lineSegments.data(), worldSegments.data(), lineSegments.size());
+
+	cachedTransform = transform;
+	cachedVersion = version;
+}
+
+// Finds the segment a moving point hits first.
+// Params:
+//   movingPoint = The world space movement of the point.
+//   index = The index of the segment that was hit.
+//   intersection = Where the point hit the segment.
+//   t = How far along the movement the hit happened.
+//   findFirst = False to stop at any hit instead of finding the earliest.
+// Returns:
+//   True if the point hit any segment, false otherwise.
+bool ColliderLine::FindIntersection(const LineSegment& movingPoint, unsigned& index, Vector2D& intersection, float& t, bool findFirst) const
 {
-	LineSegment transformedSegment = lineSegments[index];
-	transformedSegment.start = transform->GetMatrix() * transformedSegment.start;
-	transformedSegment.end = transform->GetMatrix() * transformedSegment.end;
-	return transformedSegment;
+	bool found = false;
+
+	// Tests a single segment, returning true once the search can stop.
+	auto testSegment = [&](unsigned segment)
+	{
+		Vector2D segmentIntersection;
+		float segmentT;
+		if (!MovingPointLineIntersection(worldSegments[segment], movingPoint, segmentIntersection, segmentT))
+			return false;
+
+		if (!found || segmentT < t)
+		{
+			found = true;
+			index = segment;
+			intersection = segmentIntersection;
+			t = segmentT;
+		}
+
+		return !findFirst;
+	};
+
+	// Colliders with only a few segments just test all of them.
+	if (bvhNodes.empty())
+	{
+		for (unsigned i = 0; i < worldSegments.size(); i++)
+		{
+			if (testSegment(i))
+				break;
+		}
+
+		return found;
+	}
+
+	// The hierarchy is built in local space, so bring the movement into local space to search it.
+	const CS230::Matrix2D& inverseMatrix = transform->GetInverseMatrix();
+	Vector2D localStart = inverseMatrix * movingPoint.start;
+	Vector2D localEnd = inverseMatrix * movingPoint.end;
+	Vector2D moveMin(min(localStart.x, localEnd.x) - bvhPadding, min(localStart.y, localEnd.y) - bvhPadding);
+	Vector2D moveMax(max(localStart.x, localEnd.x) + bvhPadding, max(localStart.y, localEnd.y) + bvhPadding);
+
+	unsigned stack[bvhStackSize];
+	unsigned stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		unsigned nodeIndex = stack[--stackSize];
+		const BVHNode& node = bvhNodes[nodeIndex];
+
+		// Skip everything under nodes the movement doesn't pass near.
+		if (node.boundsMax.x < moveMin.x || node.boundsMin.x > moveMax.x || node.boundsMax.y < moveMin.y || node.boundsMin.y > moveMax.y)
+			continue;
+
+		if (node.count > 0)
+		{
+			for (unsigned i = 0; i < node.count; i++)
+			{
+				if (testSegment(bvhSegments[node.first + i]))
+					return true;
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.secondChild;
+			stack[stackSize++] = nodeIndex + 1;
+		}
+	}
+
+	return found;
+}
+
+// Rebuilds the hierarchy over the segments, or clears it if there are too few segments to need one.
+void ColliderLine::BuildBVH() const
+{
+	bvhNodes.clear();
+	bvhSegments.clear();
+	bvhDirty = false;
+
+	if (lineSegments.size() < bvhMinSegments)
+		return;
+
+	bvhSegments.resize(lineSegments.size());
+	for (unsigned i = 0; i < bvhSegments.size(); i++)
+		bvhSegments[i] = i;
+
+	bvhNodes.reserve(2 * lineSegments.size() / bvhLeafSize + 1);
+	BuildBVHNode(0, static_cast<unsigned>(bvhSegments.size()));
+}
+
+// Builds a node, and the nodes below it, for a range of bvhSegments.
+// Params:
+//   first = The first entry in bvhSegments under the node.
+//   count = How many entries are under the node.
+void ColliderLine::BuildBVHNode(unsigned first, unsigned count) const
+{
+	// Nodes are referred to by index, since adding children can move the array.
+	unsigned nodeIndex = static_cast<unsigned>(bvhNodes.size());
+	bvhNodes.push_back(BVHNode());
+
+	// Find the box around every segment under this node.
+	Vector2D boundsMin(FLT_MAX, FLT_MAX);
+	Vector2D boundsMax(-FLT_MAX, -FLT_MAX);
+	for (unsigned i = first; i < first + count; i++)
+	{
+		const LineSegment& segment = lineSegments[bvhSegments[i]];
+		boundsMin.x = min(boundsMin.x, min(segment.start.x, segment.end.x));
+		boundsMin.y = min(boundsMin.y, min(segment.start.y, segment.end.y));
+		boundsMax.x = max(boundsMax.x, max(segment.start.x, segment.end.x));
+		boundsMax.y = max(boundsMax.y, max(segment.start.y, segment.end.y));
+	}
+
+	bvhNodes[nodeIndex].boundsMin = boundsMin;
+	bvhNodes[nodeIndex].boundsMax = boundsMax;
+	bvhNodes[nodeIndex].first = first;
+	bvhNodes[nodeIndex].count = count;
+	bvhNodes[nodeIndex].secondChild = 0;
+
+	if (count <= bvhLeafSize)
+		return;
+
+	// Split the segments in half by their centers, along the longer side of the box.
+	bool splitX = boundsMax.x - boundsMin.x >= boundsMax.y - boundsMin.y;
+	auto begin = bvhSegments.begin() + first;
+	std::nth_element(begin, begin + count / 2, begin + count, [this, splitX](unsigned a, unsigned b)
+	{
+		const LineSegment& segmentA = lineSegments[a];
+		const LineSegment& segmentB = lineSegments[b];
+		if (splitX)
+			return segmentA.start.x + segmentA.end.x < segmentB.start.x + segmentB.end.x;
+		return segmentA.start.y + segmentA.end.y < segmentB.start.y + segmentB.end.y;
+	});
+
+	bvhNodes[nodeIndex].count = 0;
+	BuildBVHNode(first, count / 2);
+	bvhNodes[nodeIndex].secondChild = static_cast<unsigned>(bvhNodes.size());
+	BuildBVHNode(first + count / 2, count - count / 2);
 }
 
 // sage was here :)
@@ -22,6 +22,7 @@
 #include <Graphics.h>
 #include "Intersection2D.h"
 #include "GameObject.h"
+#include "GJK.h"
 
 // Components
 #include "Transform.h"
@@ -89,4 +90,15 @@ bool ColliderPoint::IsCollidingWith(const Collider& other) const
 	return other.IsCollidingWith(*this);
 }
 
+// Describes this collider's world space shape for GJK.
+// Params:
+//   shape = The shape to fill in.
+// Returns:
+//   True, points are always convex.
+bool ColliderPoint::GetSupportShape(SupportShape& shape) const
+{
+	shape = SupportShape::FromPoint(transform->GetTranslation());
+	return true;
+}
+
 //------------------------------------------------------------------------------
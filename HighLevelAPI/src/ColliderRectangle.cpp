@@ -21,7 +21,9 @@
 #include <DebugDraw.h>
 #include <Graphics.h>
 #include "Intersection2D.h"
+#include "IntersectionSIMD.h"
 #include "GameObject.h"
+#include "GJK.h"
 #include "Parser.h"
 
 // Components
@@ -30,33 +32,14 @@
 
 //------------------------------------------------------------------------------
 
-namespace
-{
-	// Helper function to keep a value within a range.
-	// Params:
-	//   value = The value to loop.
-	//   min = The lower bounds of the value.
-	//   max = The upper bounds of the value.
-	// Returns:
-	//   value, adjusted to be within the range of min-max.
-	float Loop(float value, float min, float max)
-	{
-		while (value < min)
-			value += (max - min);
-		while (value > max)
-			value -= (max - min);
-		return value;
-	}
-}
-
-//------------------------------------------------------------------------------
 // Public Functions:
 //------------------------------------------------------------------------------
 
 // Constructor for rectangle collider.
 // Params:
 //   extents = The rectangle's extents (half-width, half-height).
-ColliderRectangle::ColliderRectangle(const Vector2D& extents) : Collider(ColliderTypeRectangle), extents(extents)
+ColliderRectangle::ColliderRectangle(const Vector2D& extents) : Collider(ColliderTypeRectangle), extents(extents),
+	worldBounds(Vector2D(), Vector2D()), cachedTransform(nullptr), cachedVersion(0)
 {
 }
 
@@ -74,6 +57,7 @@ Component* ColliderRectangle::Clone() const
 void ColliderRectangle::Deserialize(Parser& parser)
 {
 	parser.ReadVariable("extents", extents);
+	cachedTransform = nullptr;
 }
 
 // Saves object data to a file.
@@ -90,32 +74,24 @@ void ColliderRectangle::Draw()
 	// Draw the rectangle using DebugDraw.
 	DebugDraw& debugDraw = DebugDraw::GetInstance();
 
-	if (AlmostEqual(Loop(transform->GetRotation(), -M_PI_F / 4.0f, M_PI_F / 4.0f), 0.0f))
-	{
-		Vector2D tempExtents = extents;
-
-		// Check if angles are +/- 90 degrees instead of 0 or 180 degrees, and rotate them if so.
-		if (!AlmostEqual(Loop(transform->GetRotation(), -M_PI_F / 2.0f, M_PI_F / 2.0f), 0.0f))
-			std::swap(tempExtents.x, tempExtents.y);
+	if (!debugDraw.IsEnabled())
+		return;
 
-		debugDraw.AddRectangle(transform->GetTranslation(), tempExtents, Graphics::GetInstance().GetCurrentCamera(), Colors::Green);
+	if (transform->IsAxisAligned())
+	{
+		// The bounds already have their extents swapped for rectangles turned 90 degrees.
+		const BoundingRectangle& bounds = GetWorldBounds();
+		debugDraw.AddRectangle(bounds.center, bounds.extents, Graphics::GetInstance().GetCurrentCamera(), Colors::Green);
 	}
 	else
 	{
-		// Get the corners of the rectangle in object space.
-		Vector2D points[4];
-		GetOBBCorners(*this, points);
-
-		// Transform the corners into world space.
-		for (unsigned i = 0; i < 4; i++)
-			points[i] = transform->GetMatrix() * points[i];
+		const Vector2D* points = GetWorldCorners();
 
 		// Draw the rectangle using the world space corners.
 		debugDraw.AddLineToStrip(points[0], points[1], Colors::Green);
 		debugDraw.AddLineToStrip(points[1], points[2], Colors::Green);
 		debugDraw.AddLineToStrip(points[2], points[3], Colors::Green);
 		debugDraw.AddLineToStrip(points[3], points[0], Colors::Green);
-		debugDraw.EndLineStrip(Graphics::GetInstance().GetCurrentCamera());
 	}
 }
 
@@ -133,6 +109,7 @@ const Vector2D& ColliderRectangle::GetExtents() const
 void ColliderRectangle::SetExtents(const Vector2D& extents_)
 {
 	extents = extents_;
+	cachedTransform = nullptr;
 }
 
 // Check for collision between a rectangle and another arbitrary collider.
@@ -143,28 +120,11 @@ void ColliderRectangle::SetExtents(const Vector2D& extents_)
 bool ColliderRectangle::IsCollidingWith(const Collider& other) const
 {
 	// The translation of the other collider.
-	Vector2D otherTranslation = static_cast<Transform*>(other.GetOwner()->GetComponent<Transform>())->GetTranslation();
-
-	// The BoundingRectangle for this collider.
-	BoundingRectangle rectangle = BoundingRectangle(transform->GetTranslation(), extents);
-
-	// Normalize the angles to within -PI/2, +PI/2
-	float angle1 = transform->GetRotation();
-
-	// Calculate whether the angles are axis-aligned (multiples of 90 degrees)
-	bool angle1AxisAligned = AlmostEqual(Loop(angle1, -M_PI_F / 4.0f, M_PI_F / 4.0f), 0.0f);
-
-	// Check if angles are +/- 90 degrees instead of 0 or 180 degrees, and rotate them if so.
-	if (!AlmostEqual(Loop(angle1, -M_PI_F / 2.0f, M_PI_F / 2.0f), 0.0f))
-	{
-		std::swap(rectangle.extents.x, rectangle.extents.y);
-		rectangle.left = rectangle.center.x - rectangle.extents.x;
-		rectangle.top = rectangle.center.y + rectangle.extents.y;
-		rectangle.right = rectangle.center.x + rectangle.extents.x;
-		rectangle.bottom = rectangle.center.y - rectangle.extents.y;
+	const Vector2D& otherTranslation = other.transform->GetTranslation();
 
-		angle1 = 0.0f;
-	}
+	// Rectangles turned a multiple of 90 degrees can use their cached world bounds directly.
+	bool angle1AxisAligned = transform->IsAxisAligned();
+	const BoundingRectangle& rectangle = GetWorldBounds();
 
 	switch (other.GetType())
 	{
@@ -202,40 +162,107 @@ bool ColliderRectangle::IsCollidingWith(const Collider& other) const
 		// Interpret the other collider as a rectangle collider for ease of access.
 		const ColliderRectangle& otherRectangle = static_cast<const ColliderRectangle&>(other);
 
-		// Normalize the angles to within -PI/2, +PI/2
-		float angle2 = other.transform->GetRotation();
+		// If the bounds don't overlap, the rectangles can't either.
+		if (!RectangleRectangleIntersection(rectangle, otherRectangle.GetWorldBounds()))
+			return false;
 
-		// Calculate whether the angles are axis-aligned (multiples of 90 degrees)
-		bool angle2AxisAligned = AlmostEqual(Loop(angle2, -M_PI_F / 4.0f, M_PI_F / 4.0f), 0.0f);
+		// When both rectangles are axis-aligned, the bounds are the rectangles.
+		if (angle1AxisAligned && other.transform->IsAxisAligned())
+			return true;
 
-		if (angle1AxisAligned && angle2AxisAligned)
-		{
-			BoundingRectangle otherBoundingRectangle(otherTranslation, otherRectangle.GetExtents());
-
-			// Check if angles are +/- 90 degrees instead of 0 or 180 degrees, and rotate them if so.
-			if (!AlmostEqual(Loop(angle2, -M_PI_F / 2.0f, M_PI_F / 2.0f), 0.0f))
-			{
-				std::swap(otherBoundingRectangle.extents.x, otherBoundingRectangle.extents.y);
-				otherBoundingRectangle.left = otherBoundingRectangle.center.x - otherBoundingRectangle.extents.x;
-				otherBoundingRectangle.top = otherBoundingRectangle.center.y + otherBoundingRectangle.extents.y;
-				otherBoundingRectangle.right = otherBoundingRectangle.center.x + otherBoundingRectangle.extents.x;
-				otherBoundingRectangle.bottom = otherBoundingRectangle.center.y - otherBoundingRectangle.extents.y;
-
-				angle2 = 0.0f;
-			}
-
-			// Check if the other rectangle is intersecting the rectangle.
-			return RectangleRectangleIntersection(rectangle, otherBoundingRectangle);
-		}
-		else
-		{
-			// Check if the other oriented bounding box is intersecting the oriented bounding box.
-			return OBBOBBIntersection(*this, otherRectangle);
-		}
+		// Check if the other oriented bounding box is intersecting the oriented bounding box.
+		return OBBOBBIntersection(*this, otherRectangle);
 	}
 	}
 
 	return other.IsCollidingWith(*this);
 }
 
+// Describes this collider's world space shape for GJK.
+// Params:
+//   shape = The shape to fill in.
+// Returns:
+//   True, rectangles are always convex.
+bool ColliderRectangle::GetSupportShape(SupportShape& shape) const
+{
+	shape = SupportShape::FromBox(GetWorldCorners());
+	return true;
+}
+
+// Get the rectangle's corners in world space, recalculated only when the transform changes.
+// Returns:
+//	 A pointer to the four corners, in the same order as GetOBBCorners.
+const Vector2D* ColliderRectangle::GetWorldCorners() const
+{
+	UpdateWorldData();
+
+	return worldCorners;
+}
+
+// Get the world space axis-aligned box around the rectangle. For rectangles
+// whose transform is axis-aligned, this is the rectangle itself.
+// Returns:
+//	 A reference to the bounding rectangle.
+const BoundingRectangle& ColliderRectangle::GetWorldBounds() const
+{
+	UpdateWorldData();
+
+	return worldBounds;
+}
+
+// Get the world space corners as separate x and y arrays.
+// Returns:
+//	 A view of the four corners, valid until the transform changes.
+SoAPoints ColliderRectangle::GetWorldCornerPoints() const
+{
+	UpdateWorldData();
+
+	return SoAPoints(cornersX, cornersY, 4);
+}
+
+// Get the rectangle's two world space axes. The other two sides are parallel to these.
+// Returns:
+//	 A view of the two axes, valid until the transform changes.
+SoAPoints ColliderRectangle::GetWorldAxes() const
+{
+	UpdateWorldData();
+
+	return SoAPoints(axesX, axesY, 2);
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Recalculates the world space corners, bounds, and axes if the transform or extents changed.
+void ColliderRectangle::UpdateWorldData() const
+{
+	unsigned version = transform->GetMatrixVersion();
+	if (cachedTransform == transform && cachedVersion == version)
+		return;
+
+	GetOBBCorners(*this, worldCorners);
+	ApplyTransformToPoints(transform->GetMatrix(), worldCorners, 4);
+
+	// Opposite corners are the farthest apart along both axes, so two of them bound the rectangle.
+	Vector2D halfSize(max(fabsf(worldCorners[1].x - worldCorners[3].x), fabsf(worldCorners[0].x - worldCorners[2].x)) / 2.0f,
+		max(fabsf(worldCorners[1].y - worldCorners[3].y), fabsf(worldCorners[0].y - worldCorners[2].y)) / 2.0f);
+	worldBounds = BoundingRectangle(transform->GetTranslation(), halfSize);
+
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		cornersX[i] = worldCorners[i].x;
+		cornersY[i] = worldCorners[i].y;
+	}
+
+	Vector2D axis = transform->GetRotationDirection();
+	axesX[0] = axis.x;
+	axesY[0] = axis.y;
+	axesX[1] = -axis.y;
+	axesY[1] = axis.x;
+
+	cachedTransform = transform;
+	cachedVersion = version;
+}
+
 //------------------------------------------------------------------------------
@@ -19,17 +19,55 @@
 
 // Systems
 #include "Tilemap.h"
-#include <Shapes2D.h>
 #include "GameObject.h"
-#include <Interpolation.h>
 
 // Components
 #include "ColliderRectangle.h"
+#include "ColliderCircle.h"
 #include "Transform.h"
 #include "Physics.h"
 
 //------------------------------------------------------------------------------
 
+namespace
+{
+	// How far (in tiles) a box must reach into a cell before it counts as touching it.
+	// Keeps boxes resting exactly on a tile edge from snagging on the next row or column.
+	const float cellSkin = 0.001f;
+
+	// Gets the index of the cell containing a grid coordinate.
+	int GetCell(float coordinate)
+	{
+		return static_cast<int>(floor(coordinate));
+	}
+
+	// Finds when a point moving along one axis leaves a range.
+	// Params:
+	//   start = Where the point starts.
+	//   movement = How far the point moves.
+	//   lower = The bottom of the range.
+	//   upper = The top of the range.
+	// Returns:
+	//   The fraction of the movement at which the point leaves the range,
+	//   or a negative value if it is outside the range and never enters it.
+	float GetExitTime(float start, float movement, float lower, float upper)
+	{
+		if (movement == 0.0f)
+			return start > lower && start < upper ? FLT_MAX : -1.0f;
+
+		return ((movement > 0.0f ? upper : lower) - start) / movement;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Creates an empty hit.
+TilemapRaycastHit::TilemapRaycastHit() : distance(0.0f), column(0), row(0)
+{
+}
+
 //------------------------------------------------------------------------------
 // Public Functions:
 //------------------------------------------------------------------------------
@@ -59,69 +97,72 @@ void ColliderTilemap::Draw()
 //	 Return the results of the collision check.
 bool ColliderTilemap::IsCollidingWith(const Collider& other) const
 {
-	// Only collision with rectangle colliders is handled.
-	if (other.GetType() != ColliderType::ColliderTypeRectangle)
+	// Rectangles, circles, and points are all treated as axis-aligned boxes.
+	Vector2D extents;
+	switch (other.GetType())
+	{
+	case ColliderType::ColliderTypeRectangle:
+		extents = static_cast<const ColliderRectangle&>(other).GetExtents();
+		break;
+	case ColliderType::ColliderTypeCircle:
+	{
+		float radius = static_cast<const ColliderCircle&>(other).GetRadius();
+		extents = Vector2D(radius, radius);
+		break;
+	}
+	case ColliderType::ColliderTypePoint:
+		break;
+	default:
 		return false;
+	}
 
-	// The physics of the other object.
-	Physics* otherPhysics = static_cast<Physics*>(other.GetOwner()->GetComponent<Physics>());
+	Transform* otherTransform = other.transform;
+	Physics* otherPhysics = other.physics;
 
-	bool shouldResolve = otherPhysics != nullptr;
+	// Convert the object's box into grid space. Points still need a sliver of size to cover a cell.
+	const Vector2D& tileScale = transform->GetScale();
+	Vector2D gridExtents(max(extents.x / fabsf(tileScale.x), cellSkin), max(extents.y / fabsf(tileScale.y), cellSkin));
+	Vector2D gridEnd = WorldToGrid(otherTransform->GetTranslation());
 
-	// The transform of the other object.
-	Transform* otherTransform = static_cast<Transform*>(other.GetOwner()->GetComponent<Transform>());
+	MapCollision mapCollision = MapCollision(false, false, false, false);
 
-	// The translation of the other collider.
-	Vector2D otherTranslation = otherTransform->GetTranslation();
+	// Without physics, we don't know where the object came from, so just report any overlap.
+	if (otherPhysics == nullptr)
+	{
+		if (!FindOverlapSides(gridEnd, gridExtents, mapCollision))
+			return false;
+	}
+	else
+	{
+		// Walk the box from where it was to where it is, one axis at a time.
+		// If it already started inside solid cells, get it out of them first.
+		Vector2D gridPosition = PushOutOfCells(WorldToGrid(otherPhysics->GetOldTranslation()), gridExtents, mapCollision);
 
-	// The other collider as a ColliderRectangle.
-	const ColliderRectangle& otherRectangle = static_cast<const ColliderRectangle&>(other);
+		gridPosition.x = SweepAxis(gridPosition, gridExtents, gridEnd.x - gridPosition.x, 0, mapCollision);
+		gridPosition.y = SweepAxis(gridPosition, gridExtents, gridEnd.y - gridPosition.y, 1, mapCollision);
 
-	// The bounding box of the other collider.
-	BoundingRectangle otherBounding = BoundingRectangle(otherTranslation, otherRectangle.GetExtents());
+		if (!(mapCollision.bottom || mapCollision.top || mapCollision.left || mapCollision.right))
+			return false;
 
-	// Which sides are currently colliding.
-	MapCollision mapCollision = MapCollision(
-		IsSideColliding(otherBounding, RectangleSide::SideBottom),
-		IsSideColliding(otherBounding, RectangleSide::SideTop),
-		IsSideColliding(otherBounding, RectangleSide::SideLeft),
-		IsSideColliding(otherBounding, RectangleSide::SideRight)
-	);
+		// Move the object back to where it was stopped, and stop velocity into the tiles.
+		Vector2D translation = otherTransform->GetTranslation();
+		Vector2D velocity = otherPhysics->GetVelocity();
+		Vector2D stopped = GridToWorld(gridPosition);
 
-	// If resolution is not possible, simply check if anything is colliding and return.
-	if (!shouldResolve)
-	{
-		if (mapCollision.bottom || mapCollision.top || mapCollision.left || mapCollision.right)
+		if (mapCollision.left || mapCollision.right)
 		{
-			// Call the map collision event handler if it exists.
-			MapCollisionEventHandler collisionEventHandler = other.GetMapCollisionHandler();
-			if (collisionEventHandler != nullptr)
-				collisionEventHandler(*other.GetOwner(), mapCollision);
-
-			return true;
+			translation.x = stopped.x;
+			velocity.x = 0.0f;
 		}
-		else
+		if (mapCollision.bottom || mapCollision.top)
 		{
-			return false;
+			translation.y = stopped.y;
+			velocity.y = 0.0f;
 		}
-	}
-
-	// The old translation of the other collider.
-	Vector2D otherOldTranslation = otherPhysics->GetOldTranslation();
-
-	Vector2D otherNewTranslation = otherTranslation;
-
-	// The velocity of the other object.
-	Vector2D otherVelocity = otherPhysics->GetVelocity();
 
-	Vector2D otherNewVelocity = otherVelocity;
-
-	// If nothing is colliding, return false.
-	if (!(mapCollision.bottom || mapCollision.top || mapCollision.left || mapCollision.right))
-		return false;
-
-	// Resolve collisions.
-	ResolveCollisions(otherBounding, otherTransform, otherPhysics, mapCollision);
+		otherTransform->SetTranslation(translation);
+		otherPhysics->SetVelocity(velocity);
+	}
 
 	// Call the map collision event handler if it exists.
 	MapCollisionEventHandler collisionEventHandler = other.GetMapCollisionHandler();
@@ -139,209 +180,448 @@ void ColliderTilemap::SetTilemap(const Tilemap* map_)
 	map = map_;
 }
 
-//------------------------------------------------------------------------------
-// Private Functions:
-//------------------------------------------------------------------------------
+// Gets the tilemap this collider uses.
+const Tilemap* ColliderTilemap::GetTilemap() const
+{
+	return map;
+}
+
+// Finds the first solid tile along a ray, visiting only the cells the ray passes through.
+// Params:
+//   start = Where the ray starts, in world space.
+//   direction = Which way the ray goes. Doesn't need to be normalized.
+//   maxDistance = How far the ray goes, in world units.
+//   hit = Information about the first tile hit, only valid if this returns true.
+// Returns:
+//   True if the ray hit a solid tile, false otherwise.
+bool ColliderTilemap::Raycast(const Vector2D& start, const Vector2D& direction, float maxDistance, TilemapRaycastHit& hit) const
+{
+	return BoxCast(start, Vector2D(), direction, maxDistance, hit);
+}
 
-// Checks whether the specified side of a given rectangle is colliding with the tilemap.
+// Finds the first solid tile an axis-aligned box touches as it moves along a ray.
 // Params:
-//   rectangle = The bounding rectangle for an object.
-//   side = The side that needs to be tested for collision.
+//   center = Where the center of the box starts, in world space.
+//   extents = The half-width and half-height of the box, in world units.
+//   direction = Which way the box moves. Doesn't need to be normalized.
+//   maxDistance = How far the box moves, in world units.
+//   hit = Information about the first tile hit, only valid if this returns true.
 // Returns:
-//   True if there is a collision, false otherwise.
-bool ColliderTilemap::IsSideColliding(const BoundingRectangle& rectangle, RectangleSide side) const
+//   True if the box hit a solid tile, false otherwise.
+bool ColliderTilemap::BoxCast(const Vector2D& center, const Vector2D& extents, const Vector2D& direction, float maxDistance, TilemapRaycastHit& hit) const
 {
-	// % away from the center of the edge that the hotspot is at.
-	static const float pointScale = 0.6f;
-	// The number of units the collider's size is decreased by.
-	static const float shrinkAmount = 0.01f;
-	// The number of hotspots.
-	static const unsigned hotspotsCount = 2;
+	return BoxCast(*map, transform->GetInverseMatrix(), transform->GetScale(), center, extents, direction, maxDistance, hit);
+}
 
-	Vector2D hotspots[hotspotsCount];
+// Same as the member version, but for callers that keep their own copy of the map's
+// placement instead of reading it from a live transform (e.g. collision query snapshots).
+// Params:
+//   map = The tilemap to cast against.
+//   inverse = The inverse of the map's world matrix.
+//   scale = The map's world scale (the size of one tile).
+//   center = Where the center of the box starts, in world space.
+//   extents = The half-width and half-height of the box, in world units.
+//   direction = Which way the box moves. Doesn't need to be normalized.
+//   maxDistance = How far the box moves, in world units.
+//   hit = Information about the first tile hit, only valid if this returns true.
+// Returns:
+//   True if the box hit a solid tile, false otherwise.
+bool ColliderTilemap::BoxCast(const Tilemap& map, const CS230::Matrix2D& inverse, const Vector2D& scale, const Vector2D& center,
+	const Vector2D& extents, const Vector2D& direction, float maxDistance, TilemapRaycastHit& hit)
+{
+	float length = direction.Magnitude();
+	Vector2D movement = length > 0.0f ? direction * (maxDistance / length) : Vector2D();
+
+	// Convert the cast into grid space (rows grow downward).
+	Vector2D gridExtents(extents.x / fabsf(scale.x), extents.y / fabsf(scale.y));
+	Vector2D start = inverse * center;
+	Vector2D end = inverse * (center + movement);
+	Vector2D gridStart(start.x + 0.5f, -start.y + 0.5f);
+	Vector2D gridMovement(end.x - start.x, start.y - end.y);
+
+	float time;
+	if (!CastGrid(map, gridStart, gridExtents, gridMovement, time, hit.column, hit.row, hit.normal))
+		return false;
 
-	// Calculate hotpoint positions.
-	switch (side)
-	{
-	case RectangleSide::SideBottom:
-		hotspots[0] = Vector2D(rectangle.center.x - rectangle.extents.x * pointScale, rectangle.bottom + shrinkAmount);
-		hotspots[1] = Vector2D(rectangle.center.x + rectangle.extents.x * pointScale, rectangle.bottom + shrinkAmount);
-		break;
-	case RectangleSide::SideTop:
-		hotspots[0] = Vector2D(rectangle.center.x - rectangle.extents.x * pointScale, rectangle.top - shrinkAmount);
-		hotspots[1] = Vector2D(rectangle.center.x + rectangle.extents.x * pointScale, rectangle.top - shrinkAmount);
-		break;
-	case RectangleSide::SideLeft:
-		hotspots[0] = Vector2D(rectangle.left + shrinkAmount, rectangle.center.y - rectangle.extents.y * pointScale);
-		hotspots[1] = Vector2D(rectangle.left + shrinkAmount, rectangle.center.y + rectangle.extents.y * pointScale);
-		break;
-	case RectangleSide::SideRight:
-		hotspots[0] = Vector2D(rectangle.right - shrinkAmount, rectangle.center.y - rectangle.extents.y * pointScale);
-		hotspots[1] = Vector2D(rectangle.right - shrinkAmount, rectangle.center.y + rectangle.extents.y * pointScale);
-		break;
-	}
+	hit.distance = time * maxDistance;
+	hit.position = center + movement * time;
+	return true;
+}
 
-	// Check if the hotspots are colliding.
-	for (unsigned i = 0; i < hotspotsCount; i++)
+// Checks many line segments against the map at once, e.g. for AI line of sight.
+// Params:
+//   starts = The start point of each segment, in world space.
+//   ends = The end point of each segment, in world space.
+//   count = How many segments there are.
+//   blocked = Output array, set to whether each segment hit a solid tile.
+//   hits = Optional output array of hit information, only valid where blocked is true.
+// Returns:
+//   How many segments were blocked.
+size_t ColliderTilemap::RaycastBatch(const Vector2D* starts, const Vector2D* ends, size_t count, bool* blocked, TilemapRaycastHit* hits) const
+{
+	// Only look up the matrix once for the whole batch.
+	const CS230::Matrix2D& inverse = transform->GetInverseMatrix();
+	const Vector2D extents;
+
+	size_t blockedCount = 0;
+	for (size_t i = 0; i < count; ++i)
 	{
-		if (IsCollidingAtPosition(hotspots[i].x, hotspots[i].y))
-			return true;
+		Vector2D start = inverse * starts[i];
+		Vector2D end = inverse * ends[i];
+		Vector2D gridStart(start.x + 0.5f, -start.y + 0.5f);
+		Vector2D gridMovement(end.x - start.x, start.y - end.y);
+
+		float time;
+		int column;
+		int row;
+		Vector2D normal;
+		blocked[i] = CastGrid(*map, gridStart, extents, gridMovement, time, column, row, normal);
+		if (!blocked[i])
+			continue;
+
+		++blockedCount;
+		if (hits != nullptr)
+		{
+			hits[i].distance = time * starts[i].Distance(ends[i]);
+			hits[i].position = starts[i] + (ends[i] - starts[i]) * time;
+			hits[i].normal = normal;
+			hits[i].column = column;
+			hits[i].row = row;
+		}
 	}
 
-	return false;
+	return blockedCount;
 }
 
-// Determines whether a point is within a collidable cell in the tilemap.
+// Determines whether a cell in a tilemap is solid.
 // Params:
-//   x = The x component of the point, in world coordinates.
-//   y = The y component of the point, in world coordinates.
+//   map = The tilemap to check.
+//   column = The column of the cell.
+//   row = The row of the cell.
 // Returns:
-//   -1 if the point is outside the map, 0 if the map is empty at that position, 
-//   or a positive integer if there is a tile at that position.
-bool ColliderTilemap::IsCollidingAtPosition(float x, float y) const
+//   False if the cell is outside the map or empty, true if there is a tile there.
+bool ColliderTilemap::IsCellSolid(const Tilemap& map, int column, int row)
 {
-	// Convert the point from world space to tile space.
-	Vector2D tileSpaceCoordinate = transform->GetInverseMatrix() * Vector2D(x, y);
-	unsigned col = static_cast<unsigned>(floor(tileSpaceCoordinate.x + 0.5f));
-	unsigned row = static_cast<unsigned>(floor(-tileSpaceCoordinate.y + 0.5f));
+	if (column < 0 || row < 0)
+		return false;
 
-	// Check if the tile is solid.
-	return map->GetCellValue(col, row) > 0;
+	return map.GetCellValue(static_cast<unsigned>(column), static_cast<unsigned>(row)) > 0;
 }
 
-// Moves an object and sets its velocity based on where it collided with the tilemap.
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Moves a box through the grid along a straight line, finding the first solid cell it
+// touches. Steps from one cell boundary to the next (Amanatides-Woo), checking only the
+// cells the box's leading edges enter. A ray is a box with no size.
 // Params:
-//   objectRectangle = A bounding rectangle that encompasses the object.
-//   objectTransform = Pointer to the object's transform component.
-//   objectPhysics = Pointer to the object's physics component.
-//   collisions = True/false values from map collision checks.
-void ColliderTilemap::ResolveCollisions(const BoundingRectangle& objectRectangle, Transform* objectTransform,
-	Physics* objectPhysics, const MapCollision& collisions) const
+//   map = The tilemap to walk through.
+//   start = The center of the box in grid space.
+//   extents = The half-size of the box in grid space.
+//   movement = How far the box moves, in grid space.
+//   time = How far along the movement (0 to 1) the box first touched a solid cell.
+//   column = The column of the cell that was hit.
+//   row = The row of the cell that was hit.
+//   normal = The world space face normal of the cell that was hit.
+// Returns:
+//   True if a solid cell was touched, false otherwise.
+bool ColliderTilemap::CastGrid(const Tilemap& map, const Vector2D& start, const Vector2D& extents, const Vector2D& movement, float& time, int& column, int& row, Vector2D& normal)
 {
-	// Get the translation and velocity from the object and store them in variables.
-	Vector2D translation = objectTransform->GetTranslation();
-	Vector2D velocity = objectPhysics->GetVelocity();
-
-	// We need to determine how much to move the object.
-	float nudgeAmount;
-
-	// We will do this by finding the center of the next tile, 
-	// then finding the distance from the corresponding side to that position.
-	float nextTileCenter;
+	// Rays still need a sliver of size to cover a cell.
+	const float extentX = max(extents.x, cellSkin);
+	const float extentY = max(extents.y, cellSkin);
+
+	// Clip the movement to the map so rays that leave it don't keep stepping through empty space.
+	const float width = static_cast<float>(map.GetWidth());
+	const float height = static_cast<float>(map.GetHeight());
+	float endTime = min(GetExitTime(start.x, movement.x, -extentX, width + extentX),
+		GetExitTime(start.y, movement.y, -extentY, height + extentY));
+	endTime = min(endTime, 1.0f);
+
+	if (endTime < 0.0f)
+		return false;
 
-	if (collisions.bottom || collisions.top)
+	// Check the cells the box starts in.
+	const Vector2D startDirection = Vector2D(movement.x, -movement.y);
+	for (int x = GetCell(start.x - extentX + cellSkin); x <= GetCell(start.x + extentX - cellSkin); ++x)
 	{
-		if (collisions.bottom)
+		for (int y = GetCell(start.y - extentY + cellSkin); y <= GetCell(start.y + extentY - cellSkin); ++y)
 		{
-			// Find tile above the object's bottom side.
-			nextTileCenter = GetNextTileCenter(SideBottom, objectRectangle.bottom);
+			if (IsCellSolid(map, x, y))
+			{
+				time = 0.0f;
+				column = x;
+				row = y;
+				normal = startDirection.MagnitudeSquared() > 0.0f ? -startDirection.Normalized() : Vector2D();
+				return true;
+			}
+		}
+	}
 
-			// Find distance to next tile center.
-			nudgeAmount = nextTileCenter - objectRectangle.bottom;
+	// Track the cell each leading edge is in, and when it will cross into the next one.
+	const int stepX = movement.x > 0.0f ? 1 : -1;
+	const int stepY = movement.y > 0.0f ? 1 : -1;
+	const float leadX = start.x + stepX * extentX;
+	const float leadY = start.y + stepY * extentY;
+	int cellX = GetCell(leadX - stepX * cellSkin);
+	int cellY = GetCell(leadY - stepY * cellSkin);
+	float nextX = movement.x != 0.0f ? (static_cast<float>(stepX > 0 ? cellX + 1 : cellX) - leadX) / movement.x : FLT_MAX;
+	float nextY = movement.y != 0.0f ? (static_cast<float>(stepY > 0 ? cellY + 1 : cellY) - leadY) / movement.y : FLT_MAX;
+	const float deltaX = movement.x != 0.0f ? 1.0f / fabsf(movement.x) : FLT_MAX;
+	const float deltaY = movement.y != 0.0f ? 1.0f / fabsf(movement.y) : FLT_MAX;
+
+	for (;;)
+	{
+		if (nextX < nextY)
+		{
+			if (nextX > endTime)
+				return false;
+
+			// The leading vertical edge enters a new column; check the rows the box covers there.
+			// The leading row is taken from the walk itself, so corners crossed exactly aren't skipped.
+			cellX += stepX;
+			float y = start.y + movement.y * nextX;
+			int firstRow = stepY > 0 ? GetCell(y - extentY + cellSkin) : cellY;
+			int lastRow = stepY > 0 ? cellY : GetCell(y + extentY - cellSkin);
+			for (int cross = firstRow; cross <= lastRow; ++cross)
+			{
+				if (IsCellSolid(map, cellX, cross))
+				{
+					time = nextX;
+					column = cellX;
+					row = cross;
+					normal = Vector2D(static_cast<float>(-stepX), 0.0f);
+					return true;
+				}
+			}
+
+			nextX += deltaX;
 		}
 		else
 		{
-			// Find tile below object's top side.
-			nextTileCenter = GetNextTileCenter(SideTop, objectRectangle.top);
-
-			// Find distance to next tile center.
-			nudgeAmount = nextTileCenter - objectRectangle.top;
+			if (nextY > endTime)
+				return false;
+
+			// The leading horizontal edge enters a new row; check the columns the box covers there.
+			cellY += stepY;
+			float x = start.x + movement.x * nextY;
+			int firstColumn = stepX > 0 ? GetCell(x - extentX + cellSkin) : cellX;
+			int lastColumn = stepX > 0 ? cellX : GetCell(x + extentX - cellSkin);
+			for (int cross = firstColumn; cross <= lastColumn; ++cross)
+			{
+				if (IsCellSolid(map, cross, cellY))
+				{
+					time = nextY;
+					column = cross;
+					row = cellY;
+
+					// Grid rows grow downward, so the world normal's y is flipped.
+					normal = Vector2D(0.0f, static_cast<float>(stepY));
+					return true;
+				}
+			}
+
+			nextY += deltaY;
 		}
+	}
+}
+
+// Moves a box along one axis through the grid, stopping it at the first solid cell
+// in its way. Only the cells the leading edge crosses are visited.
+// Params:
+//   position = The center of the box in grid space.
+//   extents = The half-size of the box in grid space.
+//   distance = How far the box moves along the axis.
+//   axis = 0 for the x-axis (columns), 1 for the y-axis (rows).
+//   sides = Updated with the side of the box that hit a cell, if any.
+// Returns:
+//   The box's new position along the axis.
+float ColliderTilemap::SweepAxis(const Vector2D& position, const Vector2D& extents, float distance, unsigned axis, MapCollision& sides) const
+{
+	const float center = axis == 0 ? position.x : position.y;
+	const float extent = axis == 0 ? extents.x : extents.y;
+	const float crossCenter = axis == 0 ? position.y : position.x;
+	const float crossExtent = axis == 0 ? extents.y : extents.x;
 
-		// Nudge object up/down
-		translation.y += nudgeAmount;
+	if (distance == 0.0f)
+		return center;
 
-		// Stop velocity in y direction
-		velocity.y = 0;
-	}
+	// The cells the box covers on the other axis don't change during the sweep.
+	const int firstCross = GetCell(crossCenter - crossExtent + cellSkin);
+	const int lastCross = GetCell(crossCenter + crossExtent - cellSkin);
 
-	if (collisions.left || collisions.right)
+	// Step the leading edge from the cell it starts in to the cell it ends in.
+	const int step = distance > 0.0f ? 1 : -1;
+	const float leadingOffset = step * (extent - cellSkin);
+	const int firstCell = GetCell(center + leadingOffset);
+	const int lastCell = GetCell(center + distance + leadingOffset);
+
+	for (int cell = firstCell + step; step > 0 ? cell <= lastCell : cell >= lastCell; cell += step)
 	{
-		if (collisions.left)
+		for (int cross = firstCross; cross <= lastCross; ++cross)
 		{
-			// Find tile to the right the object's left side.
-			nextTileCenter = GetNextTileCenter(SideLeft, objectRectangle.left);
-
-			// Find distance to next tile center.
-			nudgeAmount = nextTileCenter - objectRectangle.left;
+			if (!IsCellSolid(axis == 0 ? cell : cross, axis == 0 ? cross : cell))
+				continue;
+
+			// Grid columns grow to the right, but grid rows grow downward.
+			if (axis == 0)
+			{
+				if (step > 0)
+					sides.right = true;
+				else
+					sides.left = true;
+			}
+			else
+			{
+				if (step > 0)
+					sides.bottom = true;
+				else
+					sides.top = true;
+			}
+
+			// Rest the leading edge against the near side of the solid cell.
+			if (step > 0)
+				return static_cast<float>(cell) - extent;
+			else
+				return static_cast<float>(cell + 1) + extent;
 		}
-		else
-		{
-			// Find tile to the left the object's right side.
-			nextTileCenter = GetNextTileCenter(SideRight, objectRectangle.right);
+	}
 
-			// Find distance to next tile center.
-			nudgeAmount = nextTileCenter - objectRectangle.right;
-		}
+	return center + distance;
+}
 
-		// Nudge object left/right.
-		translation.x += nudgeAmount;
+// Checks which sides of a box overlap solid cells, without moving it.
+// Params:
+//   position = The center of the box in grid space.
+//   extents = The half-size of the box in grid space.
+//   sides = Updated with the sides of the box facing each solid cell it overlaps.
+// Returns:
+//   True if the box overlaps any solid cell, false otherwise.
+bool ColliderTilemap::FindOverlapSides(const Vector2D& position, const Vector2D& extents, MapCollision& sides) const
+{
+	bool overlapping = false;
 
-		// Stop velocity in x direction.
-		velocity.x = 0;
+	for (int column = GetCell(position.x - extents.x + cellSkin); column <= GetCell(position.x + extents.x - cellSkin); ++column)
+	{
+		for (int row = GetCell(position.y - extents.y + cellSkin); row <= GetCell(position.y + extents.y - cellSkin); ++row)
+		{
+			if (!IsCellSolid(column, row))
+				continue;
+
+			overlapping = true;
+
+			// Use the direction to the cell's center to pick a side (rows grow downward).
+			float x = static_cast<float>(column) + 0.5f - position.x;
+			float y = static_cast<float>(row) + 0.5f - position.y;
+			if (fabsf(x) > fabsf(y))
+			{
+				if (x > 0.0f)
+					sides.right = true;
+				else
+					sides.left = true;
+			}
+			else
+			{
+				if (y > 0.0f)
+					sides.bottom = true;
+				else
+					sides.top = true;
+			}
+		}
 	}
 
-	// Modify object's actual translation and velocity.
-	objectTransform->SetTranslation(translation);
-	objectPhysics->SetVelocity(velocity);
+	return overlapping;
 }
 
-// Returns the center of the next tile on the x-axis or y-axis.
-// Used for assisting in collision resolution on a particular side.
+// Moves a box out of the solid cells it overlaps, along whichever direction needs
+// the shortest move. Sweeps can't see cells a box is already inside, so this runs first.
 // Params:
-//   side = Which side the collision is occurring on.
-//   sidePosition = The x or y value of that side.
+//   position = The center of the box in grid space.
+//   extents = The half-size of the box in grid space.
+//   sides = Updated with the side of the box the cells were pushed away from, if any.
 // Returns:
-//   The center of the next tile for the given position on the given side.
-float ColliderTilemap::GetNextTileCenter(RectangleSide side, float sidePosition) const
+//   The box's new position.
+Vector2D ColliderTilemap::PushOutOfCells(const Vector2D& position, const Vector2D& extents, MapCollision& sides) const
 {
-	// Create a world space point
-	Vector2D point;
+	// How far the box has to move left, right, up, and down (in grid space) to clear every cell.
+	float pushLeft = 0.0f;
+	float pushRight = 0.0f;
+	float pushUp = 0.0f;
+	float pushDown = 0.0f;
+	bool overlapping = false;
+
+	for (int column = GetCell(position.x - extents.x + cellSkin); column <= GetCell(position.x + extents.x - cellSkin); ++column)
+	{
+		for (int row = GetCell(position.y - extents.y + cellSkin); row <= GetCell(position.y + extents.y - cellSkin); ++row)
+		{
+			if (!IsCellSolid(column, row))
+				continue;
+
+			overlapping = true;
+			pushLeft = max(pushLeft, position.x + extents.x - static_cast<float>(column));
+			pushRight = max(pushRight, static_cast<float>(column + 1) - (position.x - extents.x));
+			pushUp = max(pushUp, position.y + extents.y - static_cast<float>(row));
+			pushDown = max(pushDown, static_cast<float>(row + 1) - (position.y - extents.y));
+		}
+	}
 
-	// Create a reference variable to store the result
-	float* result = &point.x;
+	if (!overlapping)
+		return position;
 
-	if (side == RectangleSide::SideBottom || side == RectangleSide::SideTop)
+	// Grid rows grow downward, so moving up means moving toward lower rows.
+	float shortest = min(min(pushLeft, pushRight), min(pushUp, pushDown));
+	if (shortest == pushLeft)
 	{
-		// Use the given position for the y-axis
-		// Since we only care about one axis, the other will be 0
-		point.y = sidePosition;
-
-		// Remember which part we want to modify
-		result = &point.y;
+		sides.right = true;
+		return Vector2D(position.x - pushLeft, position.y);
 	}
-	else
+	if (shortest == pushRight)
 	{
-		// Use the given position for the x-axis
-		// Since we only care about one axis, the other will be 0
-		point.x = sidePosition;
+		sides.left = true;
+		return Vector2D(position.x + pushRight, position.y);
+	}
+	if (shortest == pushUp)
+	{
+		sides.bottom = true;
+		return Vector2D(position.x, position.y - pushUp);
 	}
 
-	// Transform the world space point into tile space
-	point = transform->GetInverseMatrix() * point;
-
-	// Flip the y-axis
-	point.y = -point.y;
-
-	// Move completely into cell
-	point += Vector2D(0.5, 0.5);
-
-	// Find the next tile index (higher or lower depending on the side)
-	if (side == RectangleSide::SideLeft || side == RectangleSide::SideTop)
-		*result = ceil(*result);
-	else
-		*result = floor(*result);
-
-	// Re-adjust object position
-	point -= Vector2D(0.5, 0.5);
+	sides.top = true;
+	return Vector2D(position.x, position.y + pushDown);
+}
 
-	// Flip the y-axis
-	point.y = -point.y;
+// Determines whether a cell in the tilemap is solid.
+// Params:
+//   column = The column of the cell.
+//   row = The row of the cell.
+// Returns:
+//   False if the cell is outside the map or empty, true if there is a tile there.
+bool ColliderTilemap::IsCellSolid(int column, int row) const
+{
+	return IsCellSolid(*map, column, row);
+}
 
-	// Transform point back into world space
-	point = transform->GetMatrix() * point;
+// Converts a world space position into grid space, where cell (column, row)
+// covers [column, column + 1) x [row, row + 1) and rows grow downward.
+// Params:
+//   position = The world space position.
+// Returns:
+//   The position in grid space.
+Vector2D ColliderTilemap::WorldToGrid(const Vector2D& position) const
+{
+	Vector2D tileSpace = transform->GetInverseMatrix() * position;
+	return Vector2D(tileSpace.x + 0.5f, -tileSpace.y + 0.5f);
+}
 
-	return *result;
+// Converts a grid space position back into world space.
+// Params:
+//   position = The grid space position.
+// Returns:
+//   The position in world space.
+Vector2D ColliderTilemap::GridToWorld(const Vector2D& position) const
+{
+	return transform->GetMatrix() * Vector2D(position.x - 0.5f, -(position.y - 0.5f));
 }
 
 //------------------------------------------------------------------------------
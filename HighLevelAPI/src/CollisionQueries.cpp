@@ -0,0 +1,735 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	CollisionQueries.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "CollisionQueries.h"
+
+// Systems
+#include "GameObject.h"
+#include "Tilemap.h"
+#include "Intersection2D.h"
+
+// Components
+#include "Transform.h"
+#include "Collider.h"
+#include "ColliderTilemap.h"
+#include "ColliderLine.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Finds when a line segment enters a box.
+	// Params:
+	//   start = The start of the segment.
+	//   movement = The end of the segment minus the start.
+	//   boundsMin = Bottom left of the box.
+	//   boundsMax = Top right of the box.
+	//   time = How far along the segment (0 to 1) it enters the box, 0 if it starts inside.
+	// Returns:
+	//   True if the segment touches the box, false otherwise.
+	bool GetSegmentBoxEntry(const Vector2D& start, const Vector2D& movement, const Vector2D& boundsMin, const Vector2D& boundsMax, float& time)
+	{
+		float enter = 0.0f;
+		float leave = 1.0f;
+
+		const float starts[2] = { start.x, start.y };
+		const float movements[2] = { movement.x, movement.y };
+		const float mins[2] = { boundsMin.x, boundsMin.y };
+		const float maxes[2] = { boundsMax.x, boundsMax.y };
+
+		// Clip the segment against each pair of sides (slab test).
+		for (unsigned axis = 0; axis < 2; ++axis)
+		{
+			if (movements[axis] == 0.0f)
+			{
+				if (starts[axis] < mins[axis] || starts[axis] > maxes[axis])
+					return false;
+				continue;
+			}
+
+			float inverse = 1.0f / movements[axis];
+			float axisEnter = (mins[axis] - starts[axis]) * inverse;
+			float axisLeave = (maxes[axis] - starts[axis]) * inverse;
+			if (axisEnter > axisLeave)
+				std::swap(axisEnter, axisLeave);
+
+			enter = max(enter, axisEnter);
+			leave = min(leave, axisLeave);
+			if (enter > leave)
+				return false;
+		}
+
+		time = enter;
+		return true;
+	}
+
+	// Finds when a line segment first touches a rounded convex polygon, which is the polygon's
+	// core grown by a radius: its edges pushed out by the radius, joined by circles at its vertices.
+	// Params:
+	//   vertices = The core's vertices, in order around the polygon (either way).
+	//   count = How many vertices there are. 1 is a circle, 2 is a capsule (or a bare segment with no radius).
+	//   radius = How much the core is rounded by.
+	//   start = The start of the segment.
+	//   movement = The end of the segment minus the start.
+	//   enter = How far along the segment (0 to 1) it enters the polygon's bounds.
+	//   time = How far along the segment (0 to 1) it first touches the polygon.
+	//   normal = The polygon's surface normal where the segment touches it.
+	// Returns:
+	//   True if the segment touches the polygon, false otherwise.
+	bool GetSegmentPolygonEntry(const Vector2D* vertices, unsigned count, float radius, const Vector2D& start,
+		const Vector2D& movement, float enter, float& time, Vector2D& normal)
+	{
+		// A bare segment has no inside for the clipping below to find, so cross it directly.
+		if (count == 2 && radius <= 0.0f)
+		{
+			const Vector2D edge = vertices[1] - vertices[0];
+			const float denominator = movement.x * edge.y - movement.y * edge.x;
+			if (denominator == 0.0f)
+				return false;
+
+			const Vector2D offset = vertices[0] - start;
+			const float segmentTime = (offset.x * edge.y - offset.y * edge.x) / denominator;
+			const float along = (offset.x * movement.y - offset.y * movement.x) / denominator;
+			if (segmentTime < 0.0f || segmentTime > 1.0f || along < 0.0f || along > 1.0f)
+				return false;
+
+			// Face back toward the start of the movement.
+			time = segmentTime;
+			normal = Vector2D(edge.y, -edge.x).Normalized();
+			if (normal.DotProduct(movement) > 0.0f)
+				normal = -normal;
+			return true;
+		}
+
+		// Work out which way the edge normals have to point to face out of the polygon.
+		float area = 0.0f;
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const Vector2D& a = vertices[i];
+			const Vector2D& b = vertices[(i + 1) % count];
+			area += a.x * b.y - b.x * a.y;
+		}
+		const float outward = area < 0.0f ? -1.0f : 1.0f;
+
+		// A capsule's one edge has a side facing each way, and a circle has no edges at all.
+		const unsigned edgeCount = count >= 2 ? count : 0;
+		const Vector2D backward = -movement.Normalized();
+
+		// Clip the segment against the half-plane behind each edge, pushed out by the radius.
+		// This shape has sharp corners instead of round ones, so the segment can't touch the
+		// rounded polygon without getting inside it first.
+		float leave = 1.0f;
+		unsigned entryEdge = edgeCount;
+		Vector2D entryNormal;
+		time = enter;
+		for (unsigned i = 0; i < edgeCount; ++i)
+		{
+			const Vector2D& a = vertices[i];
+			Vector2D edge = vertices[(i + 1) % count] - a;
+			if (edge.MagnitudeSquared() == 0.0f)
+				continue;
+
+			Vector2D edgeNormal = Vector2D(edge.y, -edge.x).Normalized() * outward;
+			float distance = edgeNormal.DotProduct(start - a) - radius;
+			float speed = edgeNormal.DotProduct(movement);
+			if (speed == 0.0f)
+			{
+				if (distance > 0.0f)
+					return false;
+				continue;
+			}
+
+			float edgeTime = -distance / speed;
+			if (speed < 0.0f)
+			{
+				if (edgeTime > time)
+				{
+					time = edgeTime;
+					entryEdge = i;
+					entryNormal = edgeNormal;
+				}
+			}
+			else
+				leave = min(leave, edgeTime);
+
+			if (time > leave)
+				return false;
+		}
+
+		// Without rounding, the clipped shape is the polygon itself.
+		if (radius <= 0.0f && count >= 3)
+		{
+			normal = entryEdge < edgeCount ? entryNormal : backward;
+			return true;
+		}
+
+		// The segment hits a flat side if it crosses a pushed out edge next to the edge itself.
+		const Vector2D point = start + movement * time;
+		if (entryEdge < edgeCount)
+		{
+			const Vector2D& a = vertices[entryEdge];
+			Vector2D edge = vertices[(entryEdge + 1) % count] - a;
+			float along = edge.DotProduct(point - a);
+			if (along >= 0.0f && along <= edge.MagnitudeSquared())
+			{
+				normal = entryNormal;
+				return true;
+			}
+		}
+		else
+		{
+			// The segment starts inside every pushed out edge, so it starts inside the rounded
+			// polygon unless it is in one of the corners that were cut off.
+			bool inside = count >= 3;
+			for (unsigned i = 0; i < edgeCount; ++i)
+			{
+				const Vector2D& a = vertices[i];
+				Vector2D edge = vertices[(i + 1) % count] - a;
+				if (edge.MagnitudeSquared() == 0.0f)
+					continue;
+
+				float distance = Vector2D(edge.y, -edge.x).Normalized().DotProduct(point - a) * outward;
+				float along = edge.DotProduct(point - a);
+				if (distance > 0.0f)
+					inside = false;
+				if (distance >= 0.0f && along >= 0.0f && along <= edge.MagnitudeSquared())
+				{
+					inside = true;
+					break;
+				}
+			}
+
+			if (inside)
+			{
+				normal = backward;
+				return true;
+			}
+		}
+
+		if (radius <= 0.0f)
+			return false;
+
+		// Otherwise, the segment is in a cut off corner, and can only touch a vertex's circle.
+		const float a = movement.MagnitudeSquared();
+		float closest = FLT_MAX;
+		for (unsigned i = 0; i < count; ++i)
+		{
+			Vector2D offset = start - vertices[i];
+			float b = offset.DotProduct(movement);
+			float c = offset.MagnitudeSquared() - radius * radius;
+			float discriminant = b * b - a * c;
+			if (discriminant < 0.0f)
+				continue;
+
+			float root = sqrtf(discriminant);
+			float circleEnter = (-b - root) / a;
+			float circleLeave = (-b + root) / a;
+			if (circleLeave < time || circleEnter > leave)
+				continue;
+
+			float circleTime = max(circleEnter, time);
+			if (circleTime < closest)
+			{
+				closest = circleTime;
+				normal = circleEnter < time ? backward : (start + movement * circleTime - vertices[i]) / radius;
+			}
+		}
+
+		if (closest == FLT_MAX)
+			return false;
+
+		time = closest;
+		return true;
+	}
+
+	// Checks whether two boxes overlap.
+	bool BoundsOverlap(const Vector2D& min1, const Vector2D& max1, const Vector2D& min2, const Vector2D& max2)
+	{
+		return min1.x <= max2.x && max1.x >= min2.x && min1.y <= max2.y && max1.y >= min2.y;
+	}
+
+	// Gets the closest point on a rounded shape's surface, given the closest points between
+	// the query and the shape's core.
+	// Params:
+	//   queryPoint = The closest point on the query.
+	//   corePoint = The closest point on the shape's core.
+	//   distance = The distance between the two points.
+	//   radius = How much the shape's core is rounded by.
+	Vector2D GetSurfacePoint(const Vector2D& queryPoint, const Vector2D& corePoint, float distance, float radius)
+	{
+		// The query is inside the rounded part, so it is its own closest point.
+		if (distance <= radius)
+			return queryPoint;
+
+		return corePoint + (queryPoint - corePoint) * (radius / distance);
+	}
+}
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Creates an empty hit.
+QueryHit::QueryHit() : object(nullptr), distance(0.0f)
+{
+}
+
+// Creates a raycast query.
+// Params:
+//   start = Where the ray starts.
+//   direction = Which way the ray goes. Doesn't need to be normalized.
+//   maxDistance = How far the ray goes.
+//   layerMask = Which collider layers the ray can hit.
+RaycastQuery::RaycastQuery(const Vector2D& start, const Vector2D& direction, float maxDistance, unsigned layerMask)
+	: start(start), direction(direction), maxDistance(maxDistance), layerMask(layerMask)
+{
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Creates an empty snapshot.
+CollisionQueries::CollisionQueries()
+{
+}
+
+// Takes a new snapshot of the colliders on a list of objects. Destroyed objects and
+// objects without colliders are skipped. Each segment of a line collider is its own entry.
+// Params:
+//   objects = The objects to take the snapshot of.
+void CollisionQueries::Rebuild(const std::vector<GameObject*>& objects)
+{
+	Clear();
+
+	for (auto it = objects.begin(); it != objects.end(); ++it)
+	{
+		GameObject* object = *it;
+		if (object->IsDestroyed())
+			continue;
+
+		Collider* collider = object->GetComponent<Collider>();
+		if (collider == nullptr)
+			continue;
+
+		Entry entry;
+		entry.object = object;
+		entry.map = nullptr;
+		entry.layers = collider->GetLayers();
+		entry.firstVertex = static_cast<unsigned>(vertices.size());
+		entry.vertexCount = 0;
+		entry.radius = 0.0f;
+
+		if (collider->GetType() == ColliderTypeLines)
+		{
+			// Segments aren't one convex shape, so each gets a two-vertex entry of its own.
+			const ColliderLine& lines = *static_cast<const ColliderLine*>(collider);
+			for (unsigned i = 0; i < lines.GetLineCount(); ++i)
+			{
+				const LineSegment& segment = lines.GetLineWithTransform(i);
+				entry.firstVertex = static_cast<unsigned>(vertices.size());
+				entry.vertexCount = 2;
+				entry.boundsMin = Vector2D(min(segment.start.x, segment.end.x), min(segment.start.y, segment.end.y));
+				entry.boundsMax = Vector2D(max(segment.start.x, segment.end.x), max(segment.start.y, segment.end.y));
+				vertices.push_back(segment.start);
+				vertices.push_back(segment.end);
+				entries.push_back(entry);
+			}
+
+			continue;
+		}
+
+		if (collider->GetType() == ColliderTypeTilemap)
+		{
+			const Tilemap* map = static_cast<const ColliderTilemap*>(collider)->GetTilemap();
+			if (map == nullptr)
+				continue;
+
+			// Copy where the map is, so queries never have to read its transform.
+			entry.map = map;
+			entry.matrix = collider->transform->GetMatrix();
+			entry.inverse = collider->transform->GetInverseMatrix();
+			entry.scale = collider->transform->GetScale();
+
+			// Tiles are centered on their column and (flipped) row in tile space.
+			float right = static_cast<float>(map->GetWidth()) - 0.5f;
+			float bottom = 0.5f - static_cast<float>(map->GetHeight());
+			Vector2D corners[4] = { Vector2D(-0.5f, 0.5f), Vector2D(right, 0.5f), Vector2D(right, bottom), Vector2D(-0.5f, bottom) };
+			ApplyTransformToPoints(entry.matrix, corners, 4);
+
+			entry.boundsMin = Vector2D(FLT_MAX, FLT_MAX);
+			entry.boundsMax = Vector2D(-FLT_MAX, -FLT_MAX);
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				entry.boundsMin = Vector2D(min(entry.boundsMin.x, corners[i].x), min(entry.boundsMin.y, corners[i].y));
+				entry.boundsMax = Vector2D(max(entry.boundsMax.x, corners[i].x), max(entry.boundsMax.y, corners[i].y));
+			}
+		}
+		else
+		{
+			SupportShape shape;
+			if (!collider->GetSupportShape(shape) || shape.GetVertexCount() == 0)
+				continue;
+
+			// Copy the core so the snapshot doesn't depend on the collider's own caches.
+			entry.vertexCount = shape.GetVertexCount();
+			entry.radius = shape.GetRadius();
+			entry.boundsMin = Vector2D(FLT_MAX, FLT_MAX);
+			entry.boundsMax = Vector2D(-FLT_MAX, -FLT_MAX);
+			for (unsigned i = 0; i < entry.vertexCount; ++i)
+			{
+				const Vector2D& vertex = shape.GetVertex(i);
+				vertices.push_back(vertex);
+				entry.boundsMin = Vector2D(min(entry.boundsMin.x, vertex.x), min(entry.boundsMin.y, vertex.y));
+				entry.boundsMax = Vector2D(max(entry.boundsMax.x, vertex.x), max(entry.boundsMax.y, vertex.y));
+			}
+
+			entry.boundsMin -= Vector2D(entry.radius, entry.radius);
+			entry.boundsMax += Vector2D(entry.radius, entry.radius);
+		}
+
+		entries.push_back(entry);
+	}
+}
+
+// Empties the snapshot, e.g. before the objects in it are deleted.
+void CollisionQueries::Clear()
+{
+	entries.clear();
+	vertices.clear();
+}
+
+// Gets how many colliders are in the snapshot.
+size_t CollisionQueries::GetColliderCount() const
+{
+	return entries.size();
+}
+
+// Finds the first collider along a ray.
+// Params:
+//   start = Where the ray starts.
+//   direction = Which way the ray goes. Doesn't need to be normalized.
+//   maxDistance = How far the ray goes.
+//   hit = Information about the closest hit, only valid if this returns true.
+//   layerMask = Which collider layers the ray can hit.
+// Returns:
+//   True if the ray hit something, false otherwise.
+bool CollisionQueries::Raycast(const Vector2D& start, const Vector2D& direction, float maxDistance, QueryHit& hit, unsigned layerMask) const
+{
+	float length = direction.Magnitude();
+	if (length <= 0.0f || maxDistance <= 0.0f)
+		return false;
+
+	const Vector2D unitDirection = direction / length;
+
+	// Anything farther than the closest hit so far can be skipped.
+	float closest = maxDistance;
+	bool found = false;
+
+	for (auto it = entries.begin(); it != entries.end(); ++it)
+	{
+		const Entry& entry = *it;
+		if ((entry.layers & layerMask) == 0)
+			continue;
+
+		// Skip colliders whose bounds the ray doesn't reach before the closest hit.
+		float enter;
+		if (!GetSegmentBoxEntry(start, unitDirection * closest, entry.boundsMin, entry.boundsMax, enter))
+			continue;
+
+		if (entry.map != nullptr)
+		{
+			// A ray is a box with no size.
+			TilemapRaycastHit tileHit;
+			if (ColliderTilemap::BoxCast(*entry.map, entry.inverse, entry.scale, start, Vector2D(), unitDirection, closest, tileHit))
+			{
+				closest = tileHit.distance;
+				hit.object = entry.object;
+				hit.point = tileHit.position;
+				hit.normal = tileHit.normal;
+				found = true;
+			}
+		}
+		else
+		{
+			float time;
+			Vector2D normal;
+			if (GetSegmentPolygonEntry(&vertices[entry.firstVertex], entry.vertexCount, entry.radius, start, unitDirection * closest, enter, time, normal))
+			{
+				closest *= time;
+				hit.object = entry.object;
+				hit.point = start + unitDirection * closest;
+				hit.normal = normal;
+				found = true;
+			}
+		}
+	}
+
+	if (found)
+		hit.distance = closest;
+
+	return found;
+}
+
+// Runs many raycasts at once.
+// Params:
+//   queries = The raycasts to run.
+//   count = How many raycasts there are.
+//   results = Output array, set to whether each ray hit something.
+//   hits = Output array of hit information, only valid where results is true.
+// Returns:
+//   How many rays hit something.
+size_t CollisionQueries::RaycastBatch(const RaycastQuery* queries, size_t count, bool* results, QueryHit* hits) const
+{
+	size_t hitCount = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const RaycastQuery& query = queries[i];
+		results[i] = Raycast(query.start, query.direction, query.maxDistance, hits[i], query.layerMask);
+		if (results[i])
+			++hitCount;
+	}
+
+	return hitCount;
+}
+
+// Finds every collider that overlaps a circle.
+// Params:
+//   center = The center of the circle.
+//   radius = The radius of the circle.
+//   results = Filled with the colliders that overlap the circle.
+//   layerMask = Which collider layers can be found.
+// Returns:
+//   How many colliders were found.
+size_t CollisionQueries::OverlapCircle(const Vector2D& center, float radius, std::vector<QueryHit>& results, unsigned layerMask) const
+{
+	return Overlap(SupportShape::FromCircle(center, radius), center - Vector2D(radius, radius), center + Vector2D(radius, radius),
+		results, layerMask);
+}
+
+// Finds every collider that overlaps an axis-aligned box.
+// Params:
+//   center = The center of the box.
+//   extents = The half-width and half-height of the box.
+//   results = Filled with the colliders that overlap the box.
+//   layerMask = Which collider layers can be found.
+// Returns:
+//   How many colliders were found.
+size_t CollisionQueries::OverlapBox(const Vector2D& center, const Vector2D& extents, std::vector<QueryHit>& results, unsigned layerMask) const
+{
+	const Vector2D corners[4] = {
+		Vector2D(center.x - extents.x, center.y + extents.y),
+		Vector2D(center.x + extents.x, center.y + extents.y),
+		Vector2D(center.x + extents.x, center.y - extents.y),
+		Vector2D(center.x - extents.x, center.y - extents.y),
+	};
+
+	return Overlap(SupportShape::FromBox(corners), center - extents, center + extents, results, layerMask);
+}
+
+// Finds the colliders closest to a point, nearest first. Tilemaps are ignored.
+// Params:
+//   point = The point to search around.
+//   count = The most colliders to find.
+//   results = Filled with the closest colliders.
+//   layerMask = Which collider layers can be found.
+// Returns:
+//   How many colliders were found.
+size_t CollisionQueries::FindNearest(const Vector2D& point, unsigned count, std::vector<QueryHit>& results, unsigned layerMask) const
+{
+	results.clear();
+	if (count == 0)
+		return 0;
+
+	// The distance to a collider's bounds is never more than the distance to the collider,
+	// so visiting colliders in order of bounds distance lets us stop early.
+	std::vector<std::pair<float, const Entry*>> candidates;
+	candidates.reserve(entries.size());
+	for (auto it = entries.begin(); it != entries.end(); ++it)
+	{
+		if ((it->layers & layerMask) == 0 || it->map != nullptr)
+			continue;
+
+		float x = max(max(it->boundsMin.x - point.x, point.x - it->boundsMax.x), 0.0f);
+		float y = max(max(it->boundsMin.y - point.y, point.y - it->boundsMax.y), 0.0f);
+		candidates.push_back(std::make_pair(x * x + y * y, &*it));
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const std::pair<float, const Entry*>& a, const std::pair<float, const Entry*>& b) { return a.first < b.first; });
+
+	const SupportShape query = SupportShape::FromPoint(point);
+	for (auto it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		// Once the results are full, stop when even the bounds are farther than the farthest result.
+		if (results.size() == count && it->first >= results.back().distance * results.back().distance)
+			break;
+
+		const Entry& entry = *it->second;
+		Vector2D queryPoint;
+		Vector2D corePoint;
+		float distance = GJKDistance(query, GetShape(entry), queryPoint, corePoint);
+
+		QueryHit hit;
+		hit.object = entry.object;
+		hit.distance = max(distance - entry.radius, 0.0f);
+		hit.point = GetSurfacePoint(queryPoint, corePoint, distance, entry.radius);
+
+		// Line colliders have an entry per segment, so only keep each object's closest one.
+		auto previous = std::find_if(results.begin(), results.end(), [&hit](const QueryHit& result) { return result.object == hit.object; });
+		if (previous != results.end())
+		{
+			if (previous->distance <= hit.distance)
+				continue;
+
+			results.erase(previous);
+		}
+
+		// Insert the hit in order, dropping the farthest if there are too many.
+		auto position = std::upper_bound(results.begin(), results.end(), hit,
+			[](const QueryHit& a, const QueryHit& b) { return a.distance < b.distance; });
+		results.insert(position, hit);
+		if (results.size() > count)
+			results.pop_back();
+	}
+
+	return results.size();
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Gets the shape of a (non-tilemap) entry.
+SupportShape CollisionQueries::GetShape(const Entry& entry) const
+{
+	return SupportShape::FromPolygon(&vertices[entry.firstVertex], entry.vertexCount, entry.radius);
+}
+
+// Finds every collider that overlaps a query shape.
+// Params:
+//   query = The query shape.
+//   boundsMin = Bottom left of the query shape's bounds.
+//   boundsMax = Top right of the query shape's bounds.
+//   results = Filled with the colliders that overlap the shape.
+//   layerMask = Which collider layers can be found.
+// Returns:
+//   How many colliders were found.
+size_t CollisionQueries::Overlap(const SupportShape& query, const Vector2D& boundsMin, const Vector2D& boundsMax,
+	std::vector<QueryHit>& results, unsigned layerMask) const
+{
+	results.clear();
+
+	for (auto it = entries.begin(); it != entries.end(); ++it)
+	{
+		const Entry& entry = *it;
+		if ((entry.layers & layerMask) == 0 || !BoundsOverlap(boundsMin, boundsMax, entry.boundsMin, entry.boundsMax))
+			continue;
+
+		// A line collider's segments are next to each other, so it's only reported for the first one that overlaps.
+		if (!results.empty() && results.back().object == entry.object)
+			continue;
+
+		QueryHit hit;
+		hit.object = entry.object;
+
+		if (entry.map != nullptr)
+		{
+			if (!OverlapTiles(query, boundsMin, boundsMax, entry, hit.point))
+				continue;
+		}
+		else
+		{
+			Vector2D queryPoint;
+			Vector2D corePoint;
+			float distance = GJKDistance(query, GetShape(entry), queryPoint, corePoint);
+			if (distance > query.GetRadius() + entry.radius)
+				continue;
+
+			hit.distance = max(distance - query.GetRadius() - entry.radius, 0.0f);
+			hit.point = GetSurfacePoint(queryPoint, corePoint, distance, entry.radius);
+		}
+
+		results.push_back(hit);
+	}
+
+	return results.size();
+}
+
+// Checks whether a query shape overlaps any solid tile in a tilemap entry.
+// Params:
+//   query = The query shape.
+//   boundsMin = Bottom left of the query shape's bounds.
+//   boundsMax = Top right of the query shape's bounds.
+//   entry = The tilemap entry.
+//   point = The closest point on the first tile found to overlap the shape.
+// Returns:
+//   True if the shape overlaps a solid tile, false otherwise.
+bool CollisionQueries::OverlapTiles(const SupportShape& query, const Vector2D& boundsMin, const Vector2D& boundsMax,
+	const Entry& entry, Vector2D& point) const
+{
+	// Find the cells under the query's bounds. Cell (column, row) covers
+	// [column, column + 1) x [row, row + 1) in grid space, and rows grow downward.
+	Vector2D corners[4] = { boundsMin, Vector2D(boundsMax.x, boundsMin.y), boundsMax, Vector2D(boundsMin.x, boundsMax.y) };
+	ApplyTransformToPoints(entry.inverse, corners, 4);
+
+	float gridMinX = FLT_MAX;
+	float gridMinY = FLT_MAX;
+	float gridMaxX = -FLT_MAX;
+	float gridMaxY = -FLT_MAX;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		gridMinX = min(gridMinX, corners[i].x + 0.5f);
+		gridMaxX = max(gridMaxX, corners[i].x + 0.5f);
+		gridMinY = min(gridMinY, 0.5f - corners[i].y);
+		gridMaxY = max(gridMaxY, 0.5f - corners[i].y);
+	}
+
+	const int firstColumn = max(static_cast<int>(floor(gridMinX)), 0);
+	const int lastColumn = min(static_cast<int>(floor(gridMaxX)), static_cast<int>(entry.map->GetWidth()) - 1);
+	const int firstRow = max(static_cast<int>(floor(gridMinY)), 0);
+	const int lastRow = min(static_cast<int>(floor(gridMaxY)), static_cast<int>(entry.map->GetHeight()) - 1);
+
+	// Test the query's actual shape against each solid tile, so round queries don't
+	// find tiles that are only inside the corners of their bounds.
+	for (int column = firstColumn; column <= lastColumn; ++column)
+	{
+		for (int row = firstRow; row <= lastRow; ++row)
+		{
+			if (!ColliderTilemap::IsCellSolid(*entry.map, column, row))
+				continue;
+
+			const float left = static_cast<float>(column) - 0.5f;
+			const float top = 0.5f - static_cast<float>(row);
+			Vector2D tile[4] = { Vector2D(left, top), Vector2D(left + 1.0f, top), Vector2D(left + 1.0f, top - 1.0f), Vector2D(left, top - 1.0f) };
+			ApplyTransformToPoints(entry.matrix, tile, 4);
+
+			Vector2D queryPoint;
+			Vector2D tilePoint;
+			float distance = GJKDistance(query, SupportShape::FromBox(tile), queryPoint, tilePoint);
+			if (distance > query.GetRadius())
+				continue;
+
+			point = GetSurfacePoint(queryPoint, tilePoint, distance, 0.0f);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
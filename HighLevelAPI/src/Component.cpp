@@ -41,4 +41,14 @@ GameObject* Component::GetOwner() const
 	return static_cast<GameObject*>(GetParent());
 }
 
+// Whether FixedUpdate can run on a worker thread, alongside other objects' fixed updates.
+// Components that only change their own object can return true. Components that use
+// other objects or the engine's systems (input, graphics, sound) must run on the main thread.
+// Returns:
+//   False by default.
+bool Component::IsFixedUpdateThreadSafe() const
+{
+	return false;
+}
+
 //------------------------------------------------------------------------------
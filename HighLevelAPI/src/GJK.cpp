@@ -0,0 +1,786 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GJK.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "GJK.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Most iterations GJK will take before giving up on improving the simplex.
+	const unsigned maxGJKIterations = 20;
+
+	// Most vertices the EPA polytope can grow to.
+	const unsigned maxPolytopeSize = 32;
+
+	// Distances below this are treated as touching.
+	const float contactEpsilon = 0.0001f;
+
+	// Most steps a sweep will take before deciding the circle is only grazing the target.
+	const unsigned maxSweepIterations = 32;
+
+	// How close (in world units) a swept circle has to get to count as touching.
+	const float sweepTolerance = 0.01f;
+
+	// A vertex of the Minkowski difference (A - B), remembering which vertices it came from.
+	struct SimplexVertex
+	{
+		Vector2D pointA;  // Support point on the first shape.
+		Vector2D pointB;  // Support point on the second shape.
+		Vector2D point;   // pointA - pointB
+		float weight;     // Barycentric coordinate of the closest point.
+		unsigned indexA;  // Index of pointA on the first shape.
+		unsigned indexB;  // Index of pointB on the second shape.
+	};
+
+	// Up to three vertices of the Minkowski difference.
+	struct Simplex
+	{
+		SimplexVertex vertices[3];
+		unsigned count;
+	};
+
+	float Dot(const Vector2D& a, const Vector2D& b)
+	{
+		return a.x * b.x + a.y * b.y;
+	}
+
+	float Cross(const Vector2D& a, const Vector2D& b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+
+	// Fills out a simplex vertex from a pair of support indices.
+	void SetVertex(SimplexVertex& vertex, const SupportShape& shapeA, const SupportShape& shapeB, unsigned indexA, unsigned indexB)
+	{
+		vertex.indexA = indexA;
+		vertex.indexB = indexB;
+		vertex.pointA = shapeA.GetVertex(indexA);
+		vertex.pointB = shapeB.GetVertex(indexB);
+		vertex.point = Vector2D(vertex.pointA.x - vertex.pointB.x, vertex.pointA.y - vertex.pointB.y);
+		vertex.weight = 1.0f;
+	}
+
+	// Finds the point on a segment of the simplex closest to the origin.
+	void SolveSegment(Simplex& simplex)
+	{
+		const Vector2D& w1 = simplex.vertices[0].point;
+		const Vector2D& w2 = simplex.vertices[1].point;
+		Vector2D e12(w2.x - w1.x, w2.y - w1.y);
+
+		// Closest to the first vertex.
+		float d12_2 = -Dot(w1, e12);
+		if (d12_2 <= 0.0f)
+		{
+			simplex.vertices[0].weight = 1.0f;
+			simplex.count = 1;
+			return;
+		}
+
+		// Closest to the second vertex.
+		float d12_1 = Dot(w2, e12);
+		if (d12_1 <= 0.0f)
+		{
+			simplex.vertices[1].weight = 1.0f;
+			simplex.vertices[0] = simplex.vertices[1];
+			simplex.count = 1;
+			return;
+		}
+
+		// Closest to somewhere in between.
+		float inverse = 1.0f / (d12_1 + d12_2);
+		simplex.vertices[0].weight = d12_1 * inverse;
+		simplex.vertices[1].weight = d12_2 * inverse;
+		simplex.count = 2;
+	}
+
+	// Finds the feature of a triangle simplex closest to the origin, dropping the vertices
+	// that don't contribute to it.
+	void SolveTriangle(Simplex& simplex)
+	{
+		SimplexVertex* v = simplex.vertices;
+		const Vector2D& w1 = v[0].point;
+		const Vector2D& w2 = v[1].point;
+		const Vector2D& w3 = v[2].point;
+
+		Vector2D e12(w2.x - w1.x, w2.y - w1.y);
+		float d12_1 = Dot(w2, e12);
+		float d12_2 = -Dot(w1, e12);
+
+		Vector2D e13(w3.x - w1.x, w3.y - w1.y);
+		float d13_1 = Dot(w3, e13);
+		float d13_2 = -Dot(w1, e13);
+
+		Vector2D e23(w3.x - w2.x, w3.y - w2.y);
+		float d23_1 = Dot(w3, e23);
+		float d23_2 = -Dot(w2, e23);
+
+		// Signed areas of the triangles formed with the origin.
+		float n123 = Cross(e12, e13);
+		float d123_1 = n123 * Cross(w2, w3);
+		float d123_2 = n123 * Cross(w3, w1);
+		float d123_3 = n123 * Cross(w1, w2);
+
+		// First vertex region.
+		if (d12_2 <= 0.0f && d13_2 <= 0.0f)
+		{
+			v[0].weight = 1.0f;
+			simplex.count = 1;
+			return;
+		}
+
+		// First edge region.
+		if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f)
+		{
+			float inverse = 1.0f / (d12_1 + d12_2);
+			v[0].weight = d12_1 * inverse;
+			v[1].weight = d12_2 * inverse;
+			simplex.count = 2;
+			return;
+		}
+
+		// Second edge region.
+		if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f)
+		{
+			float inverse = 1.0f / (d13_1 + d13_2);
+			v[0].weight = d13_1 * inverse;
+			v[2].weight = d13_2 * inverse;
+			v[1] = v[2];
+			simplex.count = 2;
+			return;
+		}
+
+		// Second vertex region.
+		if (d12_1 <= 0.0f && d23_2 <= 0.0f)
+		{
+			v[1].weight = 1.0f;
+			v[0] = v[1];
+			simplex.count = 1;
+			return;
+		}
+
+		// Third vertex region.
+		if (d13_1 <= 0.0f && d23_1 <= 0.0f)
+		{
+			v[2].weight = 1.0f;
+			v[0] = v[2];
+			simplex.count = 1;
+			return;
+		}
+
+		// Third edge region.
+		if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f)
+		{
+			float inverse = 1.0f / (d23_1 + d23_2);
+			v[1].weight = d23_1 * inverse;
+			v[2].weight = d23_2 * inverse;
+			v[0] = v[2];
+			simplex.count = 2;
+			return;
+		}
+
+		// The origin is inside the triangle.
+		float inverse = 1.0f / (d123_1 + d123_2 + d123_3);
+		v[0].weight = d123_1 * inverse;
+		v[1].weight = d123_2 * inverse;
+		v[2].weight = d123_3 * inverse;
+		simplex.count = 3;
+	}
+
+	// Gets the direction to search for the next simplex vertex in.
+	Vector2D GetSearchDirection(const Simplex& simplex)
+	{
+		const Vector2D& w1 = simplex.vertices[0].point;
+
+		if (simplex.count == 1)
+			return Vector2D(-w1.x, -w1.y);
+
+		// Use the perpendicular of the segment facing the origin, which is more precise
+		// than negating the closest point when the segment passes near the origin.
+		const Vector2D& w2 = simplex.vertices[1].point;
+		Vector2D e12(w2.x - w1.x, w2.y - w1.y);
+		if (Cross(e12, Vector2D(-w1.x, -w1.y)) > 0.0f)
+			return Vector2D(-e12.y, e12.x);
+		else
+			return Vector2D(e12.y, -e12.x);
+	}
+
+	// Gets the closest points on both shapes using the simplex weights.
+	void GetWitnessPoints(const Simplex& simplex, Vector2D& pointA, Vector2D& pointB)
+	{
+		pointA = Vector2D(0.0f, 0.0f);
+		pointB = Vector2D(0.0f, 0.0f);
+
+		for (unsigned i = 0; i < simplex.count; ++i)
+		{
+			const SimplexVertex& vertex = simplex.vertices[i];
+			pointA.x += vertex.pointA.x * vertex.weight;
+			pointA.y += vertex.pointA.y * vertex.weight;
+			pointB.x += vertex.pointB.x * vertex.weight;
+			pointB.y += vertex.pointB.y * vertex.weight;
+		}
+	}
+
+	// Runs GJK on the cores of two shapes.
+	// Params:
+	//   shapeA = The first shape.
+	//   shapeB = The second shape.
+	//   simplex = The final simplex. Contains the origin if count is 3.
+	//   cache = The simplex to start from, or nullptr. Updated on return.
+	void RunGJK(const SupportShape& shapeA, const SupportShape& shapeB, Simplex& simplex, GJKCache* cache)
+	{
+		// Start from the cached simplex if it still refers to valid vertices.
+		simplex.count = 0;
+		if (cache != nullptr)
+		{
+			for (unsigned i = 0; i < cache->count; ++i)
+			{
+				if (cache->indexA[i] >= shapeA.GetVertexCount() || cache->indexB[i] >= shapeB.GetVertexCount())
+				{
+					simplex.count = 0;
+					break;
+				}
+
+				SetVertex(simplex.vertices[simplex.count++], shapeA, shapeB, cache->indexA[i], cache->indexB[i]);
+			}
+		}
+
+		if (simplex.count == 0)
+		{
+			SetVertex(simplex.vertices[0], shapeA, shapeB, 0, 0);
+			simplex.count = 1;
+		}
+
+		for (unsigned iteration = 0; iteration < maxGJKIterations; ++iteration)
+		{
+			// Remember the vertices so we can tell when we stop making progress.
+			unsigned previousCount = simplex.count;
+			unsigned previousA[3];
+			unsigned previousB[3];
+			for (unsigned i = 0; i < previousCount; ++i)
+			{
+				previousA[i] = simplex.vertices[i].indexA;
+				previousB[i] = simplex.vertices[i].indexB;
+			}
+
+			if (simplex.count == 2)
+				SolveSegment(simplex);
+			else if (simplex.count == 3)
+				SolveTriangle(simplex);
+
+			// The origin is inside the simplex, so the cores overlap.
+			if (simplex.count == 3)
+				break;
+
+			// The origin is on the simplex, so the cores are touching.
+			Vector2D direction = GetSearchDirection(simplex);
+			if (Dot(direction, direction) < contactEpsilon * contactEpsilon)
+				break;
+
+			// Add the vertex of the Minkowski difference farthest toward the origin.
+			SimplexVertex& vertex = simplex.vertices[simplex.count];
+			SetVertex(vertex, shapeA, shapeB, shapeA.GetSupportIndex(direction), shapeB.GetSupportIndex(Vector2D(-direction.x, -direction.y)));
+
+			// If the vertex is already in the simplex, we can't get any closer.
+			bool duplicate = false;
+			for (unsigned i = 0; i < previousCount && !duplicate; ++i)
+				duplicate = vertex.indexA == previousA[i] && vertex.indexB == previousB[i];
+
+			if (duplicate)
+				break;
+
+			++simplex.count;
+		}
+
+		// Save the simplex for next time.
+		if (cache != nullptr)
+		{
+			cache->count = simplex.count;
+			for (unsigned i = 0; i < simplex.count; ++i)
+			{
+				cache->indexA[i] = simplex.vertices[i].indexA;
+				cache->indexB[i] = simplex.vertices[i].indexB;
+			}
+		}
+	}
+
+	// Grows a degenerate simplex (a vertex or segment touching the origin) into a triangle
+	// so EPA has a polytope to start with.
+	// Returns:
+	//   False if the Minkowski difference has no area (e.g. point against point).
+	bool CompleteTriangle(const SupportShape& shapeA, const SupportShape& shapeB, Simplex& simplex)
+	{
+		// Directions to try when the simplex is a single vertex.
+		const Vector2D axes[4] = { Vector2D(1.0f, 0.0f), Vector2D(-1.0f, 0.0f), Vector2D(0.0f, 1.0f), Vector2D(0.0f, -1.0f) };
+
+		for (unsigned i = 0; i < 4 && simplex.count == 1; ++i)
+		{
+			SimplexVertex& vertex = simplex.vertices[1];
+			SetVertex(vertex, shapeA, shapeB, shapeA.GetSupportIndex(axes[i]), shapeB.GetSupportIndex(-axes[i]));
+			if (vertex.point.DistanceSquared(simplex.vertices[0].point) > contactEpsilon * contactEpsilon)
+				simplex.count = 2;
+		}
+
+		if (simplex.count < 2)
+			return false;
+
+		// Search on both sides of the segment for a third vertex.
+		Vector2D edge = simplex.vertices[1].point - simplex.vertices[0].point;
+		Vector2D normals[2] = { Vector2D(-edge.y, edge.x), Vector2D(edge.y, -edge.x) };
+
+		for (unsigned i = 0; i < 2 && simplex.count == 2; ++i)
+		{
+			SimplexVertex& vertex = simplex.vertices[2];
+			SetVertex(vertex, shapeA, shapeB, shapeA.GetSupportIndex(normals[i]), shapeB.GetSupportIndex(-normals[i]));
+			if (fabsf(Cross(edge, vertex.point - simplex.vertices[0].point)) > contactEpsilon)
+				simplex.count = 3;
+		}
+
+		return simplex.count == 3;
+	}
+
+	// Runs EPA on a triangle that contains the origin, finding the penetration normal and depth.
+	// Params:
+	//   shapeA = The first shape.
+	//   shapeB = The second shape.
+	//   simplex = A triangle containing the origin.
+	//   manifold = Receives the normal, depth, and one contact point.
+	//   pointA = The deepest point on the first core.
+	//   pointB = The deepest point on the second core.
+	void RunEPA(const SupportShape& shapeA, const SupportShape& shapeB, const Simplex& simplex, ContactManifold& manifold, Vector2D& pointA, Vector2D& pointB)
+	{
+		SimplexVertex polytope[maxPolytopeSize];
+		unsigned size = 3;
+		for (unsigned i = 0; i < 3; ++i)
+			polytope[i] = simplex.vertices[i];
+
+		// Keep the polytope counter-clockwise so edge normals face outward.
+		if (Cross(polytope[1].point - polytope[0].point, polytope[2].point - polytope[0].point) < 0.0f)
+			std::swap(polytope[1], polytope[2]);
+
+		unsigned closestEdge = 0;
+		Vector2D closestNormal;
+		float closestDistance = 0.0f;
+
+		for (;;)
+		{
+			// Find the edge closest to the origin.
+			closestDistance = FLT_MAX;
+			for (unsigned i = 0; i < size; ++i)
+			{
+				const Vector2D& start = polytope[i].point;
+				const Vector2D& end = polytope[(i + 1) % size].point;
+				Vector2D normal = Vector2D(end.y - start.y, start.x - end.x).Normalized();
+				float distance = Dot(normal, start);
+				if (distance < closestDistance)
+				{
+					closestDistance = distance;
+					closestNormal = normal;
+					closestEdge = i;
+				}
+			}
+
+			// Stop once the polytope can't be pushed out any further along that edge.
+			SimplexVertex vertex;
+			SetVertex(vertex, shapeA, shapeB, shapeA.GetSupportIndex(closestNormal), shapeB.GetSupportIndex(-closestNormal));
+			if (Dot(closestNormal, vertex.point) - closestDistance < contactEpsilon || size == maxPolytopeSize)
+				break;
+
+			// Insert the new vertex between the edge's end points.
+			for (unsigned i = size; i > closestEdge + 1; --i)
+				polytope[i] = polytope[i - 1];
+			polytope[closestEdge + 1] = vertex;
+			++size;
+		}
+
+		// Project the origin onto the closest edge to get the deepest points.
+		const SimplexVertex& start = polytope[closestEdge];
+		const SimplexVertex& end = polytope[(closestEdge + 1) % size];
+		Vector2D edge = end.point - start.point;
+		float lengthSquared = Dot(edge, edge);
+		float t = lengthSquared > 0.0f ? min(max(-Dot(start.point, edge) / lengthSquared, 0.0f), 1.0f) : 0.0f;
+		pointA = start.pointA + (end.pointA - start.pointA) * t;
+		pointB = start.pointB + (end.pointB - start.pointB) * t;
+
+		// The closest edge's normal points from the first shape toward the second.
+		manifold.normal = closestNormal;
+		manifold.depth = closestDistance;
+	}
+
+	// Finds the edge of a polygon whose outward normal is most aligned with a direction.
+	// Params:
+	//   shape = The polygon.
+	//   direction = The direction to compare against.
+	//   start = The start of the edge.
+	//   end = The end of the edge.
+	//   normal = The outward normal of the edge.
+	void FindFacingEdge(const SupportShape& shape, const Vector2D& direction, Vector2D& start, Vector2D& end, Vector2D& normal)
+	{
+		unsigned count = shape.GetVertexCount();
+
+		// The centroid lets us orient the edge normals without knowing the winding.
+		Vector2D centroid(0.0f, 0.0f);
+		for (unsigned i = 0; i < count; ++i)
+			centroid += shape.GetVertex(i);
+		centroid /= static_cast<float>(count);
+
+		float best = -FLT_MAX;
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const Vector2D& a = shape.GetVertex(i);
+			const Vector2D& b = shape.GetVertex((i + 1) % count);
+			Vector2D edgeNormal = Vector2D(b.y - a.y, a.x - b.x).Normalized();
+			if (Dot(edgeNormal, a - centroid) < 0.0f)
+				edgeNormal = -edgeNormal;
+
+			float alignment = Dot(edgeNormal, direction);
+			if (alignment > best)
+			{
+				best = alignment;
+				start = a;
+				end = b;
+				normal = edgeNormal;
+			}
+		}
+	}
+
+	// Builds up to two contact points for two overlapping polygons by clipping the most
+	// anti-parallel edge of the second polygon against the most parallel edge of the first.
+	// Params:
+	//   shapeA = The first polygon.
+	//   shapeB = The second polygon.
+	//   manifold = The manifold to fill in. The normal must already be set.
+	// Returns:
+	//   True if at least one contact point was found.
+	bool ClipPolygonContacts(const SupportShape& shapeA, const SupportShape& shapeB, ContactManifold& manifold)
+	{
+		Vector2D referenceStart, referenceEnd, referenceNormal;
+		Vector2D incidentStart, incidentEnd, incidentNormal;
+		FindFacingEdge(shapeA, manifold.normal, referenceStart, referenceEnd, referenceNormal);
+		FindFacingEdge(shapeB, -manifold.normal, incidentStart, incidentEnd, incidentNormal);
+
+		Vector2D tangent = (referenceEnd - referenceStart).Normalized();
+		float lower = Dot(tangent, referenceStart);
+		float upper = Dot(tangent, referenceEnd);
+
+		// Clip the incident edge to the sides of the reference edge.
+		Vector2D clipped[2] = { incidentStart, incidentEnd };
+		for (unsigned side = 0; side < 2; ++side)
+		{
+			float sign = side == 0 ? 1.0f : -1.0f;
+			float offset = side == 0 ? lower : -upper;
+			float distance0 = sign * Dot(tangent, clipped[0]) - offset;
+			float distance1 = sign * Dot(tangent, clipped[1]) - offset;
+
+			// Both points are outside this side, nothing to keep.
+			if (distance0 < 0.0f && distance1 < 0.0f)
+				return false;
+
+			// Move whichever point is outside onto the side.
+			if (distance0 < 0.0f)
+				clipped[0] = clipped[0] + (clipped[1] - clipped[0]) * (distance0 / (distance0 - distance1));
+			else if (distance1 < 0.0f)
+				clipped[1] = clipped[1] + (clipped[0] - clipped[1]) * (distance1 / (distance1 - distance0));
+		}
+
+		// Keep the points that are behind the reference face.
+		float face = Dot(referenceNormal, referenceStart);
+		manifold.pointCount = 0;
+		for (unsigned i = 0; i < 2; ++i)
+		{
+			if (Dot(referenceNormal, clipped[i]) <= face + contactEpsilon)
+				manifold.points[manifold.pointCount++] = clipped[i];
+		}
+
+		return manifold.pointCount != 0;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Creates an empty shape.
+SupportShape::SupportShape()
+	: vertices(nullptr), count(0), radius(0.0f)
+{
+}
+
+// Creates a shape for a single point.
+// Params:
+//   point = The point in world space.
+SupportShape SupportShape::FromPoint(const Vector2D& point)
+{
+	return FromCircle(point, 0.0f);
+}
+
+// Creates a shape for a circle.
+// Params:
+//   center = The center of the circle in world space.
+//   radius = The radius of the circle.
+SupportShape SupportShape::FromCircle(const Vector2D& center, float radius)
+{
+	SupportShape shape;
+	shape.localVertices[0] = center;
+	shape.count = 1;
+	shape.radius = radius;
+	return shape;
+}
+
+// Creates a shape for an oriented box. The corners are copied into the shape.
+// Params:
+//   corners = The world space corners of the box, in order around the box.
+SupportShape SupportShape::FromBox(const Vector2D corners[4])
+{
+	SupportShape shape;
+	for (unsigned i = 0; i < 4; ++i)
+		shape.localVertices[i] = corners[i];
+	shape.count = 4;
+	return shape;
+}
+
+// Creates a shape for a convex polygon. The vertices are NOT copied, so they
+// must outlive the shape.
+// Params:
+//   vertices = The world space vertices of the polygon, in order around the polygon.
+//   size = How many vertices there are.
+//   radius = How much to round the polygon by.
+SupportShape SupportShape::FromPolygon(const Vector2D* vertices, unsigned size, float radius)
+{
+	SupportShape shape;
+	shape.vertices = vertices;
+	shape.count = size;
+	shape.radius = radius;
+	return shape;
+}
+
+// Finds the vertex of the core that is farthest along a direction.
+// Params:
+//   direction = The direction to search in. Doesn't need to be normalized.
+// Returns:
+//   The index of the farthest vertex.
+unsigned SupportShape::GetSupportIndex(const Vector2D& direction) const
+{
+	const Vector2D* points = vertices != nullptr ? vertices : localVertices;
+
+	unsigned best = 0;
+	float bestProjection = -FLT_MAX;
+	for (unsigned i = 0; i < count; ++i)
+	{
+		float projection = points[i].x * direction.x + points[i].y * direction.y;
+		if (projection > bestProjection)
+		{
+			bestProjection = projection;
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+// Gets a vertex of the core.
+// Params:
+//   index = The index of the vertex.
+const Vector2D& SupportShape::GetVertex(unsigned index) const
+{
+	return vertices != nullptr ? vertices[index] : localVertices[index];
+}
+
+// Gets how many vertices the core has.
+unsigned SupportShape::GetVertexCount() const
+{
+	return count;
+}
+
+// Gets the radius the core is rounded by.
+float SupportShape::GetRadius() const
+{
+	return radius;
+}
+
+// Creates an empty cache.
+GJKCache::GJKCache()
+	: count(0)
+{
+}
+
+// Creates an empty manifold.
+ContactManifold::ContactManifold()
+	: depth(0.0f), pointCount(0)
+{
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Finds the closest points between the cores of two shapes using GJK. Radii are ignored.
+// Params:
+//   shapeA = The first shape.
+//   shapeB = The second shape.
+//   pointA = The closest point on the first core.
+//   pointB = The closest point on the second core.
+//   cache = The simplex from the previous test of the same pair, or nullptr. Updated on return.
+// Returns:
+//   The distance between the cores, zero if they overlap.
+float GJKDistance(const SupportShape& shapeA, const SupportShape& shapeB, Vector2D& pointA, Vector2D& pointB, GJKCache* cache)
+{
+	Simplex simplex;
+	RunGJK(shapeA, shapeB, simplex, cache);
+	GetWitnessPoints(simplex, pointA, pointB);
+
+	if (simplex.count == 3)
+		return 0.0f;
+
+	return pointA.Distance(pointB);
+}
+
+// Checks whether two shapes intersect and, if so, calculates the contact manifold.
+// Uses GJK for separated or shallow contacts (including rounded shapes) and EPA when
+// the cores overlap. Polygon pairs get up to two contact points from edge clipping.
+// Params:
+//   shapeA = The first shape.
+//   shapeB = The second shape.
+//   manifold = The contact manifold, only valid if the shapes intersect.
+//   cache = The simplex from the previous test of the same pair, or nullptr. Updated on return.
+// Returns:
+//   True if intersection, false otherwise.
+bool ComputeContact(const SupportShape& shapeA, const SupportShape& shapeB, ContactManifold& manifold, GJKCache* cache)
+{
+	if (shapeA.GetVertexCount() == 0 || shapeB.GetVertexCount() == 0)
+		return false;
+
+	Simplex simplex;
+	RunGJK(shapeA, shapeB, simplex, cache);
+
+	Vector2D pointA;
+	Vector2D pointB;
+	GetWitnessPoints(simplex, pointA, pointB);
+
+	const float radiusA = shapeA.GetRadius();
+	const float radiusB = shapeB.GetRadius();
+	const float distance = simplex.count == 3 ? 0.0f : pointA.Distance(pointB);
+
+	// The cores are apart by more than the radii can cover.
+	if (distance > radiusA + radiusB)
+		return false;
+
+	if (distance > contactEpsilon)
+	{
+		// The cores are apart, but the rounded parts overlap. The normal runs between the closest points.
+		manifold.normal = (pointB - pointA) / distance;
+		manifold.depth = radiusA + radiusB - distance;
+	}
+	else if ((simplex.count == 3 || CompleteTriangle(shapeA, shapeB, simplex)))
+	{
+		// The cores themselves overlap, so use EPA to find how far.
+		RunEPA(shapeA, shapeB, simplex, manifold, pointA, pointB);
+		manifold.depth += radiusA + radiusB;
+
+		// Polygons touch along edges, so they get a full manifold.
+		if (radiusA == 0.0f && radiusB == 0.0f && shapeA.GetVertexCount() > 2 && shapeB.GetVertexCount() > 2
+			&& ClipPolygonContacts(shapeA, shapeB, manifold))
+		{
+			return true;
+		}
+	}
+	else
+	{
+		// The Minkowski difference has no area (e.g. two points or circles at the same
+		// position), so there's no meaningful direction. Pick one.
+		manifold.normal = Vector2D(0.0f, 1.0f);
+		manifold.depth = radiusA + radiusB;
+	}
+
+	// Use a single point halfway between the surfaces.
+	Vector2D surfaceA = pointA + manifold.normal * radiusA;
+	Vector2D surfaceB = pointB - manifold.normal * radiusB;
+	manifold.points[0] = surfaceA.Midpoint(surfaceB);
+	manifold.pointCount = 1;
+	return true;
+}
+
+// Finds when a circle moving in a straight line first touches a shape, using
+// conservative advancement: the circle is repeatedly moved forward by its GJK
+// distance to the shape, which can never step past the first point of contact.
+// Params:
+//   start = The center of the circle at the start of the movement.
+//   end = The center of the circle at the end of the movement.
+//   radius = The radius of the circle.
+//   target = The shape the circle is moving toward. Should not move during the sweep.
+//   t = How far along the movement (0 to 1) the circle first touches the shape.
+//   normal = Unit vector pointing from the shape toward the circle at that time.
+// Returns:
+//   True if the circle touches the shape during the movement, false otherwise. A circle
+//   still closing in when the iterations run out is treated as touching at that point.
+bool SweptCircleIntersection(const Vector2D& start, const Vector2D& end, float radius, const SupportShape& target, float& t, Vector2D& normal)
+{
+	if (target.GetVertexCount() == 0)
+		return false;
+
+	const Vector2D movement = end - start;
+	const float length = movement.Magnitude();
+	const float radii = radius + target.GetRadius();
+
+	GJKCache cache;
+	float time = 0.0f;
+	Vector2D separation(0.0f, 1.0f);
+
+	for (unsigned iteration = 0; iteration < maxSweepIterations; ++iteration)
+	{
+		Vector2D pointA;
+		Vector2D pointB;
+		float distance = GJKDistance(SupportShape::FromPoint(start + movement * time), target, pointA, pointB, &cache);
+
+		if (distance - radii <= sweepTolerance)
+		{
+			// Already touching, but moving away or along the target. The target is convex, so
+			// the gap can only grow from here.
+			if (iteration == 0 && distance > contactEpsilon && Dot(movement, pointA - pointB) >= 0.0f)
+				return false;
+
+			// Point away from the target, or back along the movement if the circle started inside it.
+			if (distance > contactEpsilon)
+				normal = (pointA - pointB) / distance;
+			else if (length > 0.0f)
+				normal = -movement / length;
+			else
+				normal = Vector2D(0.0f, 1.0f);
+
+			t = time;
+			return true;
+		}
+
+		// The target is still, so the gap can't close faster than the circle moves.
+		if (length <= 0.0f)
+			return false;
+
+		separation = (pointA - pointB) / distance;
+		time += (distance - radii) / length;
+		if (time > 1.0f)
+			return false;
+	}
+
+	// Still approaching after every step. Each step stopped short of the first contact, so the
+	// circle hasn't passed the target yet. Stop it here rather than letting it tunnel through,
+	// at the cost of sometimes stopping a circle that would only have grazed the target.
+	normal = separation;
+	t = time;
+	return true;
+}
+
+//------------------------------------------------------------------------------
@@ -25,6 +25,119 @@
 
 //------------------------------------------------------------------------------
 
+namespace
+{
+	// A slot in the table of live game objects.
+	struct ObjectSlot
+	{
+		std::atomic<GameObject*> object;		// The object in this slot, or nullptr if the slot is free.
+		std::atomic<unsigned> generation;		// Changes every time the slot is freed, so old handles stop matching.
+	};
+
+	// Slots are allocated in blocks that never move, so lookups can read them without taking the lock.
+	const unsigned slotBlockSize = 1024;
+	const unsigned maxSlotBlocks = 1024;
+
+	// Every live game object, indexed by handle. Only allocating and freeing slots takes the
+	// lock. Lookups only read slots below the count, which is raised once a new slot is ready.
+	std::atomic<ObjectSlot*> slotBlocks[maxSlotBlocks];
+	std::atomic<unsigned> slotCount(0);
+	std::vector<unsigned> freeObjectSlots;
+	std::mutex objectSlotsMutex;
+
+	// Frees the slot blocks when the program exits. Objects destroyed after that have no slot to free.
+	struct SlotBlockCleanup
+	{
+		~SlotBlockCleanup()
+		{
+			std::lock_guard<std::mutex> lock(objectSlotsMutex);
+
+			slotCount = 0;
+			freeObjectSlots.clear();
+			for (unsigned i = 0; i < maxSlotBlocks; i++)
+				delete[] slotBlocks[i].exchange(nullptr);
+		}
+	} slotBlockCleanup;
+
+	// Finds a slot in the table.
+	// Params:
+	//   index = The index of the slot. Its block must have been allocated.
+	// Returns:
+	//   The slot.
+	ObjectSlot& GetObjectSlot(unsigned index)
+	{
+		return slotBlocks[index / slotBlockSize].load()[index % slotBlockSize];
+	}
+
+	// Gives an object a slot in the table.
+	// Params:
+	//   object = The object to add.
+	// Returns:
+	//   A handle to the object's slot.
+	Handle<GameObject> AddObjectSlot(GameObject* object)
+	{
+		std::lock_guard<std::mutex> lock(objectSlotsMutex);
+
+		unsigned index;
+		if (!freeObjectSlots.empty())
+		{
+			index = freeObjectSlots.back();
+			freeObjectSlots.pop_back();
+		}
+		else
+		{
+			index = slotCount;
+
+			// Start a new block when the last one is full.
+			if (index % slotBlockSize == 0)
+			{
+				_ASSERTE(index / slotBlockSize < maxSlotBlocks && "Too many game objects");
+
+				ObjectSlot* block = new ObjectSlot[slotBlockSize];
+				for (unsigned i = 0; i < slotBlockSize; i++)
+				{
+					block[i].object = nullptr;
+					block[i].generation = 1;
+				}
+
+				slotBlocks[index / slotBlockSize] = block;
+			}
+		}
+
+		ObjectSlot& slot = GetObjectSlot(index);
+		slot.object = object;
+
+		// A new slot can only be looked up once it holds the object.
+		if (index == slotCount)
+			slotCount = index + 1;
+
+		return Handle<GameObject>(index, slot.generation);
+	}
+
+	// Frees an object's slot so it can be reused.
+	// Params:
+	//   handle = The handle to the object's slot.
+	void RemoveObjectSlot(Handle<GameObject> handle)
+	{
+		std::lock_guard<std::mutex> lock(objectSlotsMutex);
+
+		if (handle.index >= slotCount)
+			return;
+
+		ObjectSlot& slot = GetObjectSlot(handle.index);
+
+		// Change the generation before clearing the object, so lookups that are reading
+		// the slot can tell it was freed. Generation 0 is reserved for invalid handles.
+		unsigned generation = slot.generation + 1;
+		slot.generation = generation != 0 ? generation : 1;
+		slot.object = nullptr;
+
+		freeObjectSlots.push_back(handle.index);
+	}
+}
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
@@ -36,14 +149,15 @@
 // Create a new game object.
 // Params:
 //	 name = The name of the game object being created.
-GameObject::GameObject(const std::string& name) : BetaObject(name), isDestroyed(false)
+GameObject::GameObject(const std::string& name) : BetaObject(name), isDestroyed(false), handle(AddObjectSlot(this))
 {
 }
 
 // Clone a game object from another game object.
 // Params:
 //	 other = A reference to the object being cloned.
-GameObject::GameObject(const GameObject& other) : BetaObject(other.GetName(), other.GetParent()), isDestroyed(false)
+GameObject::GameObject(const GameObject& other) : BetaObject(other.GetName(), other.GetParent()), isDestroyed(false),
+	handle(AddObjectSlot(this))
 {
 	// Reserve how many components we need so there's only 1 allocation.
 	components.reserve(other.components.size());
@@ -60,6 +174,9 @@ GameObject::GameObject(const GameObject& other) : BetaObject(other.GetName(), ot
 // Free the memory associated with a game object.
 GameObject::~GameObject()
 {
+	// Old handles to this object now find nothing, even while its components are being destroyed.
+	RemoveObjectSlot(handle);
+
 	// Destroy all components.
 	for (auto it = components.begin(); it != components.end(); it++)
 	{
@@ -172,6 +289,22 @@ void GameObject::FixedUpdate(float dt)
 	}
 }
 
+// Updates only the components that are, or aren't, safe to update on a worker thread.
+// Params:
+//	 dt = A fixed change in time, usually 1/60th of a second.
+//   threadSafe = Whether to update the components whose IsFixedUpdateThreadSafe returns true, or the rest.
+void GameObject::FixedUpdate(float dt, bool threadSafe)
+{
+	if (isDestroyed)
+		return;
+
+	for (auto it = components.begin(); it != components.end(); it++)
+	{
+		if ((*it)->IsFixedUpdateThreadSafe() == threadSafe)
+			(*it)->FixedUpdate(dt);
+	}
+}
+
 // Draw any visible components attached to the game object.
 void GameObject::Draw()
 {
@@ -226,4 +359,33 @@ Space* GameObject::GetSpace() const
 	return static_cast<Space*>(GetParent());
 }
 
+// Gets a handle to this object, which can be kept instead of a pointer
+// and looked up later, even after the object has been destroyed.
+Handle<GameObject> GameObject::GetHandle() const
+{
+	return handle;
+}
+
+// Finds the object a handle refers to. Safe to call from any thread, and doesn't take a lock.
+// Params:
+//   handle = The handle to look up.
+// Returns:
+//   The object, or nullptr if it has been destroyed or the handle is invalid.
+GameObject* GameObject::GetObjectByHandle(Handle<GameObject> handle_)
+{
+	if (handle_.index >= slotCount)
+		return nullptr;
+
+	const ObjectSlot& slot = GetObjectSlot(handle_.index);
+	if (slot.generation != handle_.generation)
+		return nullptr;
+
+	// Check the generation again, in case the slot was freed and reused while reading the object.
+	GameObject* object = slot.object;
+	if (slot.generation != handle_.generation)
+		return nullptr;
+
+	return object;
+}
+
 //------------------------------------------------------------------------------
@@ -59,31 +59,45 @@
 //    of the specified game object type, else nullptr.
 GameObject* GameObjectFactory::CreateObject(const std::string& name, Mesh* mesh, SpriteSource* spriteSource)
 {
-	// Create a new game object.
-	GameObject* gameObject = new GameObject(name);
+	GameObject* gameObject;
 
-	// Open the object file.
-	Parser parser("Assets/Objects/" + name + ".txt", std::fstream::in);
-
-	try
+	// If the object has been read before, copy it instead of reading the file again.
+	auto cached = objectCache.find(name);
+	if (cached != objectCache.end())
 	{
-		// Deserialize the object.
-		gameObject->Deserialize(parser);
+		gameObject = new GameObject(*cached->second);
+	}
+	else
+	{
+		// Create a new game object.
+		gameObject = new GameObject(name);
+
+		// Open the object file.
+		Parser parser("Assets/Objects/" + name + ".txt", std::fstream::in);
 
-		// If the object has a sprite component, set its mesh and sprite source.
-		Sprite* sprite = gameObject->GetComponent<Sprite>();
-		if (sprite != nullptr)
+		try
 		{
-			sprite->SetMesh(mesh);
-			sprite->SetSpriteSource(spriteSource);
+			// Deserialize the object.
+			gameObject->Deserialize(parser);
 		}
+		catch (const ParseException& parseException)
+		{
+			// If something went horribly wrong deserializing the object, print an error message and return nullptr.
+			std::cout << parseException.what() << std::endl;
+			delete gameObject;
+			return nullptr;
+		}
+
+		// Keep a copy before any resources are given to it, since those belong to the current level.
+		objectCache.emplace(name, new GameObject(*gameObject));
 	}
-	catch (const ParseException& parseException)
+
+	// If the object has a sprite component, set its mesh and sprite source.
+	Sprite* sprite = gameObject->GetComponent<Sprite>();
+	if (sprite != nullptr)
 	{
-		// If something went horribly wrong deserializing the object, print an error message and return nullptr.
-		std::cout << parseException.what() << std::endl;
-		delete gameObject;
-		return nullptr;
+		sprite->SetMesh(mesh);
+		sprite->SetSpriteSource(spriteSource);
 	}
 
 	return gameObject;
@@ -120,9 +134,26 @@ void GameObjectFactory::SaveObjectToFile(GameObject* object)
 	// Serialize the object.
 	object->Serialize(parser);
 
+	// The file has changed, so it must be read again next time.
+	auto cached = objectCache.find(object->GetName());
+	if (cached != objectCache.end())
+	{
+		delete cached->second;
+		objectCache.erase(cached);
+	}
+
 	std::cout << "Object " + object->GetName() + " has been written to " + filePath << std::endl;
 }
 
+// Forgets every object loaded from a file, so the next CreateObject reads the file again.
+void GameObjectFactory::ClearObjectCache()
+{
+	for (auto it = objectCache.begin(); it != objectCache.end(); ++it)
+		delete it->second;
+
+	objectCache.clear();
+}
+
 // Returns an instance of the factory.
 GameObjectFactory& GameObjectFactory::GetInstance()
 {
@@ -160,6 +191,8 @@ GameObjectFactory::~GameObjectFactory()
 		delete *it;
 		it = registeredComponents.erase(it);
 	}
+
+	ClearObjectCache();
 }
 
 //------------------------------------------------------------------------------
@@ -22,9 +22,62 @@
 // Systems
 #include "Space.h"
 #include <Vector2D.h>
+#include <DebugDraw.h>
+#include <Graphics.h>
+#include "ModuleRegistry.h"
+#include "JobSystem.h"
+#include "Intersection2D.h"
+#include "GJK.h"
 
 // Components
 #include "Collider.h"
+#include "Transform.h"
+#include "Physics.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// How many objects each fixed update job steps.
+	const size_t fixedUpdateBatchSize = 64;
+
+	// How many collider pairs each collision job tests.
+	const size_t collisionBatchSize = 256;
+
+	// Gets the handle indices of the objects two colliders belong to, smallest first.
+	std::pair<unsigned, unsigned> GetContactKey(const Collider& collider1, const Collider& collider2)
+	{
+		unsigned index1 = collider1.GetOwner()->GetHandle().index;
+		unsigned index2 = collider2.GetOwner()->GetHandle().index;
+		return index1 < index2 ? std::make_pair(index1, index2) : std::make_pair(index2, index1);
+	}
+
+	// Checks whether testing against a collider moves the other object out of it,
+	// which means its pairs have to be tested one at a time.
+	bool IsResolvedWhileTesting(const Collider& collider)
+	{
+		return collider.GetType() == ColliderTypeLines || collider.GetType() == ColliderTypeTilemap;
+	}
+
+	// Calls a function for every index in a range, in parallel if a job system has been registered.
+	// Params:
+	//   count = How many indices there are.
+	//   batchSize = How many indices each job handles.
+	//   function = The function to call for each index.
+	template<typename Function>
+	void ParallelFor(size_t count, size_t batchSize, const Function& function)
+	{
+		JobSystem* jobSystem = ModuleRegistry::FindModule<JobSystem>();
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(count, batchSize, function);
+			return;
+		}
+
+		for (size_t i = 0; i < count; i++)
+			function(i);
+	}
+}
 
 //------------------------------------------------------------------------------
 
@@ -38,7 +91,8 @@
 
 // Constructor(s)
 GameObjectManager::GameObjectManager(Space* space) : BetaObject("GameObjectmanager", space),
-	fixedUpdateDt(1.0f / 60.0f), maxFixedUpdateTime(0.2f), timeAccumulator(0.0f)
+	collisionStep(0), collisionQueriesDirty(true), awakeBodyCount(0), sleepingBodyCount(0), sleepingPairCount(0),
+	fixedUpdateDt(1.0f / 60.0f), maxFixedUpdateTime(0.2f), timeAccumulator(0.0f), droppedTime(0.0f), droppedFrames(0)
 {
 }
 
@@ -59,6 +113,7 @@ void GameObjectManager::Update(float dt)
 	{
 		VariableUpdate(dt);
 		FixedUpdate(dt);
+		collisionQueriesDirty = true;
 	}
 
 	DestroyObjects();
@@ -69,6 +124,10 @@ void GameObjectManager::Update(float dt)
 // Shutdown the game object manager, destroying all active objects.
 void GameObjectManager::Shutdown(void)
 {
+	// The colliders are about to be deleted along with their objects.
+	contacts.clear();
+	collisionQueries.Clear();
+
 	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end(); it++)
 	{
 		delete *it;
@@ -96,6 +155,7 @@ void GameObjectManager::AddObject(GameObject& gameObject)
 	gameObjectActiveList.push_back(&gameObject);
 	gameObject.SetParent(GetParent());
 	gameObject.Initialize();
+	collisionQueriesDirty = true;
 }
 
 // Add a game object to the game object archetype list.
@@ -161,6 +221,126 @@ unsigned GameObjectManager::GetObjectCount(const std::string& objectName) const
 	return count;
 }
 
+// Gets the contact manifold between two objects that were touching in the last fixed step.
+// The manifold is only computed the first time it is asked for after each step, from the
+// colliders' current positions, so this should be called from the main thread.
+// Params:
+//   object1 = The first object. The normal points away from this object.
+//   object2 = The second object.
+//   manifold = The manifold, only valid if this returns true.
+// Returns:
+//   True if the objects are touching and both have convex colliders, false otherwise.
+bool GameObjectManager::GetContactManifold(GameObject& object1, GameObject& object2, ContactManifold& manifold) const
+{
+	const Collider* collider1 = object1.GetComponent<Collider>();
+	const Collider* collider2 = object2.GetComponent<Collider>();
+	if (collider1 == nullptr || collider2 == nullptr)
+		return false;
+
+	auto it = contacts.find(GetContactKey(*collider1, *collider2));
+	if (it == contacts.end())
+		return false;
+
+	// Most contacts are never asked for, so the manifold (GJK, EPA, and clipping) waits until one is.
+	const Contact& contact = it->second;
+	if (!contact.manifoldCurrent)
+	{
+		contact.hasManifold = contact.collider1->GetContact(*contact.collider2, contact.manifold, &contact.cache);
+		contact.manifoldCurrent = true;
+	}
+
+	if (!contact.hasManifold)
+		return false;
+
+	// The stored normal points away from the contact's first collider.
+	manifold = contact.manifold;
+	if (contact.collider1 != collider1)
+		manifold.normal = -manifold.normal;
+
+	return true;
+}
+
+// Gets the raycast, overlap, and nearest-collider queries for this space. They see the
+// colliders as they were at the end of the last update, and can be used from any thread
+// as long as the objects aren't being updated. The snapshot is only rebuilt by the first
+// call after the objects have changed, so paused spaces and spaces nobody queries skip it.
+const CollisionQueries& GameObjectManager::GetCollisionQueries() const
+{
+	// Several jobs may ask for the queries at once, but only one should rebuild them.
+	std::lock_guard<std::mutex> lock(collisionQueriesMutex);
+	if (collisionQueriesDirty)
+	{
+		collisionQueries.Rebuild(gameObjectActiveList);
+		collisionQueriesDirty = false;
+	}
+
+	return collisionQueries;
+}
+
+// Sets how many fixed (physics) steps run per second of game time.
+// Params:
+//   stepsPerSecond = The fixed update rate, 60 by default.
+void GameObjectManager::SetFixedUpdateRate(float stepsPerSecond)
+{
+	if (stepsPerSecond <= 0.0f)
+		return;
+
+	fixedUpdateDt = 1.0f / stepsPerSecond;
+}
+
+// Gets the length of a fixed step, in seconds.
+float GameObjectManager::GetFixedUpdateDt() const
+{
+	return fixedUpdateDt;
+}
+
+// Sets the most game time the fixed steps will try to catch up on in one frame.
+// Anything past this is dropped, so a slow frame can't cause an ever-growing backlog.
+// Params:
+//   maxTime = The most time simulated per frame, in seconds.
+void GameObjectManager::SetMaxFixedUpdateTime(float maxTime)
+{
+	maxFixedUpdateTime = maxTime;
+}
+
+// Gets the total game time, in seconds, that was dropped instead of simulated.
+float GameObjectManager::GetDroppedFixedUpdateTime() const
+{
+	return droppedTime;
+}
+
+// Gets how many frames had to drop game time.
+unsigned GameObjectManager::GetDroppedFixedUpdateFrames() const
+{
+	return droppedFrames;
+}
+
+// Gets how far the current frame is between the last fixed step and the next one.
+// Returns:
+//   A value from 0 to 1, used to blend the previous and current physics state when drawing.
+float GameObjectManager::GetInterpolationAlpha() const
+{
+	return min(timeAccumulator / fixedUpdateDt, 1.0f);
+}
+
+// Gets how many physics bodies were awake after the last fixed step.
+unsigned GameObjectManager::GetAwakeBodyCount() const
+{
+	return awakeBodyCount;
+}
+
+// Gets how many physics bodies were asleep after the last fixed step.
+unsigned GameObjectManager::GetSleepingBodyCount() const
+{
+	return sleepingBodyCount;
+}
+
+// Gets how many collider pairs were skipped in the last fixed step because both bodies were asleep.
+unsigned GameObjectManager::GetSleepingPairCount() const
+{
+	return sleepingPairCount;
+}
+
 // Update object logic using variable timestep.
 void GameObjectManager::VariableUpdate(float dt)
 {
@@ -175,19 +355,32 @@ void GameObjectManager::FixedUpdate(float dt)
 {
 	timeAccumulator += dt;
 
-	// Clamp the time accumulator so the engine never freezes due to too many collisions.
+	// Clamp the time accumulator so the engine never freezes due to too many collisions,
+	// keeping track of how much time is lost so slowdowns show up in stats.
 	if (timeAccumulator > maxFixedUpdateTime)
+	{
+		droppedTime += timeAccumulator - maxFixedUpdateTime;
+		++droppedFrames;
 		timeAccumulator = maxFixedUpdateTime;
+	}
 
 	// Call the FixedUpdate functions the appropriate amount of times.
 	while (timeAccumulator >= fixedUpdateDt)
 	{
+		// Components that only change their own object (such as physics) are stepped in parallel.
+		// The rest run on this thread afterward, since they may use other objects or engine systems.
+		ParallelFor(gameObjectActiveList.size(), fixedUpdateBatchSize, [this](size_t i)
+		{
+			gameObjectActiveList[i]->FixedUpdate(fixedUpdateDt, true);
+		});
+
 		for (size_t i = 0; i < gameObjectActiveList.size(); i++)
 		{
-			gameObjectActiveList[i]->FixedUpdate(fixedUpdateDt);
+			gameObjectActiveList[i]->FixedUpdate(fixedUpdateDt, false);
 		}
 
 		CheckCollisions();
+		UpdateSleeping();
 
 		timeAccumulator -= fixedUpdateDt;
 	}
@@ -196,6 +389,9 @@ void GameObjectManager::FixedUpdate(float dt)
 // Destroy any objects marked for destruction.
 void GameObjectManager::DestroyObjects()
 {
+	// Let the other objects know their contacts are ending before the colliders go away.
+	RemoveDestroyedContacts();
+
 	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end();)
 	{
 		// If the object is destroyed, delete it and erase it from the vector.
@@ -203,6 +399,9 @@ void GameObjectManager::DestroyObjects()
 		{
 			delete *it;
 			it = gameObjectActiveList.erase(it);
+
+			// The snapshot may point at the deleted object.
+			collisionQueriesDirty = true;
 		}
 		else
 		{
@@ -214,47 +413,276 @@ void GameObjectManager::DestroyObjects()
 // Draw all game objects in the active game object list.
 void GameObjectManager::Draw(void)
 {
+	// Draw moving objects between their last two fixed steps, so motion stays smooth
+	// when the frame rate and the fixed update rate don't match.
+	float alpha = GetInterpolationAlpha();
+
 	for (size_t i = 0; i < gameObjectActiveList.size(); i++)
 	{
+		Transform* transform = gameObjectActiveList[i]->GetComponent<Transform>();
+		if (transform != nullptr)
+			transform->Interpolate(alpha);
+
 		gameObjectActiveList[i]->Draw();
 	}
+
+	// Colliders and intersection tests only append to the debug line list, so
+	// submit everything gathered this frame as a single strip for the current camera.
+	DebugDraw& debugDraw = DebugDraw::GetInstance();
+	if (debugDraw.IsEnabled())
+		debugDraw.EndLineStrip(Graphics::GetInstance().GetCurrentCamera());
 }
 
 // Check for collisions between each pair of objects.
 void GameObjectManager::CheckCollisions()
 {
-	// Iterate over every object.
+	sleepingPairCount = 0;
+
+	// Find the collider on every object that isn't marked for destruction.
+	stepColliders.clear();
+	stepVersions.clear();
 	for (size_t i = 0; i < gameObjectActiveList.size(); i++)
 	{
-		// If the current object is marked for destruction, skip it.
 		if (gameObjectActiveList[i]->IsDestroyed())
 			continue;
 
-		// Get the current object's collider.
 		Collider* collider = gameObjectActiveList[i]->GetComponent<Collider>();
-
-		// If the current object does not have a collider, skip it.
 		if (collider == nullptr)
 			continue;
 
-		// Iterate over all remaining objects.
-		for (size_t j = i + 1; j < gameObjectActiveList.size(); j++)
+		// Build the cached matrices and world space shape now, so the parallel tests only read them.
+		if (!IsResolvedWhileTesting(*collider))
 		{
-			// If the current object is marked for destruction, skip it.
-			if (gameObjectActiveList[j]->IsDestroyed())
-				continue;
+			SupportShape shape;
+			collider->transform->GetMatrix();
+			collider->transform->GetInverseMatrix();
+			collider->GetSupportShape(shape);
+		}
+
+		collider->BeginCollisionStep();
+		stepColliders.push_back(collider);
+		stepVersions.push_back(collider->transform->GetMatrixVersion());
+	}
+
+	// Every pair of colliders, in the order their events are sent.
+	collisionPairs.clear();
+	for (size_t i = 0; i < stepColliders.size(); i++)
+	{
+		for (size_t j = i + 1; j < stepColliders.size(); j++)
+		{
+			CollisionPair pair = { stepColliders[i], stepColliders[j], stepVersions[i], stepVersions[j], PairUntested };
+			collisionPairs.push_back(pair);
+		}
+	}
+
+	// Test the pairs in parallel. Sleeping pairs aren't tested, and pairs that move objects
+	// while testing are left for the loop below. Drawing the tests isn't thread safe either.
+	if (!IsCollisionDebugDrawEnabled())
+	{
+		ParallelFor(collisionPairs.size(), collisionBatchSize, [this](size_t i)
+		{
+			CollisionPair& pair = collisionPairs[i];
+			const Collider& collider = *pair.collider1;
+			const Collider& collider2 = *pair.collider2;
+			if ((collider.IsAsleep() && collider2.IsAsleep()) || IsResolvedWhileTesting(collider) || IsResolvedWhileTesting(collider2))
+				return;
+
+			bool touching = collider.IsCollidingWith(collider2) || collider.IsSweptCollidingWith(collider2);
+			pair.state = touching ? PairTouching : PairSeparate;
+		});
+	}
 
-			// Get the current object's collider.
-			Collider* collider2 = gameObjectActiveList[j]->GetComponent<Collider>();
+	// Update contacts and send events one pair at a time, in the same order as testing every pair
+	// serially, since resolving lines and tilemaps and running handlers can move objects.
+	for (auto pairIt = collisionPairs.begin(); pairIt != collisionPairs.end(); ++pairIt)
+	{
+		Collider* collider = pairIt->collider1;
+		Collider* collider2 = pairIt->collider2;
+
+		// An earlier collision handler may have destroyed one of the objects.
+		if (collider->GetOwner()->IsDestroyed() || collider2->GetOwner()->IsDestroyed())
+			continue;
+
+		ContactKey key = GetContactKey(*collider, *collider2);
+
+		// Neither collider has moved since it was last tested (a sleeping body, or a still collider
+		// without one), so whatever contact they had still holds.
+		if (collider->IsAsleep() && collider2->IsAsleep())
+		{
+			++sleepingPairCount;
 
-			// If the current object does not have a collider, skip it.
-			if (collider2 == nullptr)
+			auto it = contacts.find(key);
+			if (it == contacts.end())
 				continue;
 
-			// Check for collisions between the two objects.
-			collider->CheckCollision(*collider2);
+			it->second.lastStep = collisionStep;
+			collider->SendCollisionEvent(CollisionEventStay, *collider2);
+			collider2->SendCollisionEvent(CollisionEventStay, *collider);
+			continue;
 		}
+
+		// Check for collisions between the two objects, including fast objects that passed through each other.
+		// The parallel result only holds if neither object has been moved by an earlier pair or handler.
+		bool touching;
+		if (pairIt->state != PairUntested && collider->transform->GetMatrixVersion() == pairIt->version1
+			&& collider2->transform->GetMatrixVersion() == pairIt->version2)
+			touching = pairIt->state == PairTouching;
+		else
+			touching = collider->IsCollidingWith(*collider2) || collider->IsSweptCollidingWith(*collider2);
+
+		if (!touching)
+			continue;
+
+		// Find the pair's contact from the last step, or start a new one.
+		auto it = contacts.find(key);
+		bool entered = it == contacts.end();
+		if (entered)
+		{
+			it = contacts.insert(std::make_pair(key, Contact())).first;
+
+			bool swapped = collider->GetOwner()->GetHandle().index != key.first;
+			it->second.collider1 = swapped ? collider2 : collider;
+			it->second.collider2 = swapped ? collider : collider2;
+		}
+
+		Contact& contact = it->second;
+		contact.lastStep = collisionStep;
+		contact.manifoldCurrent = false;
+
+		// Run collision event handlers if they exist.
+		if (entered)
+		{
+			collider->SendCollisionEvent(CollisionEventEnter, *collider2);
+			collider2->SendCollisionEvent(CollisionEventEnter, *collider);
+		}
+
+		collider->SendCollisionEvent(CollisionEventStay, *collider2);
+		collider2->SendCollisionEvent(CollisionEventStay, *collider);
 	}
+
+	// Any contact that wasn't touched this step has ended.
+	for (auto it = contacts.begin(); it != contacts.end();)
+	{
+		if (it->second.lastStep != collisionStep)
+		{
+			it->second.collider1->SendCollisionEvent(CollisionEventExit, *it->second.collider2);
+			it->second.collider2->SendCollisionEvent(CollisionEventExit, *it->second.collider1);
+			it = contacts.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	++collisionStep;
+}
+
+// Sends exit events for, and forgets, every contact involving a destroyed object.
+void GameObjectManager::RemoveDestroyedContacts()
+{
+	for (auto it = contacts.begin(); it != contacts.end();)
+	{
+		const Collider& collider1 = *it->second.collider1;
+		const Collider& collider2 = *it->second.collider2;
+
+		if (collider1.GetOwner()->IsDestroyed() || collider2.GetOwner()->IsDestroyed())
+		{
+			collider1.SendCollisionEvent(CollisionEventExit, collider2);
+			collider2.SendCollisionEvent(CollisionEventExit, collider1);
+			it = contacts.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+// Groups touching physics bodies into islands, then puts islands where every
+// body is resting to sleep and wakes islands where any body is moving.
+void GameObjectManager::UpdateSleeping()
+{
+	sleepBodies.clear();
+	for (size_t i = 0; i < gameObjectActiveList.size(); i++)
+	{
+		if (gameObjectActiveList[i]->IsDestroyed())
+			continue;
+
+		Physics* physics = gameObjectActiveList[i]->GetComponent<Physics>();
+		if (physics != nullptr)
+			sleepBodies.push_back(physics);
+	}
+
+	// Sort the bodies so the ones in each contact can be found with a binary search.
+	std::sort(sleepBodies.begin(), sleepBodies.end());
+
+	islandParents.resize(sleepBodies.size());
+	for (size_t i = 0; i < islandParents.size(); i++)
+		islandParents[i] = i;
+
+	// Touching bodies share an island. Colliders without physics never move,
+	// so they don't join the islands of the bodies resting on them.
+	for (auto it = contacts.begin(); it != contacts.end(); ++it)
+	{
+		Physics* physics1 = it->second.collider1->physics;
+		Physics* physics2 = it->second.collider2->physics;
+		if (physics1 == nullptr || physics2 == nullptr)
+			continue;
+
+		auto body1 = std::lower_bound(sleepBodies.begin(), sleepBodies.end(), physics1);
+		auto body2 = std::lower_bound(sleepBodies.begin(), sleepBodies.end(), physics2);
+		if (body1 == sleepBodies.end() || *body1 != physics1 || body2 == sleepBodies.end() || *body2 != physics2)
+			continue;
+
+		size_t island1 = FindIsland(body1 - sleepBodies.begin());
+		size_t island2 = FindIsland(body2 - sleepBodies.begin());
+		islandParents[island1] = island2;
+	}
+
+	// An island can only sleep once every body in it is resting.
+	islandsMoving.assign(sleepBodies.size(), false);
+	for (size_t i = 0; i < sleepBodies.size(); i++)
+	{
+		if (!sleepBodies[i]->IsResting())
+			islandsMoving[FindIsland(i)] = true;
+	}
+
+	awakeBodyCount = 0;
+	sleepingBodyCount = 0;
+	for (size_t i = 0; i < sleepBodies.size(); i++)
+	{
+		Physics& body = *sleepBodies[i];
+		if (islandsMoving[FindIsland(i)])
+		{
+			if (body.IsAsleep())
+				body.Wake();
+
+			++awakeBodyCount;
+		}
+		else
+		{
+			body.Sleep();
+			++sleepingBodyCount;
+		}
+	}
+}
+
+// Finds the island a body belongs to.
+// Params:
+//   body = The index of the body in sleepBodies.
+// Returns:
+//   The index of the first body in the island.
+size_t GameObjectManager::FindIsland(size_t body)
+{
+	while (islandParents[body] != body)
+	{
+		// Point each body we pass at its grandparent, so later searches are shorter.
+		islandParents[body] = islandParents[islandParents[body]];
+		body = islandParents[body];
+	}
+
+	return body;
 }
 
 //------------------------------------------------------------------------------
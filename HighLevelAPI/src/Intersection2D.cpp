@@ -16,6 +16,7 @@
 #include "stdafx.h"
 
 #include "Intersection2D.h"
+#include "IntersectionSIMD.h"
 
 // Components
 #include "Transform.h"
@@ -32,6 +33,287 @@
 
 //------------------------------------------------------------------------------
 
+namespace
+{
+	// SAT policy that draws nothing. The hooks take raw values and do no work,
+	// so none of the drawing math survives in the hot path.
+	struct SATSilent
+	{
+		void DrawAxis(const Vector2D&) {}
+		void DrawProjection(const Vector2D&, const Vector2D&, float, float) {}
+		void DrawGap(const Vector2D&, float, float) {}
+		void DrawNormal(const Vector2D&) {}
+		void DrawExtents(const Vector2D&, float, float) {}
+	};
+
+#ifdef _DEBUG
+	// SAT policy that forwards everything to DebugDraw using the current camera.
+	struct SATVisualizer
+	{
+		SATVisualizer()
+			: debugDraw(DebugDraw::GetInstance()), camera(Graphics::GetInstance().GetCurrentCamera())
+		{
+		}
+
+		// Draws an axis being tested.
+		void DrawAxis(const Vector2D& axis)
+		{
+			debugDraw.AddLineToStrip(-400.0f * axis, 400.0f * axis, Colors::LightBlue);
+		}
+
+		// Draws a point (optionally widened by a radius) being projected onto an axis.
+		void DrawProjection(const Vector2D& point, const Vector2D& axis, float projection, float radius)
+		{
+			if (radius == 0.0f)
+			{
+				debugDraw.AddLineToStrip(point, axis * projection, Colors::Yellow);
+				debugDraw.AddCircle(axis * projection, 4.0f, camera, Colors::Violet);
+				return;
+			}
+
+			debugDraw.AddLineToStrip(point - axis * radius, axis * (projection - radius), Colors::Yellow);
+			debugDraw.AddCircle(axis * (projection - radius), 4.0f, camera, Colors::Violet);
+			debugDraw.AddLineToStrip(point + axis * radius, axis * (projection + radius), Colors::Yellow);
+			debugDraw.AddCircle(axis * (projection + radius), 4.0f, camera, Colors::Violet);
+		}
+
+		// Draws the gap found along a separating axis.
+		void DrawGap(const Vector2D& axis, float start, float gap)
+		{
+			debugDraw.AddLineToStrip(start * axis, (start + gap) * axis, Colors::Red);
+		}
+
+		// Draws a normal a polygon is being projected onto.
+		void DrawNormal(const Vector2D& normal)
+		{
+			debugDraw.AddLineToStrip(-normal * 800, normal * 800, Colors::Violet);
+		}
+
+		// Draws the extents of a polygon projected onto a normal.
+		void DrawExtents(const Vector2D& normal, float minValue, float maxValue)
+		{
+			debugDraw.AddCircle(normal * minValue, 10, camera, Colors::Yellow);
+			debugDraw.AddCircle(normal * maxValue, 10, camera, Colors::Yellow);
+		}
+
+		DebugDraw& debugDraw;
+		Camera& camera;
+	};
+#endif
+
+	// Separating axis test kernel shared by the silent and visualizing variants.
+	// Params:
+	//   draw = The drawing policy (SATSilent or SATVisualizer).
+	//   (Remaining parameters match SATIntersection.)
+	// Returns:
+	//   True if intersection, false otherwise.
+	template <typename DrawPolicy>
+	bool SATIntersection(DrawPolicy& draw, const Vector2D* axes, size_t axesSize, const Vector2D* points1, size_t points1Size, const Vector2D* points2, size_t points2Size, float radius)
+	{
+		// Draw the axes' lines.
+		for (unsigned i = 0; i < axesSize; i++)
+		{
+			draw.DrawAxis(axes[i]);
+		}
+
+		// Loop through each axis.
+		for (unsigned i = 0; i < axesSize; i++)
+		{
+			float minExtents1 = FLT_MAX;
+			float maxExtents1 = -FLT_MAX;
+			float minExtents2 = FLT_MAX;
+			float maxExtents2 = -FLT_MAX;
+
+			for (unsigned j = 0; j < points1Size; j++)
+			{
+				// Project the current point along the current axis.
+				float projectedPoint = points1[j].DotProduct(axes[i]);
+
+				// Draw the point being projected along the current axis.
+				draw.DrawProjection(points1[j], axes[i], projectedPoint, 0.0f);
+
+				// Update the min/max extents of each convex hull.
+				maxExtents1 = max(maxExtents1, projectedPoint);
+				minExtents1 = min(minExtents1, projectedPoint);
+			}
+
+			for (unsigned j = 0; j < points2Size; j++)
+			{
+				// Project the current point along the current axis.
+				float projectedPoint = points2[j].DotProduct(axes[i]);
+
+				// Draw the point being projected along the current axis.
+				draw.DrawProjection(points2[j], axes[i], projectedPoint, radius);
+
+				// Update the min/max extents of each convex hull.
+				maxExtents2 = max(maxExtents2, projectedPoint);
+				minExtents2 = min(minExtents2, projectedPoint);
+			}
+
+			float gap1 = (minExtents2 - radius) - maxExtents1;
+			float gap2 = minExtents1 - (maxExtents2 + radius);
+			float gap = max(gap1, gap2);
+
+			// If there is a gap between the min and max extents on this axis, the convex hulls are not colliding.
+			if (gap > 0)
+			{
+				// Draw the gap along the separating axis.
+				draw.DrawGap(axes[i], gap1 > gap2 ? maxExtents1 : maxExtents2 + radius, gap);
+				return false;
+			}
+		}
+
+		// If we reached this point, there is no gap, the OBBs are colliding.
+		return true;
+	}
+
+	// Polygon projection kernel shared by the silent and visualizing variants.
+	// Params:
+	//   draw = The drawing policy (SATSilent or SATVisualizer).
+	//   (Remaining parameters match ProjectPolygon.)
+	template <typename DrawPolicy>
+	void ProjectPolygon(DrawPolicy& draw, const Vector2D& normal, const std::vector<Vector2D>& vertices, float& minValue, float& maxValue)
+	{
+		// Get the minimum and maximum projetions of the first polygon in the line
+		minValue = FLT_MAX;
+		maxValue = -FLT_MAX;
+
+		// Draw the normal
+		draw.DrawNormal(normal);
+
+		// Project the vertex into the normal and save the edges of the first projecte polygon into the line
+		// minimum and maximum
+		for (auto vertex = vertices.cbegin(); vertex < vertices.cend(); ++vertex)
+		{
+			float projection = vertex->DotProduct(normal);
+			minValue = min(minValue, projection);
+			maxValue = max(maxValue, projection);
+		}
+
+		draw.DrawExtents(normal, minValue, maxValue);
+	}
+
+	// Separating axis test that uses two sets of axes in place, skipping any axis that is
+	// parallel to one that was already tested. Does not allocate.
+	// Params:
+	//   draw = The drawing policy (SATSilent or SATVisualizer).
+	//   axes1 = The first set of axes (usually the edge normals of the first hull).
+	//   axes1Size = How many axes are in the first set.
+	//   axes2 = The second set of axes.
+	//   axes2Size = How many axes are in the second set.
+	//   (Remaining parameters match SATIntersection.)
+	// Returns:
+	//   True if intersection, false otherwise.
+	template <typename DrawPolicy>
+	bool SATHullIntersection(DrawPolicy& draw, const Vector2D* axes1, size_t axes1Size, const Vector2D* axes2, size_t axes2Size,
+		const Vector2D* points1, size_t points1Size, const Vector2D* points2, size_t points2Size, float radius)
+	{
+		const size_t axesSize = axes1Size + axes2Size;
+
+		for (size_t i = 0; i < axesSize; ++i)
+		{
+			const Vector2D& axis = i < axes1Size ? axes1[i] : axes2[i - axes1Size];
+
+			// Skip the axis if an equivalent one has already been tested.
+			bool duplicate = false;
+			for (size_t j = 0; j < i && !duplicate; ++j)
+			{
+				duplicate = AreAxesParallel(axis, j < axes1Size ? axes1[j] : axes2[j - axes1Size]);
+			}
+
+			if (duplicate)
+				continue;
+
+			if (!SATIntersection(draw, &axis, 1, points1, points1Size, points2, points2Size, radius))
+				return false;
+		}
+
+		return true;
+	}
+
+	// Smallest hull worth projecting several points at a time.
+	const size_t minSIMDHullSize = 4;
+
+	// Picks the visualizing or silent variant of SATHullIntersection.
+	bool SATHullIntersection(const Vector2D* axes1, size_t axes1Size, const Vector2D* axes2, size_t axes2Size,
+		const Vector2D* points1, size_t points1Size, const Vector2D* points2, size_t points2Size, float radius = 0.0f)
+	{
+#ifdef _DEBUG
+		if (IsCollisionDebugDrawEnabled())
+		{
+			SATVisualizer visualizer;
+			return SATHullIntersection(visualizer, axes1, axes1Size, axes2, axes2Size, points1, points1Size, points2, points2Size, radius);
+		}
+#endif
+
+		SATSilent silent;
+		return SATHullIntersection(silent, axes1, axes1Size, axes2, axes2Size, points1, points1Size, points2, points2Size, radius);
+	}
+
+	// Whether a convex collider should take the SIMD path, which uses the structure of arrays
+	// copies cached on the collider. Debug drawing needs the plain path to visualize the test.
+	bool UseSIMDPath(const ColliderConvex& convex)
+	{
+#ifdef _DEBUG
+		if (IsCollisionDebugDrawEnabled())
+			return false;
+#endif
+
+		return convex.GetWorldVertices().size() >= minSIMDHullSize;
+	}
+
+	// Finds the axis between a circle's center and the closest vertex of a polygon. Besides the
+	// edge normals, it is the only axis that can separate the two.
+	// Params:
+	//   vertices = The world space vertices of the polygon.
+	//   size = How many vertices the polygon has.
+	//   center = The center of the circle.
+	//   axis = The output axis.
+	// Returns:
+	//   False if the center sits right on a vertex, true otherwise.
+	bool GetCircleVertexAxis(const Vector2D* vertices, size_t size, const Vector2D& center, Vector2D& axis)
+	{
+		size_t closest = 0;
+		float closestDistance = FLT_MAX;
+		for (size_t i = 0; i < size; ++i)
+		{
+			const float dx = center.x - vertices[i].x;
+			const float dy = center.y - vertices[i].y;
+			const float distance = dx * dx + dy * dy;
+			if (distance < closestDistance)
+			{
+				closestDistance = distance;
+				closest = i;
+			}
+		}
+
+		if (closestDistance == 0.0f)
+			return false;
+
+		const float inverseDistance = 1.0f / sqrtf(closestDistance);
+		axis = Vector2D((center.x - vertices[closest].x) * inverseDistance, (center.y - vertices[closest].y) * inverseDistance);
+		return true;
+	}
+
+	// Splits line segments into their end points and normals.
+	// Params:
+	//   segments = The line segments of a convex polygon.
+	//   vertices = The output vertices.
+	//   normals = The output normals.
+	void SplitSegments(const std::vector<LineSegment>& segments, std::vector<Vector2D>& vertices, std::vector<Vector2D>& normals)
+	{
+		vertices.reserve(segments.size());
+		normals.reserve(segments.size());
+		for (auto begin = segments.cbegin(); begin < segments.cend(); ++begin)
+		{
+			vertices.push_back(begin->end);
+			normals.push_back(begin->normal);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Function Declarations:
 //------------------------------------------------------------------------------
@@ -108,6 +390,17 @@ bool RectangleCircleIntersection(const BoundingRectangle& rect, const Circle& ci
 	return point.DistanceSquared(circle.center) <= circle.radius * circle.radius;
 }
 
+// Returns whether separating axis tests are currently being visualized. They are drawn
+// in debug builds whenever DebugDraw is enabled, along with the colliders themselves.
+bool IsCollisionDebugDrawEnabled()
+{
+#ifdef _DEBUG
+	return DebugDraw::GetInstance().IsEnabled();
+#else
+	return false;
+#endif
+}
+
 // Checks for an intersection using the separating axis theorem.
 // Params:
 //   axes = The array of axes to check.
@@ -122,87 +415,15 @@ bool RectangleCircleIntersection(const BoundingRectangle& rect, const Circle& ci
 bool SATIntersection(const Vector2D* axes, size_t axesSize, const Vector2D* points1, size_t points1Size, const Vector2D* points2, size_t points2Size, float radius)
 {
 #ifdef _DEBUG
-	DebugDraw& debugDraw = DebugDraw::GetInstance();
-	Camera& currentCamera = Graphics::GetInstance().GetCurrentCamera();
-
-	// Draw the axes' lines.
-	for (unsigned i = 0; i < axesSize; i++)
+	if (IsCollisionDebugDrawEnabled())
 	{
-		debugDraw.AddLineToStrip(-400.0f * axes[i], 400.0f * axes[i], Colors::LightBlue);
+		SATVisualizer visualizer;
+		return SATIntersection(visualizer, axes, axesSize, points1, points1Size, points2, points2Size, radius);
 	}
-	debugDraw.EndLineStrip(currentCamera);
-#endif
-
-	// Loop through each axis.
-	for (unsigned i = 0; i < axesSize; i++)
-	{
-		float minExtents1 = FLT_MAX;
-		float maxExtents1 = -FLT_MAX;
-		float minExtents2 = FLT_MAX;
-		float maxExtents2 = -FLT_MAX;
-
-		for (unsigned j = 0; j < points1Size; j++)
-		{
-			// Project the current point along the current axis.
-			float projectedPoint = points1[j].DotProduct(axes[i]);
-			
-#ifdef _DEBUG
-			// Draw the point being projected along the current axis.
-			debugDraw.AddLineToStrip(points1[j], axes[i] * projectedPoint, Colors::Yellow);
-			debugDraw.AddCircle(axes[i] * projectedPoint, 4.0f, currentCamera, Colors::Violet);
-#endif
-
-			// Update the min/max extents of each convex hull.
-			maxExtents1 = max(maxExtents1, projectedPoint);
-			minExtents1 = min(minExtents1, projectedPoint);
-		}
-
-		for (unsigned j = 0; j < points2Size; j++)
-		{
-			// Project the current point along the current axis.
-			float projectedPoint = points2[j].DotProduct(axes[i]);
-
-#ifdef _DEBUG
-			// Draw the point being projected along the current axis.
-			debugDraw.AddLineToStrip(points2[j] - axes[i] * radius, axes[i] * (projectedPoint - radius), Colors::Yellow);
-			debugDraw.AddCircle(axes[i] * (projectedPoint - radius), 4.0f, currentCamera, Colors::Violet);
-			debugDraw.AddLineToStrip(points2[j] + axes[i] * radius, axes[i] * (projectedPoint + radius), Colors::Yellow);
-			debugDraw.AddCircle(axes[i] * (projectedPoint + radius), 4.0f, currentCamera, Colors::Violet);
 #endif
 
-			// Update the min/max extents of each convex hull.
-			maxExtents2 = max(maxExtents2, projectedPoint);
-			minExtents2 = min(minExtents2, projectedPoint);
-		}
-
-#ifdef _DEBUG
-		debugDraw.EndLineStrip(currentCamera);
-#endif
-
-		float gap1 = (minExtents2 - radius) - maxExtents1;
-		float gap2 = minExtents1 - (maxExtents2 + radius);
-		float gap = max(gap1, gap2);
-
-		// If there is a gap between the min and max extents on this axis, the convex hulls are not colliding.
-		if (gap > 0)
-		{
-#ifdef _DEBUG
-			if (gap1 > gap2)
-			{
-				debugDraw.AddLineToStrip(maxExtents1 * axes[i], (maxExtents1 + gap) * axes[i], Colors::Red);
-			}
-			else
-			{
-				debugDraw.AddLineToStrip((maxExtents2 + radius) * axes[i], ((maxExtents2 + radius) + gap) * axes[i], Colors::Red);
-			}
-			debugDraw.EndLineStrip(currentCamera);
-#endif
-			return false;
-		}
-	}
-
-	// If we reached this point, there is no gap, the OBBs are colliding.
-	return true;
+	SATSilent silent;
+	return SATIntersection(silent, axes, axesSize, points1, points1Size, points2, points2Size, radius);
 }
 
 // Calculates the (object space) corner points of a rectangle.
@@ -232,8 +453,7 @@ void GetOBBCorners(const ColliderRectangle& rect, Vector2D out[4])
 //   pointsSize = How many elements are in the array.
 void ApplyTransformToPoints(const CS230::Matrix2D& matrix, Vector2D* points, unsigned pointsSize)
 {
-	for (unsigned i = 0; i < pointsSize; i++)
-		points[i] = matrix * points[i];
+	matrix.TransformPoints(points, points, pointsSize);
 }
 
 // Check whether two oriented bounding boxes intersect.
@@ -244,30 +464,16 @@ void ApplyTransformToPoints(const CS230::Matrix2D& matrix, Vector2D* points, uns
 //   True if intersection, false otherwise.
 bool OBBOBBIntersection(const ColliderRectangle& rect1, const ColliderRectangle& rect2)
 {
-	float angle1 = rect1.transform->GetRotation();
-	float angle2 = rect2.transform->GetRotation();
-
 	Vector2D axes[4];
 
 	// Calculate all the axes we need to check for gaps along.
-	axes[0] = Vector2D(cos(angle1), sin(angle1));
+	axes[0] = rect1.transform->GetRotationDirection();
 	axes[1] = Vector2D(-axes[0].y, axes[0].x);
-	axes[2] = Vector2D(cos(angle2), sin(angle2));
+	axes[2] = rect2.transform->GetRotationDirection();
 	axes[3] = Vector2D(-axes[2].y, axes[2].x);
 
-	Vector2D points1[4];
-	Vector2D points2[4];
-
-	// Gather the points for both rectangles.
-	GetOBBCorners(rect1, points1);
-	GetOBBCorners(rect2, points2);
-
-	// Apply the transformation matrices to the rectangles' points.
-	ApplyTransformToPoints(rect1.transform->GetMatrix(), points1, 4);
-	ApplyTransformToPoints(rect2.transform->GetMatrix(), points2, 4);
-
-	// Perform the intersection test.
-	return SATIntersection(axes, 4, points1, 4, points2, 4);
+	// Perform the intersection test with the rectangles' cached world space corners.
+	return SATIntersection(axes, 4, rect1.GetWorldCorners(), 4, rect2.GetWorldCorners(), 4);
 }
 
 // Check whether an oriented bounding box and a point intersect.
@@ -278,25 +484,15 @@ bool OBBOBBIntersection(const ColliderRectangle& rect1, const ColliderRectangle&
 //   True if intersection, false otherwise.
 bool OBBPointIntersection(const ColliderRectangle& rect, const Vector2D& point)
 {
-	float angle1 = rect.transform->GetRotation();
-
 	Vector2D axes[3];
 
 	// Calculate all the axes we need to check for gaps along.
-	axes[0] = Vector2D(cos(angle1), sin(angle1));
+	axes[0] = rect.transform->GetRotationDirection();
 	axes[1] = Vector2D(-axes[0].y, axes[0].x);
 	axes[2] = (point - rect.transform->GetTranslation()).Normalized(); // Direction from the rectangle to the point
 
-	Vector2D points[4];
-
-	// Gather the points for the rectangle.
-	GetOBBCorners(rect, points);
-
-	// Apply the transformation matrix to the rectangle's points.
-	ApplyTransformToPoints(rect.transform->GetMatrix(), points, 4);
-
-	// Perform the intersection test.
-	return SATIntersection(axes, 3, points, 4, &point, 1);
+	// Perform the intersection test with the rectangle's cached world space corners.
+	return SATIntersection(axes, 3, rect.GetWorldCorners(), 4, &point, 1);
 }
 
 // Check whether an oriented bounding box and a circle intersect.
@@ -307,25 +503,15 @@ bool OBBPointIntersection(const ColliderRectangle& rect, const Vector2D& point)
 //   True if intersection, false otherwise.
 bool OBBCircleIntersection(const ColliderRectangle& rect, const Circle& circle)
 {
-	float angle1 = rect.transform->GetRotation();
-
 	Vector2D axes[3];
 
 	// Calculate all the axes we need to check for gaps along.
-	axes[0] = Vector2D(cos(angle1), sin(angle1));
+	axes[0] = rect.transform->GetRotationDirection();
 	axes[1] = Vector2D(-axes[0].y, axes[0].x);
 	axes[2] = (circle.center - rect.transform->GetTranslation()).Normalized(); // Direction from the rectangle to the circle
 
-	Vector2D points[4];
-
-	// Gather the points for the rectangle.
-	GetOBBCorners(rect, points);
-	
-	// Apply the transformation matrix to the rectangle's points.
-	ApplyTransformToPoints(rect.transform->GetMatrix(), points, 4);
-
-	// Perform the intersection test.
-	return SATIntersection(axes, 3, points, 4, &circle.center, 1, circle.radius);
+	// Perform the intersection test with the rectangle's cached world space corners.
+	return SATIntersection(axes, 3, rect.GetWorldCorners(), 4, &circle.center, 1, circle.radius);
 }
 
 // Projects a polygon into a normal
@@ -337,34 +523,29 @@ bool OBBCircleIntersection(const ColliderRectangle& rect, const Circle& circle)
 void ProjectPolygon(const Vector2D& normal, const std::vector<Vector2D>& vertices, float& minValue, float& maxValue)
 {
 #ifdef _DEBUG
-	// Debug draw information for every projection
-	DebugDraw& debug = DebugDraw::GetInstance();
-	Camera& currentCamera = Graphics::GetInstance().GetCurrentCamera();
-#endif
-
-	// Get the minimum and maximum projetions of the first polygon in the line
-	minValue = FLT_MAX;
-	maxValue = FLT_MIN;
-
-#ifdef _DEBUG
-	// Draw the normal
-	debug.AddLineToStrip(-normal * 800, normal * 800, Colors::Violet);
-#endif
-
-	// Project the vertex into the normal and save the edges of the first projecte polygon into the line
-	// minimum and maximum
-	for (auto vertex = vertices.cbegin(); vertex < vertices.cend(); ++vertex)
+	if (IsCollisionDebugDrawEnabled())
 	{
-		float projection = vertex->DotProduct(normal);
-		minValue = min(minValue, projection);
-		maxValue = max(maxValue, projection);
+		SATVisualizer visualizer;
+		ProjectPolygon(visualizer, normal, vertices, minValue, maxValue);
+		return;
 	}
-
-#ifdef _DEBUG
-	debug.AddCircle(normal * minValue, 10, currentCamera, Colors::Yellow);
-	debug.AddCircle(normal * maxValue, 10, currentCamera, Colors::Yellow);
-	debug.EndLineStrip(currentCamera);
 #endif
+
+	SATSilent silent;
+	ProjectPolygon(silent, normal, vertices, minValue, maxValue);
+}
+
+// Checks whether two axes are parallel (or anti-parallel), in which case testing both is redundant.
+// Params:
+//	axis1: The first axis
+//	axis2: The second axis
+// Returns:
+//	True if the axes are parallel, false otherwise
+bool AreAxesParallel(const Vector2D& axis1, const Vector2D& axis2)
+{
+	const float cross = axis1.x * axis2.y - axis1.y * axis2.x;
+	const float lengths = (axis1.x * axis1.x + axis1.y * axis1.y) * (axis2.x * axis2.x + axis2.y * axis2.y);
+	return cross * cross <= 0.000001f * lengths;
 }
 
 // Check whether two convex polygons interact
@@ -378,104 +559,169 @@ bool ConvexHullIntersection(const std::vector<LineSegment>& lineSegments1, const
 	// Save the vertices and normals of both line segments
 	std::vector<Vector2D> vertexSet1;
 	std::vector<Vector2D> vertexSet2;
-	std::vector<Vector2D> normalSet;
-	size_t totalSize = lineSegments1.size() + lineSegments2.size();
-	vertexSet1.reserve(totalSize);
-	vertexSet2.reserve(totalSize);
-	normalSet.reserve(totalSize);
+	std::vector<Vector2D> normalSet1;
+	std::vector<Vector2D> normalSet2;
+	SplitSegments(lineSegments1, vertexSet1, normalSet1);
+	SplitSegments(lineSegments2, vertexSet2, normalSet2);
 
-	for (unsigned i = 0; i < totalSize; ++i)
-	{
-		if (i < lineSegments1.size())
-		{
-			vertexSet1.push_back(lineSegments1[i].end);
-			for (unsigned j = 0; j < i; ++j)
-			{
-				if (lineSegments1[i].normal.DotProduct(normalSet[j]) == 0)
-					continue;
-			}
-			normalSet.push_back(lineSegments1[i].normal);
-		}
-		else
-		{
-			vertexSet2.push_back(lineSegments2[i - lineSegments1.size()].end);
-			for (size_t j = i - lineSegments1.size(); j < normalSet.size(); ++j)
-			{
-				if (lineSegments2[i - lineSegments1.size()].normal.DotProduct(normalSet[j]) == 0)
-					continue;
-			}
-			normalSet.push_back(lineSegments2[i - lineSegments1.size()].normal);
-		}
-	}
+	return ConvexHullIntersection(vertexSet1.data(), normalSet1.data(), vertexSet1.size(),
+		vertexSet2.data(), normalSet2.data(), vertexSet2.size());
+}
+
+// Check whether two convex polygons intersect, without allocating.
+// Params:
+//	vertices1: The world space vertices of the first polygon
+//	normals1: The world space edge normals of the first polygon
+//	size1: How many vertices (and normals) the first polygon has
+//	vertices2: The world space vertices of the second polygon
+//	normals2: The world space edge normals of the second polygon
+//	size2: How many vertices (and normals) the second polygon has
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullIntersection(const Vector2D* vertices1, const Vector2D* normals1, size_t size1,
+	const Vector2D* vertices2, const Vector2D* normals2, size_t size2)
+{
+	return SATHullIntersection(normals1, size1, normals2, size2, vertices1, size1, vertices2, size2);
+}
+
+// Check whether two convex colliders intersect, using the world space data cached on them.
+// Params:
+//	convex1: The first convex collider
+//	convex2: The second convex collider
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullIntersection(const ColliderConvex& convex1, const ColliderConvex& convex2)
+{
+	if (UseSIMDPath(convex1) || UseSIMDPath(convex2))
+		return SATIntersection(convex1.GetWorldAxes(), convex2.GetWorldAxes(), convex1.GetWorldPoints(), convex2.GetWorldPoints());
 
-	return SATIntersection(normalSet.data(), normalSet.size(), vertexSet1.data(), vertexSet1.size(), vertexSet2.data(), vertexSet2.size());
+	const std::vector<Vector2D>& vertices1 = convex1.GetWorldVertices();
+	const std::vector<Vector2D>& vertices2 = convex2.GetWorldVertices();
+	return ConvexHullIntersection(vertices1.data(), convex1.GetWorldNormals().data(), vertices1.size(),
+		vertices2.data(), convex2.GetWorldNormals().data(), vertices2.size());
 }
 
 // Check whether a convex polygon interacts with a rectangle collider
 //	Params:
 //	convexSegments: The line segments of the convex polygon
 //	extents: The extents of the rectangle
+//	rectTransform: The transformation of the extents of the rectangle
+// Returns:
+//	True if interesction, false otherwise
 bool ConvexHullToOBBIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& extents, Transform& rectTransform)
 {
-	// Create the line segments so that they are rotated but not scaled
-	// The horizontal end is the same as the vertical side's start
-	Vector2D topLeft(-extents.x, extents.y);
-	Vector2D topRight(extents);
-	Vector2D bottomRight(extents.x, -extents.y);
-	Vector2D bottomLeft(-extents);
+	// Create the corners so that they are rotated but not scaled
+	Vector2D corners[4] = { Vector2D(-extents.x, extents.y), extents, Vector2D(extents.x, -extents.y), -extents };
 
 	// Transform the vertices by the rotation but also scale them back
 	Vector2D translation = rectTransform.GetTranslation();
-	CS230::Matrix2D matrix = CS230::Matrix2D::RotationMatrixRadians(rectTransform.GetRotation()) * CS230::Matrix2D::TranslationMatrix(translation.x, translation.y);
-	topLeft = matrix * topLeft;
-	topRight = matrix * topRight;
-	bottomRight = matrix * bottomRight;
-	bottomLeft = matrix * bottomLeft;
-
-	// Construct a convex hull out of the extents of the circle
-	std::vector<LineSegment> extentSegments;
-	// Because a rectangle has two pairs of parallel sides, then we only need to check for those two sides, lol.
-	extentSegments.reserve(4);
-	extentSegments.push_back(LineSegment(topLeft, topRight));
-	extentSegments.push_back(LineSegment(topRight, bottomRight));
-	extentSegments.push_back(LineSegment(bottomRight, bottomLeft));
-	extentSegments.push_back(LineSegment(bottomLeft, topLeft));
-	// Finally create the 
-	// Then, just use the convex hull collision detection algorithm already written
-	return ConvexHullIntersection(convexSegments, extentSegments);
+	CS230::Matrix2D matrix = CS230::Matrix2D::TranslationMatrix(translation.x, translation.y) * CS230::Matrix2D::RotationMatrixRadians(rectTransform.GetRotation());
+	ApplyTransformToPoints(matrix, corners, 4);
+
+	// Because a rectangle has two pairs of parallel sides, we only need to check two of its axes.
+	Vector2D rectAxes[2];
+	rectAxes[0] = rectTransform.GetRotationDirection();
+	rectAxes[1] = Vector2D(-rectAxes[0].y, rectAxes[0].x);
+
+	std::vector<Vector2D> vertexSet;
+	std::vector<Vector2D> normalSet;
+	SplitSegments(convexSegments, vertexSet, normalSet);
+
+	return SATHullIntersection(normalSet.data(), normalSet.size(), rectAxes, 2, vertexSet.data(), vertexSet.size(), corners, 4);
+}
+
+// Check whether a convex polygon intersects a rectangle collider, without allocating.
+// Params:
+//	vertices: The world space vertices of the convex polygon
+//	normals: The world space edge normals of the convex polygon
+//	size: How many vertices (and normals) the polygon has
+//	rect: The rectangle collider
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToOBBIntersection(const Vector2D* vertices, const Vector2D* normals, size_t size, const ColliderRectangle& rect)
+{
+	// Because a rectangle has two pairs of parallel sides, we only need to check two of its axes.
+	Vector2D rectAxes[2];
+	rectAxes[0] = rect.transform->GetRotationDirection();
+	rectAxes[1] = Vector2D(-rectAxes[0].y, rectAxes[0].x);
+
+	return SATHullIntersection(normals, size, rectAxes, 2, vertices, size, rect.GetWorldCorners(), 4);
+}
+
+// Check whether a convex collider intersects a rectangle collider, using the world space data cached on them.
+// Params:
+//	convex: The convex collider
+//	rect: The rectangle collider
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToOBBIntersection(const ColliderConvex& convex, const ColliderRectangle& rect)
+{
+	if (UseSIMDPath(convex))
+		return SATIntersection(convex.GetWorldAxes(), rect.GetWorldAxes(), convex.GetWorldPoints(), rect.GetWorldCornerPoints());
+
+	const std::vector<Vector2D>& vertices = convex.GetWorldVertices();
+	return ConvexHullToOBBIntersection(vertices.data(), convex.GetWorldNormals().data(), vertices.size(), rect);
 }
 
 // Check whether a circle is colliding with the convex collider
 //	Params:
 //	convexSegments: The line segments of the convex polygon
-//	convexTransform: The transform of the convex figure
+//	convexTransform: The transform of the convex figure (unused, the axes come from the segments)
 //	circle: The circle we are testing against
 // Returns:
 //	True if intersection, false otherwise
 bool ConvexHullToCircleInteresction(const std::vector<LineSegment>& convexSegments, const Transform& convexTransform, const Circle& circle)
 {
+	UNREFERENCED_PARAMETER(convexTransform);
+
 	// Separate our segments into vertices and normals
 	std::vector<Vector2D> vertexSet;
 	std::vector<Vector2D> normalSet;
-	vertexSet.reserve(convexSegments.size());
-	normalSet.reserve(convexSegments.size() + 3);
-	for (auto begin = convexSegments.cbegin(); begin < convexSegments.cend(); ++begin)
-	{
-		vertexSet.push_back(begin->end);
-		normalSet.push_back(begin->normal);
-	}
+	SplitSegments(convexSegments, vertexSet, normalSet);
+
+	return ConvexHullToCircleIntersection(vertexSet.data(), normalSet.data(), vertexSet.size(), circle);
+}
+
+// Check whether a convex polygon intersects a circle, without allocating.
+// Params:
+//	vertices: The world space vertices of the convex polygon
+//	normals: The world space edge normals of the convex polygon
+//	size: How many vertices (and normals) the polygon has
+//	circle: The circle we are testing against
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToCircleIntersection(const Vector2D* vertices, const Vector2D* normals, size_t size, const Circle& circle)
+{
+	if (size == 0)
+		return false;
 
-	// Add the three normals that come from the circle
-	// One from the rotation of the convex shape
-	Vector2D circleTangent(cosf(convexTransform.GetRotation()), sinf(convexTransform.GetRotation()));
-	normalSet.push_back(circleTangent);
-	// One that is perpendicular to the tangent
-	normalSet.push_back(Vector2D(-circleTangent.y, circleTangent.x));
-	// One that goes from the middle of the circle to the middle of the convex
-	normalSet.push_back((convexTransform.GetTranslation() - circle.center).Normalized());
+	// If the center sits right on a vertex, they're obviously intersecting.
+	Vector2D vertexAxis;
+	if (!GetCircleVertexAxis(vertices, size, circle.center, vertexAxis))
+		return true;
 
 	// Test the collisions
-	return SATIntersection(normalSet.data(), normalSet.size(), vertexSet.data(), vertexSet.size(), &circle.center, 1, circle.radius);
+	return SATHullIntersection(normals, size, &vertexAxis, 1, vertices, size, &circle.center, 1, circle.radius);
+}
+
+// Check whether a convex collider intersects a circle, using the world space data cached on the collider.
+// Params:
+//	convex: The convex collider
+//	circle: The circle we are testing against
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToCircleIntersection(const ColliderConvex& convex, const Circle& circle)
+{
+	const std::vector<Vector2D>& vertices = convex.GetWorldVertices();
+	if (!UseSIMDPath(convex))
+		return ConvexHullToCircleIntersection(vertices.data(), convex.GetWorldNormals().data(), vertices.size(), circle);
+
+	Vector2D vertexAxis;
+	if (!GetCircleVertexAxis(vertices.data(), vertices.size(), circle.center, vertexAxis))
+		return true;
+
+	return SATIntersection(convex.GetWorldAxes(), SoAPoints(&vertexAxis.x, &vertexAxis.y, 1),
+		convex.GetWorldPoints(), SoAPoints(&circle.center.x, &circle.center.y, 1), circle.radius);
 }
 
 // Checks whether a point is inside a convex shape
@@ -489,16 +735,37 @@ bool ConvexHullToPointIntersection(const std::vector<LineSegment>& convexSegment
 	// Separate our segments into vertices and normals
 	std::vector<Vector2D> vertexSet;
 	std::vector<Vector2D> normalSet;
-	vertexSet.reserve(convexSegments.size());
-	normalSet.reserve(convexSegments.size());
-	for (auto begin = convexSegments.cbegin(); begin < convexSegments.cend(); ++begin)
-	{
-		vertexSet.push_back(begin->end);
-		normalSet.push_back(begin->normal);
-	}
+	SplitSegments(convexSegments, vertexSet, normalSet);
+
+	return ConvexHullToPointIntersection(vertexSet.data(), normalSet.data(), vertexSet.size(), point);
+}
+
+// Checks whether a point is inside a convex polygon, without allocating.
+// Params:
+//	vertices: The world space vertices of the convex polygon
+//	normals: The world space edge normals of the convex polygon
+//	size: How many vertices (and normals) the polygon has
+//	point: The point we are testing
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToPointIntersection(const Vector2D* vertices, const Vector2D* normals, size_t size, const Vector2D& point)
+{
+	return SATHullIntersection(normals, size, nullptr, 0, vertices, size, &point, 1);
+}
+
+// Checks whether a point is inside a convex collider, using the world space data cached on the collider.
+// Params:
+//	convex: The convex collider
+//	point: The point we are testing
+// Returns:
+//	True if intersection, false otherwise
+bool ConvexHullToPointIntersection(const ColliderConvex& convex, const Vector2D& point)
+{
+	if (UseSIMDPath(convex))
+		return SATIntersection(convex.GetWorldAxes(), SoAPoints(), convex.GetWorldPoints(), SoAPoints(&point.x, &point.y, 1));
 
-	// Then test for intersection
-	return SATIntersection(normalSet.data(), normalSet.size(), vertexSet.data(), vertexSet.size(), &point, 1);
+	const std::vector<Vector2D>& vertices = convex.GetWorldVertices();
+	return ConvexHullToPointIntersection(vertices.data(), convex.GetWorldNormals().data(), vertices.size(), point);
 }
 
 // Check whether a moving point and line intersect.
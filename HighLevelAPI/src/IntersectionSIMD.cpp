@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	IntersectionSIMD.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "IntersectionSIMD.h"
+
+// Systems
+#include <Vector2D.h>
+#include <intrin.h>
+#include <immintrin.h>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Reference projection, one point at a time.
+	void ProjectScalar(const float* x, const float* y, size_t size, float axisX, float axisY, float& minValue, float& maxValue)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			float projection = x[i] * axisX + y[i] * axisY;
+			minValue = min(minValue, projection);
+			maxValue = max(maxValue, projection);
+		}
+	}
+
+	// Reduces the four lanes of a register to their minimum.
+	float HorizontalMin(__m128 value)
+	{
+		value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(value);
+	}
+
+	// Reduces the four lanes of a register to their maximum.
+	float HorizontalMax(__m128 value)
+	{
+		value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(value);
+	}
+
+	// Projects four points per instruction using SSE2.
+	void ProjectSSE2(const float* x, const float* y, size_t size, float axisX, float axisY, float& minValue, float& maxValue)
+	{
+		const __m128 axisXs = _mm_set1_ps(axisX);
+		const __m128 axisYs = _mm_set1_ps(axisY);
+		__m128 mins = _mm_set1_ps(minValue);
+		__m128 maxs = _mm_set1_ps(maxValue);
+
+		size_t i = 0;
+		for (; i + 4 <= size; i += 4)
+		{
+			__m128 projections = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), axisXs), _mm_mul_ps(_mm_loadu_ps(y + i), axisYs));
+			mins = _mm_min_ps(mins, projections);
+			maxs = _mm_max_ps(maxs, projections);
+		}
+
+		minValue = HorizontalMin(mins);
+		maxValue = HorizontalMax(maxs);
+
+		// Finish off any points that didn't fill a whole register.
+		ProjectScalar(x + i, y + i, size - i, axisX, axisY, minValue, maxValue);
+	}
+
+	// Projects eight points per instruction using AVX.
+	void ProjectAVX(const float* x, const float* y, size_t size, float axisX, float axisY, float& minValue, float& maxValue)
+	{
+		const __m256 axisXs = _mm256_set1_ps(axisX);
+		const __m256 axisYs = _mm256_set1_ps(axisY);
+		__m256 mins = _mm256_set1_ps(minValue);
+		__m256 maxs = _mm256_set1_ps(maxValue);
+
+		size_t i = 0;
+		for (; i + 8 <= size; i += 8)
+		{
+			__m256 projections = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), axisXs), _mm256_mul_ps(_mm256_loadu_ps(y + i), axisYs));
+			mins = _mm256_min_ps(mins, projections);
+			maxs = _mm256_max_ps(maxs, projections);
+		}
+
+		// Fold the upper half onto the lower half and reduce like SSE.
+		minValue = HorizontalMin(_mm_min_ps(_mm256_castps256_ps128(mins), _mm256_extractf128_ps(mins, 1)));
+		maxValue = HorizontalMax(_mm_max_ps(_mm256_castps256_ps128(maxs), _mm256_extractf128_ps(maxs, 1)));
+
+		// Avoid the penalty for mixing AVX and legacy SSE code.
+		_mm256_zeroupper();
+
+		// Finish off any points that didn't fill a whole register.
+		ProjectSSE2(x + i, y + i, size - i, axisX, axisY, minValue, maxValue);
+	}
+
+	// Asks the CPU and operating system which instruction sets can be used.
+	SIMDLevel DetectSIMDLevel()
+	{
+		int info[4];
+		__cpuid(info, 1);
+
+		// AVX needs support from the CPU and the OS must save the upper halves of the registers.
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+			return SIMDLevel::AVX;
+
+		// SSE2 is always available on x64.
+		return SIMDLevel::SSE2;
+	}
+
+	// Tests one set of axes with a fixed kernel, so the projections can be inlined.
+	// Params:
+	//   axes = The axes to check.
+	//   (Remaining parameters match SATIntersection.)
+	// Returns:
+	//   False if one of the axes separates the hulls, true otherwise.
+	template <void(*Project)(const float*, const float*, size_t, float, float, float&, float&)>
+	bool SATAxes(const SoAPoints& axes, const SoAPoints& points1, const SoAPoints& points2, float radius)
+	{
+		for (size_t i = 0; i < axes.size; ++i)
+		{
+			float minExtents1 = FLT_MAX;
+			float maxExtents1 = -FLT_MAX;
+			float minExtents2 = FLT_MAX;
+			float maxExtents2 = -FLT_MAX;
+
+			Project(points1.x, points1.y, points1.size, axes.x[i], axes.y[i], minExtents1, maxExtents1);
+			Project(points2.x, points2.y, points2.size, axes.x[i], axes.y[i], minExtents2, maxExtents2);
+
+			// If there is a gap between the min and max extents on this axis, the convex hulls are not colliding.
+			if ((minExtents2 - radius) - maxExtents1 > 0.0f || minExtents1 - (maxExtents2 + radius) > 0.0f)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   x = The x coordinates of the points.
+//   y = The y coordinates of the points.
+//   size = How many points there are.
+SoAPoints::SoAPoints(const float* x, const float* y, size_t size)
+	: x(x), y(y), size(size)
+{
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Returns the best instruction set supported by this CPU and operating system.
+SIMDLevel GetSupportedSIMDLevel()
+{
+	static const SIMDLevel supported = DetectSIMDLevel();
+	return supported;
+}
+
+// Checks for an intersection using the separating axis theorem, with the axes and points
+// in structure of arrays form. Stops at the first separating axis.
+// Params:
+//   axes1 = The first set of axes to check (usually the first hull's edge normals).
+//   axes2 = The second set of axes to check.
+//   points1 = The points in the first convex hull.
+//   points2 = The points in the second convex hull.
+//   radius = A value to add to/subtract from the second convex hull's projected points, essentially a radius for each point.
+// Returns:
+//   True if intersection, false otherwise.
+bool SATIntersection(const SoAPoints& axes1, const SoAPoints& axes2, const SoAPoints& points1, const SoAPoints& points2, float radius)
+{
+	// Pick the kernel once for the whole pair. If we get past both sets, there is no gap and the hulls are colliding.
+	switch (GetSupportedSIMDLevel())
+	{
+	case SIMDLevel::AVX:
+		return SATAxes<ProjectAVX>(axes1, points1, points2, radius) && SATAxes<ProjectAVX>(axes2, points1, points2, radius);
+	case SIMDLevel::SSE2:
+		return SATAxes<ProjectSSE2>(axes1, points1, points2, radius) && SATAxes<ProjectSSE2>(axes2, points1, points2, radius);
+	default:
+		return SATAxes<ProjectScalar>(axes1, points1, points2, radius) && SATAxes<ProjectScalar>(axes2, points1, points2, radius);
+	}
+}
+
+//------------------------------------------------------------------------------
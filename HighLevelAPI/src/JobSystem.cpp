@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	JobSystem.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "JobSystem.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// The job system the calling thread is a worker of, if any, and the worker's queue.
+	thread_local const JobSystem* currentJobSystem = nullptr;
+	thread_local unsigned currentQueue = 0;
+}
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Constructor
+JobCounter::JobCounter() : remaining(0)
+{
+}
+
+// Returns whether every job in the group has finished.
+bool JobCounter::IsDone() const
+{
+	return remaining == 0;
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   workerCount = How many worker threads to start. If 0, one per core, leaving a core for the main thread.
+JobSystem::JobSystem(unsigned workerCount) : BetaObject("JobSystem"), queuedCount(0), stopping(false)
+{
+	if (workerCount == 0)
+	{
+		unsigned hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	// Every queue has to exist before any worker starts stealing from them.
+	queues.reserve(workerCount + 1);
+	for (unsigned i = 0; i <= workerCount; i++)
+		queues.push_back(new JobQueue());
+
+	workers.reserve(workerCount);
+	for (unsigned i = 1; i <= workerCount; i++)
+		workers.push_back(std::thread(&JobSystem::WorkerMain, this, i));
+}
+
+// Destructor - finishes the queued jobs, then stops the workers.
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+
+	jobAdded.notify_all();
+
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		it->join();
+
+	for (auto it = queues.begin(); it != queues.end(); ++it)
+		delete *it;
+}
+
+// Queues a job to be run on a worker thread.
+// Params:
+//   function = The function to run.
+//   data = Passed to the function. Must stay valid until the job finishes.
+//   counter = Counts the job until it finishes.
+//   begin = Passed to the function.
+//   end = Passed to the function.
+void JobSystem::Run(JobFunction function, const void* data, JobCounter& counter, size_t begin, size_t end)
+{
+	Push(function, data, counter, begin, end, 0);
+}
+
+// Runs jobs until every job in a group has finished.
+// Params:
+//   counter = The counter the jobs were started with.
+void JobSystem::Wait(JobCounter& counter)
+{
+	while (!counter.IsDone())
+	{
+		// Help with whatever is queued, which is usually one of the jobs being waited on.
+		if (!RunNextJob())
+			std::this_thread::yield();
+	}
+}
+
+// Gets how many worker threads there are, not counting threads that help while waiting.
+unsigned JobSystem::GetWorkerCount() const
+{
+	return static_cast<unsigned>(workers.size());
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Adds jobs covering a range to the calling thread's queue and wakes the workers.
+// Params:
+//   function = The function each job runs.
+//   data = Passed to the function.
+//   counter = Counts the jobs until they finish.
+//   begin = The first index in the range.
+//   end = One past the last index in the range.
+//   batchSize = How many indices each job covers, or 0 for a single job covering the whole range.
+void JobSystem::Push(JobFunction function, const void* data, JobCounter& counter, size_t begin, size_t end, size_t batchSize)
+{
+	if (batchSize == 0)
+		batchSize = max(end - begin, static_cast<size_t>(1));
+
+	size_t jobCount = max((end - begin + batchSize - 1) / batchSize, static_cast<size_t>(1));
+
+	// Count the jobs before any of them can finish, so the counter can't reach 0 early.
+	counter.remaining += static_cast<unsigned>(jobCount);
+
+	{
+		JobQueue& queue = *queues[GetQueueIndex()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		for (size_t i = 0; i < jobCount; i++)
+		{
+			size_t first = begin + i * batchSize;
+			Job job = { function, data, first, min(first + batchSize, end), &counter };
+			queue.jobs.push_back(job);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		queuedCount += static_cast<int>(jobCount);
+	}
+
+	if (jobCount == 1)
+		jobAdded.notify_one();
+	else
+		jobAdded.notify_all();
+}
+
+// Runs a job from the calling thread's queue, or steals one from another queue.
+// Returns:
+//   True if a job was run, false if every queue was empty.
+bool JobSystem::RunNextJob()
+{
+	unsigned ownQueue = GetQueueIndex();
+	Job job;
+	bool found = false;
+
+	// Take the newest job from our own queue, since its data is the most likely to still be cached.
+	{
+		JobQueue& queue = *queues[ownQueue];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+			found = true;
+		}
+	}
+
+	// Otherwise steal the oldest job from another queue, starting with the next one over
+	// so thieves spread out instead of all fighting over the first queue.
+	for (size_t i = 1; !found && i < queues.size(); i++)
+	{
+		JobQueue& queue = *queues[(ownQueue + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+			found = true;
+		}
+	}
+
+	if (!found)
+		return false;
+
+	--queuedCount;
+
+	job.function(job.data, job.begin, job.end);
+	--job.counter->remaining;
+
+	return true;
+}
+
+// The main function of a worker thread.
+// Params:
+//   index = The worker's queue.
+void JobSystem::WorkerMain(unsigned index)
+{
+	currentJobSystem = this;
+	currentQueue = index;
+
+	for (;;)
+	{
+		if (RunNextJob())
+			continue;
+
+		// Sleep until more jobs are queued. The queued jobs are finished before stopping.
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		jobAdded.wait(lock, [this] { return stopping || queuedCount > 0; });
+
+		if (stopping && queuedCount <= 0)
+			return;
+	}
+}
+
+// Gets the queue the calling thread should add jobs to.
+unsigned JobSystem::GetQueueIndex() const
+{
+	return currentJobSystem == this ? currentQueue : 0;
+}
+
+//------------------------------------------------------------------------------
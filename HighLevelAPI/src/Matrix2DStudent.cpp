@@ -17,6 +17,35 @@
 
 #include "Matrix2DStudent.h"
 
+// Systems
+#include <Shapes2D.h>
+#include <xmmintrin.h>
+
+//------------------------------------------------------------------------------
+
+// TransformPoints reads and writes pairs of points as four packed floats, and
+// TransformSegments reads the start and end of a segment the same way.
+static_assert(sizeof(Vector2D) == 2 * sizeof(float), "Vector2D must be two tightly packed floats.");
+static_assert(offsetof(LineSegment, end) == offsetof(LineSegment, start) + sizeof(Vector2D), "A segment's end must follow its start.");
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Multiplies two points packed as (x0, y0, x1, y1) by a matrix whose columns are packed the same way.
+	// Params:
+	//   pair = The two points.
+	//   column0, column1, column2 = The columns of the matrix, each repeated to match the points.
+	// Returns:
+	//   The two transformed points, packed the same way.
+	inline __m128 TransformPair(__m128 pair, __m128 column0, __m128 column1, __m128 column2)
+	{
+		__m128 xs = _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(2, 2, 0, 0));
+		__m128 ys = _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(3, 3, 1, 1));
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, column0), _mm_mul_ps(ys, column1)), column2);
+	}
+}
+
 //------------------------------------------------------------------------------
 
 namespace CS230
@@ -37,16 +66,8 @@ namespace CS230
 	//------------------------------------------------------------------------------
 
 	// Constructor for matrix. Sets all data in matrix to 0.
-	Matrix2D::Matrix2D()
+	Matrix2D::Matrix2D() : m()
 	{
-		// Zero out the internal matrix.
-		for (unsigned row = 0; row < 3; row++)
-		{
-			for (unsigned column = 0; column < 3; column++)
-			{
-				m[row][column] = 0.0f;
-			}
-		}
 	}
 
 	// This function creates an identity matrix and returns it.
@@ -54,10 +75,9 @@ namespace CS230
 	{
 		Matrix2D matrix;
 
-		for (unsigned diagonal = 0; diagonal < 3; diagonal++)
-		{
-			matrix.m[diagonal][diagonal] = 1.0f;
-		}
+		matrix.m[0][0] = 1.0f;
+		matrix.m[1][1] = 1.0f;
+		matrix.m[2][2] = 1.0f;
 
 		return matrix;
 	}
@@ -144,6 +164,21 @@ namespace CS230
 	{
 		Matrix2D matrix;
 
+		// Every matrix the engine builds is affine, so the bottom row is known and
+		// only the top two rows (with one fewer term each) need to be calculated.
+		if (IsAffine() && other.IsAffine())
+		{
+			matrix.m[0][0] = m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0];
+			matrix.m[0][1] = m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1];
+			matrix.m[0][2] = m[0][0] * other.m[0][2] + m[0][1] * other.m[1][2] + m[0][2];
+			matrix.m[1][0] = m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0];
+			matrix.m[1][1] = m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1];
+			matrix.m[1][2] = m[1][0] * other.m[0][2] + m[1][1] * other.m[1][2] + m[1][2];
+			matrix.m[2][2] = 1.0f;
+
+			return matrix;
+		}
+
 		for (unsigned row = 0; row < 3; row++)
 		{
 			for (unsigned col = 0; col < 3; col++)
@@ -177,6 +212,65 @@ namespace CS230
 		return output;
 	}
 
+	// Returns whether the bottom row is (0, 0, 1), meaning the matrix is only a
+	// combination of translation, rotation, scale, and shear.
+	bool Matrix2D::IsAffine() const
+	{
+		return m[2][0] == 0.0f && m[2][1] == 0.0f && m[2][2] == 1.0f;
+	}
+
+	// Multiplies many points by this matrix at once, two at a time using SSE.
+	// The bottom row is ignored, so the matrix must be affine.
+	// Params:
+	//   points = The points to transform.
+	//   result = Where to store the transformed points. Can be the same array as points.
+	//   count = How many points there are.
+	void Matrix2D::TransformPoints(const Vector2D* points, Vector2D* result, size_t count) const
+	{
+		_ASSERTE(IsAffine());
+
+		// Two points are packed as (x0, y0, x1, y1), so each column is repeated to match.
+		const __m128 column0 = _mm_setr_ps(m[0][0], m[1][0], m[0][0], m[1][0]);
+		const __m128 column1 = _mm_setr_ps(m[0][1], m[1][1], m[0][1], m[1][1]);
+		const __m128 column2 = _mm_setr_ps(m[0][2], m[1][2], m[0][2], m[1][2]);
+
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128 pair = _mm_loadu_ps(&points[i].x);
+			_mm_storeu_ps(&result[i].x, TransformPair(pair, column0, column1, column2));
+		}
+
+		// Handle the last point if there was an odd number.
+		if (i < count)
+			result[i] = *this * points[i];
+	}
+
+	// Multiplies the ends of many line segments by this matrix at once, and
+	// recalculates their directions and normals. Both ends of a segment are transformed
+	// together using SSE. The bottom row is ignored, so the matrix must be affine.
+	// Params:
+	//   segments = The line segments to transform.
+	//   result = Where to store the transformed segments. Can be the same array as segments.
+	//   count = How many segments there are.
+	void Matrix2D::TransformSegments(const LineSegment* segments, LineSegment* result, size_t count) const
+	{
+		_ASSERTE(IsAffine());
+
+		const __m128 column0 = _mm_setr_ps(m[0][0], m[1][0], m[0][0], m[1][0]);
+		const __m128 column1 = _mm_setr_ps(m[0][1], m[1][1], m[0][1], m[1][1]);
+		const __m128 column2 = _mm_setr_ps(m[0][2], m[1][2], m[0][2], m[1][2]);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			// The start and end are next to each other, so they load as a pair of points.
+			Vector2D ends[2];
+			__m128 pair = _mm_loadu_ps(&segments[i].start.x);
+			_mm_storeu_ps(&ends[0].x, TransformPair(pair, column0, column1, column2));
+			result[i] = LineSegment(ends[0], ends[1]);
+		}
+	}
+
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
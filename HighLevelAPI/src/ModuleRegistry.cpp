@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ModuleRegistry.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "ModuleRegistry.h"
+
+// Systems
+#include <Engine.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Adds every registered module to the engine, ordered so each module is
+// updated after the modules it depends on.
+void ModuleRegistry::AddModulesToEngine()
+{
+	SortModules();
+
+	Engine& engine = Engine::GetInstance();
+	for (auto it = updateOrder.begin(); it != updateOrder.end(); ++it)
+		engine.AddModule(*it);
+
+	// The engine has the modules now, so don't add them again.
+	entries.clear();
+}
+
+// Forgets every registered module. Must be called once the engine has deleted
+// its modules, so lookups return nullptr instead of freed pointers.
+void ModuleRegistry::ReleaseModules()
+{
+	for (auto it = slotClearers.begin(); it != slotClearers.end(); ++it)
+		(*it)();
+
+	slotClearers.clear();
+	entries.clear();
+	updateOrder.clear();
+}
+
+// Gets the order the registered modules will be (or were) added to the engine in.
+// Modules with no path of dependencies between them could be updated in parallel.
+const std::vector<BetaObject*>& ModuleRegistry::GetUpdateOrder() const
+{
+	return updateOrder;
+}
+
+// Returns an instance of the registry.
+ModuleRegistry& ModuleRegistry::GetInstance()
+{
+	static ModuleRegistry instance;
+	return instance;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Constructor is private to prevent accidental instantiation
+ModuleRegistry::ModuleRegistry()
+{
+}
+
+// Sorts the registered modules so every module comes after its dependencies.
+void ModuleRegistry::SortModules()
+{
+	updateOrder.clear();
+	updateOrder.reserve(entries.size());
+
+	// How many of each module's dependencies haven't been placed yet.
+	std::vector<size_t> remaining(entries.size());
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		for (auto it = entries[i].dependencies.begin(); it != entries[i].dependencies.end(); ++it)
+		{
+			bool found = false;
+			for (size_t j = 0; j < entries.size(); j++)
+			{
+				if (entries[j].key == *it)
+				{
+					found = true;
+					break;
+				}
+			}
+
+			// Dependencies that were never registered can't be waited on.
+			_ASSERTE(found && "Module depends on a module that was not registered");
+			if (found)
+				++remaining[i];
+		}
+	}
+
+	// Repeatedly place the first module, in registration order, whose dependencies have all
+	// been placed. Modules without dependencies between them keep their registration order.
+	std::vector<bool> placed(entries.size(), false);
+	while (updateOrder.size() < entries.size())
+	{
+		size_t next = entries.size();
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (!placed[i] && remaining[i] == 0)
+			{
+				next = i;
+				break;
+			}
+		}
+
+		// A cycle means no order works, so place the rest as they were registered.
+		if (next == entries.size())
+		{
+			_ASSERTE(false && "Modules have circular dependencies");
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				if (!placed[i])
+				{
+					placed[i] = true;
+					updateOrder.push_back(entries[i].module);
+				}
+			}
+			break;
+		}
+
+		placed[next] = true;
+		updateOrder.push_back(entries[next].module);
+
+		// Modules waiting on this one have one less dependency to wait for.
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (placed[i])
+				continue;
+
+			for (auto it = entries[i].dependencies.begin(); it != entries[i].dependencies.end(); ++it)
+			{
+				if (*it == entries[next].key)
+					--remaining[i];
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
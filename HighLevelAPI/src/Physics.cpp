@@ -26,6 +26,20 @@
 
 //------------------------------------------------------------------------------
 
+namespace
+{
+	// Bodies slower than this (in units per second) are considered resting.
+	const float sleepSpeed = 1.0f;
+
+	// Bodies turning slower than this (in radians per second) are considered resting.
+	const float sleepAngularSpeed = 0.01f;
+
+	// How long (in seconds) a body must rest before it can fall asleep.
+	const float timeToSleep = 0.5f;
+}
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
@@ -39,7 +53,8 @@
 //   transform - The transform of the object.
 Physics::Physics() : Component("Physics"),
 	velocity(Vector2D()), angularVelocity(0.0f), inverseMass(1.0f), forcesSum(Vector2D()),
-	acceleration(Vector2D()), oldTranslation(Vector2D()), transform(nullptr)
+	acceleration(Vector2D()), oldTranslation(Vector2D()), continuousCollision(false),
+	sleepingAllowed(true), asleep(false), restingTime(0.0f), sleepMatrixVersion(0), transform(nullptr)
 {
 }
 
@@ -97,11 +112,31 @@ void Physics::Update(float dt)
 //	 dt = Change in time (in seconds) since the last fixed update.
 void Physics::FixedUpdate(float dt)
 {
+	// Sleeping bodies don't move, unless something else moved their transform.
+	if (asleep)
+	{
+		if (transform->GetMatrixVersion() == sleepMatrixVersion)
+			return;
+
+		Wake();
+	}
+
+	// Keep track of how long the body has been resting, so it can be put to sleep. This looks at
+	// the velocity left after the last step's collisions and how far the body actually got, so a
+	// constant force like gravity doesn't keep a body awake once something is holding it up.
+	const Vector2D displacement = transform->GetTranslation() - oldTranslation;
+	if (velocity.MagnitudeSquared() < sleepSpeed * sleepSpeed && displacement.MagnitudeSquared() < sleepSpeed * sleepSpeed * dt * dt
+		&& fabsf(angularVelocity) < sleepAngularSpeed)
+		restingTime += dt;
+	else
+		restingTime = 0.0f;
+
 	// Increase velocity by the acceleration from the last update.
 	velocity += acceleration * dt;
 
-	// Store the old translation.
+	// Store the old translation, and the state drawing will blend from.
 	oldTranslation = transform->GetTranslation();
+	transform->SavePreviousState();
 
 	// Add the current velocity to the translation & rotation.
 	Vector2D newTranslation = oldTranslation + velocity * dt;
@@ -112,11 +147,20 @@ void Physics::FixedUpdate(float dt)
 	transform->SetRotation(newRotation);
 }
 
+// Physics only moves its own transform, so bodies are stepped in parallel.
+bool Physics::IsFixedUpdateThreadSafe() const
+{
+	return true;
+}
+
 // Set the velocity of a physics component.
 // Params:
 //	 velocity = Pointer to a velocity vector.
 void Physics::SetVelocity(const Vector2D& velocity_)
 {
+	if (asleep && (velocity_.x != velocity.x || velocity_.y != velocity.y))
+		Wake();
+
 	velocity = velocity_;
 }
 
@@ -133,6 +177,9 @@ const Vector2D& Physics::GetVelocity() const
 //	 velocity = New value for the rotational velocity.
 void Physics::SetAngularVelocity(float velocity_)
 {
+	if (asleep && velocity_ != angularVelocity)
+		Wake();
+
 	angularVelocity = velocity_;
 }
 
@@ -158,6 +205,9 @@ void Physics::SetMass(float mass)
 //	 force = A force vector with direction and magnitude.
 void Physics::AddForce(const Vector2D& force)
 {
+	if (force.x != 0.0f || force.y != 0.0f)
+		Wake();
+
 	forcesSum += force;
 }
 
@@ -185,4 +235,74 @@ const Vector2D& Physics::GetOldTranslation() const
 	return oldTranslation;
 }
 
+// Enables or disables continuous collision detection. Fast, small objects like bullets
+// should enable this so they can't pass through thin colliders in a single step.
+// Params:
+//   enabled = Whether collisions should be swept from the old to the new translation.
+void Physics::SetContinuousCollision(bool enabled)
+{
+	continuousCollision = enabled;
+}
+
+// Returns whether continuous collision detection is enabled.
+bool Physics::IsContinuousCollision() const
+{
+	return continuousCollision;
+}
+
+// Allows or prevents this body from falling asleep. Bodies that are moved by
+// something other than forces and velocity every step may want to disable this.
+// Params:
+//   allowed = Whether the body can sleep.
+void Physics::SetSleepingAllowed(bool allowed)
+{
+	sleepingAllowed = allowed;
+
+	if (!sleepingAllowed)
+		Wake();
+}
+
+// Returns whether this body can fall asleep.
+bool Physics::IsSleepingAllowed() const
+{
+	return sleepingAllowed;
+}
+
+// Returns whether this body has rested long enough that it can fall asleep.
+// Bodies only actually sleep when everything they are touching can sleep too.
+bool Physics::IsResting() const
+{
+	return sleepingAllowed && restingTime >= timeToSleep;
+}
+
+// Returns whether this body is asleep, meaning it doesn't move and doesn't
+// need to be checked against other sleeping bodies.
+bool Physics::IsAsleep() const
+{
+	return asleep;
+}
+
+// Puts this body to sleep, stopping it.
+void Physics::Sleep()
+{
+	if (asleep || !sleepingAllowed)
+		return;
+
+	asleep = true;
+	velocity = Vector2D();
+	angularVelocity = 0.0f;
+
+	// The body won't move until it wakes, so it is already where collisions and drawing expect.
+	oldTranslation = transform->GetTranslation();
+	transform->SavePreviousState();
+	sleepMatrixVersion = transform->GetMatrixVersion();
+}
+
+// Wakes this body up, so it moves and collides normally again.
+void Physics::Wake()
+{
+	asleep = false;
+	restingTime = 0.0f;
+}
+
 //------------------------------------------------------------------------------
@@ -25,6 +25,14 @@
 
 //------------------------------------------------------------------------------
 
+namespace
+{
+	// How long Update may spend creating textures each frame, unless changed with SetUploadBudget.
+	const float defaultUploadBudget = 0.002f;
+}
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
@@ -34,8 +42,9 @@
 //------------------------------------------------------------------------------
 
 // Constructor(s)
-ResourceManager::ResourceManager()
+ResourceManager::ResourceManager() : placeholderTexture(nullptr), asyncLoading(true), uploadBudget(defaultUploadBudget)
 {
+	loader.SetCache(&textureCache);
 }
 
 // Destructor
@@ -44,22 +53,42 @@ ResourceManager::~ResourceManager()
 	//Unload();
 }
 
+// Finishes loading textures that have been decoded in the background, until the upload budget is spent.
+// At least one texture is finished per call, so loading always makes progress.
+void ResourceManager::Update()
+{
+	if (pendingTextures.empty())
+		return;
+
+	auto start = std::chrono::steady_clock::now();
+
+	DecodedImage image;
+	while (loader.PopDecodedImage(image))
+	{
+		FinishTextureLoad(image);
+
+		std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+		if (elapsed.count() >= uploadBudget)
+			break;
+	}
+}
+
 // Retrieve an existing mesh required by a game object.
 // Params:
 //   objectName = The name of the mesh.
 //   createIfNotFound = Whether to create a default quad mesh if no mesh is found.
 Mesh* ResourceManager::GetMesh(const std::string& objectName, bool createIfNotFound)
 {
-	// If the resource does not exist, create it if told to.
-	if (GetResourceReferenceCount("mesh" + objectName) == 0)
-	{
-		if (!createIfNotFound)
-			return nullptr;
+	// If the resource already exists, make sure it is kept for this level.
+	Handle<Mesh> handle = meshes.Find(objectName);
+	if (handle.IsValid())
+		return meshes.Reference(handle);
 
-		return AddMesh(objectName, CreateQuadMesh(Vector2D(1.0f, 1.0f), Vector2D(0.5f, 0.5f)));
-	}
+	// Otherwise, create it if told to.
+	if (!createIfNotFound)
+		return nullptr;
 
-	return resources.at("mesh" + objectName)->mesh;
+	return AddQuadMesh(objectName, Vector2D(1.0f, 1.0f), Vector2D(0.5f, 0.5f));
 }
 
 // Retrieve an existing mesh required by a game object, or create it if no mesh is found.
@@ -70,10 +99,11 @@ Mesh* ResourceManager::GetMesh(const std::string& objectName, bool createIfNotFo
 Mesh* ResourceManager::GetMesh(const std::string& objectName, Vector2D textureSize, Vector2D extents)
 {
 	// If the resource does not exist, create it.
-	if (GetResourceReferenceCount("mesh" + objectName) == 0)
-		return AddMesh(objectName, CreateQuadMesh(textureSize, extents));
+	Handle<Mesh> handle = meshes.Find(objectName);
+	if (handle.IsValid())
+		return meshes.Reference(handle);
 
-	return resources.at("mesh" + objectName)->mesh;
+	return AddQuadMesh(objectName, textureSize, extents);
 }
 
 // Retrieve an existing mesh required by a game object, or create it if no mesh is found.
@@ -85,10 +115,11 @@ Mesh* ResourceManager::GetMesh(const std::string& objectName, Vector2D textureSi
 Mesh* ResourceManager::GetMesh(const std::string& objectName, int numCols, int numRows, Vector2D extents)
 {
 	// If the resource does not exist, create it.
-	if (GetResourceReferenceCount("mesh" + objectName) == 0)
-		return AddMesh(objectName, CreateQuadMesh(Vector2D(1.0f / numCols, 1.0f / numRows), extents));
+	Handle<Mesh> handle = meshes.Find(objectName);
+	if (handle.IsValid())
+		return meshes.Reference(handle);
 
-	return resources.at("mesh" + objectName)->mesh;
+	return AddQuadMesh(objectName, Vector2D(1.0f / numCols, 1.0f / numRows), extents);
 }
 
 // Retrieve an existing mesh required by a game object, or create it if no mesh is found.
@@ -99,10 +130,11 @@ Mesh* ResourceManager::GetMesh(const std::string& objectName, int numCols, int n
 Mesh* ResourceManager::GetMesh(const std::string& objectName, SpriteSource* spriteSource, Vector2D extents)
 {
 	// If the resource does not exist, create it.
-	if (GetResourceReferenceCount("mesh" + objectName) == 0)
-		return AddMesh(objectName, CreateQuadMesh(Vector2D(1.0f / spriteSource->GetNumCols(), 1.0f / spriteSource->GetNumRows()), extents));
+	Handle<Mesh> handle = meshes.Find(objectName);
+	if (handle.IsValid())
+		return meshes.Reference(handle);
 
-	return resources.at("mesh" + objectName)->mesh;
+	return AddQuadMesh(objectName, spriteSource->GetFrameSize(), extents);
 }
 
 // Retrieve an existing mesh required by a game object, or create it if no mesh is found.
@@ -116,10 +148,36 @@ Mesh* ResourceManager::GetMesh(const std::string& objectName, SpriteSource* spri
 Mesh* ResourceManager::GetMesh(const std::string& objectName, const Color& color0, const Color& color1, const Color& color2)
 {
 	// If the resource does not exist, create it.
-	if (GetResourceReferenceCount("mesh" + objectName) == 0)
-		return AddMesh(objectName, CreateTriangleMesh(color0, color1, color2));
+	Handle<Mesh> handle = meshes.Find(objectName);
+	if (handle.IsValid())
+		return meshes.Reference(handle);
+
+	return AddMesh(objectName, CreateTriangleMesh(color0, color1, color2));
+}
+
+// Retrieves a quad mesh with UVs the size of one frame of a sprite source. A sprite source in an atlas only
+// covers a region of its page, so a quad made without it, such as "Quad", would show the whole page.
+// Params:
+//   mesh = The mesh the sprite source is drawn with.
+//   spriteSource = The sprite source.
+// Returns:
+//   A copy of the quad with the same extents but UVs sized to the frame, or the mesh itself if the sprite
+//   source has no region, the UVs already fit, or the mesh isn't a quad made by this resource manager.
+Mesh* ResourceManager::FitMesh(Mesh* mesh, const SpriteSource* spriteSource)
+{
+	if (!spriteSource->HasRegion())
+		return mesh;
 
-	return resources.at("mesh" + objectName)->mesh;
+	auto shape = quadShapes.find(mesh->GetName());
+	if (shape == quadShapes.end())
+		return mesh;
+
+	Vector2D frameSize = spriteSource->GetFrameSize();
+	if (frameSize.x == shape->second.first.x && frameSize.y == shape->second.first.y)
+		return mesh;
+
+	// Copies are named after the frame size, so every sprite drawing this mesh with frames of that size shares one.
+	return GetMesh(shape->first + "@" + std::to_string(frameSize.x) + "x" + std::to_string(frameSize.y), frameSize, shape->second.second);
 }
 
 // Retrieve a sprite source that uses a given texture, create it if not found.
@@ -130,16 +188,44 @@ Mesh* ResourceManager::GetMesh(const std::string& objectName, const Color& color
 //   createIfNotFound = Whether to create a sprite source if no sprite source is found.
 SpriteSource* ResourceManager::GetSpriteSource(const std::string& textureName, int numCols, int numRows, bool createIfNotFound)
 {
-	// If the resource does not exist, create it if told to.
-	if (GetResourceReferenceCount("spriteSource" + textureName) == 0)
+	// If the resource already exists, make sure it is kept for this level.
+	Handle<SpriteSource> handle = spriteSources.Find(textureName);
+	if (handle.IsValid())
 	{
-		if (!createIfNotFound)
-			return nullptr;
+		// Its texture is kept too, since the sprite source still uses it. A texture that is still loading isn't in the table yet.
+		auto region = atlasRegions.find(textureName);
+		textures.Reference(textures.Find(region != atlasRegions.end() ? region->second.page : textureName));
+		return spriteSources.Reference(handle);
+	}
 
+	// Otherwise, create it if told to.
+	if (!createIfNotFound)
+		return nullptr;
+
+	// Textures packed into an atlas use their region of the atlas page.
+	auto region = atlasRegions.find(textureName);
+	if (region != atlasRegions.end())
+	{
+		SpriteSource* spriteSource = new SpriteSource(numCols, numRows, GetTexture(region->second.page));
+		spriteSource->SetRegion(region->second.uvOffset, region->second.uvSize);
+		return AddSpriteSource(textureName, spriteSource);
+	}
+
+	// Textures that are already loaded, or that have no file, don't need to wait.
+	if (!asyncLoading || textureName == "none" || textures.Find(textureName).IsValid())
 		return AddSpriteSource(textureName, new SpriteSource(numCols, numRows, GetTexture(textureName)));
+
+	// Draw with a placeholder until the texture has been decoded in the background.
+	SpriteSource* spriteSource = new SpriteSource(numCols, numRows);
+	spriteSource->SetPlaceholder(GetPlaceholderTexture());
+
+	if (std::find(pendingTextures.begin(), pendingTextures.end(), textureName) == pendingTextures.end())
+	{
+		pendingTextures.push_back(textureName);
+		loader.RequestImage(textureName, Texture::GetFilePath() + textureName);
 	}
 
-	return resources.at("spriteSource" + textureName)->spriteSource;
+	return AddSpriteSource(textureName, spriteSource);
 }
 
 // Retrieve a sprite source that uses a given texture, create it if not found.
@@ -148,16 +234,16 @@ SpriteSource* ResourceManager::GetSpriteSource(const std::string& textureName, i
 //   createIfNotFound = Whether to create a sprite source if no sprite source is found.
 Texture* ResourceManager::GetTexture(const std::string& textureName, bool createIfNotFound)
 {
-	// If the resource does not exist, create it if told to.
-	if (GetResourceReferenceCount("texture" + textureName) == 0)
-	{
-		if (!createIfNotFound)
-			return nullptr;
+	// If the resource already exists, make sure it is kept for this level.
+	Handle<Texture> handle = textures.Find(textureName);
+	if (handle.IsValid())
+		return textures.Reference(handle);
 
-		return AddTexture(textureName, CreateTextureFromFile(textureName));
-	}
+	// Otherwise, create it if told to.
+	if (!createIfNotFound)
+		return nullptr;
 
-	return resources.at("texture" + textureName)->texture;
+	return AddTexture(textureName, CreateTextureFromFile(textureName));
 }
 
 // Adds a pre-made mesh required by a game object.
@@ -168,18 +254,10 @@ Texture* ResourceManager::GetTexture(const std::string& textureName, bool create
 //   The mesh that was added.
 Mesh* ResourceManager::AddMesh(const std::string& objectName, Mesh* mesh)
 {
-	Resource* resource = new Resource(mesh);
-	auto emplaced = resources.emplace("mesh" + objectName, resource);
-
-	// If the resource already existed, delete the new resource since we are not keeping track of it.
-	if (!emplaced.second)
-	{
-		delete resource;
-	}
+	mesh->SetName(objectName);
 
-	resource = emplaced.first->second;
-	++resource->references;
-	return resource->mesh;
+	// If the resource already existed, the table deletes the new one since we are not keeping track of it.
+	return meshes.Get(meshes.Add(objectName, mesh));
 }
 
 // Adds a pre-made sprite source required by a game object.
@@ -190,18 +268,8 @@ Mesh* ResourceManager::AddMesh(const std::string& objectName, Mesh* mesh)
 //   The sprite source that was added.
 SpriteSource* ResourceManager::AddSpriteSource(const std::string& objectName, SpriteSource* spriteSource)
 {
-	Resource* resource = new Resource(spriteSource);
-	auto emplaced = resources.emplace("spriteSource" + objectName, resource);
-
-	// If the resource already existed, delete the new resource since we are not keeping track of it.
-	if (!emplaced.second)
-	{
-		delete resource;
-	}
-
-	resource = emplaced.first->second;
-	++resource->references;
-	return resource->spriteSource;
+	// If the resource already existed, the table deletes the new one since we are not keeping track of it.
+	return spriteSources.Get(spriteSources.Add(objectName, spriteSource));
 }
 
 // Adds a pre-made texture required by a game object.
@@ -212,106 +280,239 @@ SpriteSource* ResourceManager::AddSpriteSource(const std::string& objectName, Sp
 //   The texture that was added.
 Texture* ResourceManager::AddTexture(const std::string& objectName, Texture* texture)
 {
-	Resource* resource = new Resource(texture);
-	auto emplaced = resources.emplace("texture" + objectName, resource);
+	// If the resource already existed, the table deletes the new one since we are not keeping track of it.
+	return textures.Get(textures.Add(objectName, texture));
+}
 
-	// If the resource already existed, delete the new resource since we are not keeping track of it.
-	if (!emplaced.second)
-	{
-		delete resource;
-	}
+// Finds an existing mesh without creating or referencing it.
+// Params:
+//   objectName = The name of the mesh.
+// Returns:
+//   A handle to the mesh, or an invalid handle if no mesh has that name.
+Handle<Mesh> ResourceManager::FindMesh(const std::string& objectName) const
+{
+	return meshes.Find(objectName);
+}
 
-	resource = emplaced.first->second;
-	++resource->references;
-	return resource->texture;
+// Finds an existing sprite source without creating or referencing it.
+// Params:
+//   textureName = Filename of the texture used by the sprite source.
+// Returns:
+//   A handle to the sprite source, or an invalid handle if there is none for that texture.
+Handle<SpriteSource> ResourceManager::FindSpriteSource(const std::string& textureName) const
+{
+	return spriteSources.Find(textureName);
+}
+
+// Finds an existing texture without creating or referencing it.
+// Params:
+//   textureName = Filename of the texture.
+// Returns:
+//   A handle to the texture, or an invalid handle if no texture has that name.
+Handle<Texture> ResourceManager::FindTexture(const std::string& textureName) const
+{
+	return textures.Find(textureName);
+}
+
+// Retrieves the mesh a handle refers to, without looking up its name.
+// Params:
+//   handle = A handle from FindMesh.
+// Returns:
+//   The mesh, or nullptr if it has been unloaded.
+Mesh* ResourceManager::GetMesh(Handle<Mesh> handle) const
+{
+	return meshes.Get(handle);
+}
+
+// Retrieves the sprite source a handle refers to, without looking up its name.
+// Params:
+//   handle = A handle from FindSpriteSource.
+// Returns:
+//   The sprite source, or nullptr if it has been unloaded.
+SpriteSource* ResourceManager::GetSpriteSource(Handle<SpriteSource> handle) const
+{
+	return spriteSources.Get(handle);
+}
+
+// Retrieves the texture a handle refers to, without looking up its name.
+// Params:
+//   handle = A handle from FindTexture.
+// Returns:
+//   The texture, or nullptr if it has been unloaded.
+Texture* ResourceManager::GetTexture(Handle<Texture> handle) const
+{
+	return textures.Get(handle);
 }
 
 // To be called when a level has finished loading its resources.
 void ResourceManager::OnLevelLoad()
 {
-	// Loop through all resources.
-	for (auto it = resources.begin(); it != resources.end();)
-	{
-		// If this resource has no references after loading the next level (left over from the last level), remove it.
-		if (it->second->references == 0)
-		{
-			delete it->second;
-			it = resources.erase(it);
-		}
-		else
-		{
-			++it;
-		}
-	}
+	// Remove any resources that have no references after loading the next level (left over from the last level).
+	// Sprite sources go first, since they use textures.
+	meshes.RemoveUnreferenced();
+	spriteSources.RemoveUnreferenced();
+	textures.RemoveUnreferenced();
 }
 
 // To be called when a level has finished unloading its resources.
 void ResourceManager::OnLevelUnload()
 {
-	for (auto it = resources.begin(); it != resources.end(); it++)
-	{
-		it->second->references = 0;
-	}
+	meshes.ClearReferences();
+	spriteSources.ClearReferences();
+	textures.ClearReferences();
 }
 
 // Unloads all resources used by the resource manager.
 void ResourceManager::Unload()
 {
-	for (auto it = resources.begin(); it != resources.end(); it++)
-	{
-		delete it->second;
-	}
+	// Anything still loading is no longer wanted.
+	loader.Clear();
+	pendingTextures.clear();
+
+	meshes.Clear();
+	spriteSources.Clear();
+	textures.Clear();
 
-	resources.clear();
+	delete placeholderTexture;
+	placeholderTexture = nullptr;
+
+	atlasRegions.clear();
+	builtAtlasPages.clear();
+	quadShapes.clear();
 }
 
-//------------------------------------------------------------------------------
-// Private Structures:
-//------------------------------------------------------------------------------
+// Sets whether sprite sources load their textures in the background.
+// Params:
+//   enabled = Whether to load asynchronously. Textures requested directly are always loaded immediately.
+void ResourceManager::SetAsyncLoading(bool enabled)
+{
+	asyncLoading = enabled;
+}
 
-// Conversion constructor
+// Sets how long Update may spend uploading textures each frame.
 // Params:
-//   mesh = The mesh resource.
-ResourceManager::Resource::Resource(Mesh* mesh) : type(ResourceType::MESH), references(0), mesh(mesh)
+//   seconds = The upload time budget.
+void ResourceManager::SetUploadBudget(float seconds)
+{
+	uploadBudget = seconds;
+}
+
+// Returns whether any textures are still loading in the background.
+bool ResourceManager::IsLoading() const
+{
+	return !pendingTextures.empty();
+}
+
+// Returns the resources in use since the last level was unloaded, including textures that are still loading.
+ResourceManifest ResourceManager::GetManifest() const
 {
+	ResourceManifest manifest;
+	textures.GetReferencedNames(manifest.textures);
+
+	// Textures still loading for this level have a sprite source waiting on them, unlike ones being preloaded.
+	for (auto it = pendingTextures.begin(); it != pendingTextures.end(); ++it)
+	{
+		if (spriteSources.Find(*it).IsValid())
+			manifest.textures.push_back(*it);
+	}
+
+	return manifest;
 }
 
-// Conversion constructor
+// Starts loading the textures in a manifest in the background, without referencing them.
+// Preloaded textures that the next level doesn't use are removed once it has loaded.
 // Params:
-//   spriteSource = The sprite source resource.
-ResourceManager::Resource::Resource(SpriteSource* spriteSource) : type(ResourceType::SPRITESOURCE), references(0), spriteSource(spriteSource)
+//   manifest = The resources to load.
+void ResourceManager::Preload(const ResourceManifest& manifest)
 {
+	for (auto it = manifest.textures.begin(); it != manifest.textures.end(); ++it)
+	{
+		// Skip textures that are already loaded or on their way, and atlas pages that have no file.
+		if (*it == "none" || textures.Find(*it).IsValid())
+			continue;
+		if (std::find(builtAtlasPages.begin(), builtAtlasPages.end(), *it) != builtAtlasPages.end())
+			continue;
+		if (std::find(pendingTextures.begin(), pendingTextures.end(), *it) != pendingTextures.end())
+			continue;
+
+		pendingTextures.push_back(*it);
+		loader.RequestImage(*it, Texture::GetFilePath() + *it);
+	}
 }
 
-// Conversion constructor
+// Reads an atlas manifest saved with TextureAtlas::Save. Sprite sources created afterward for
+// textures in the atlas use the atlas pages instead of their own textures.
 // Params:
-//   texture = The texture resource.
-ResourceManager::Resource::Resource(Texture* texture) : type(ResourceType::TEXTURE), references(0), texture(texture)
+//   atlasName = The name of the atlas.
+// Returns:
+//   True if the manifest was read, false otherwise.
+bool ResourceManager::LoadAtlas(const std::string& atlasName)
 {
+	return TextureAtlas::LoadManifest(atlasName, atlasRegions);
 }
 
-// Destructor
-ResourceManager::Resource::~Resource()
+// Packs textures into atlas pages now, for textures that weren't packed ahead of time.
+// Call this before creating the sprite sources. If the pages are still loaded from an earlier level, they are reused.
+// Params:
+//   atlasName = The name of the atlas, used to name its pages.
+//   textureNames = The filenames of the textures to pack. Textures that don't fit are loaded on their own.
+//   pageSize = The width and height of each page, in pixels.
+void ResourceManager::BuildAtlas(const std::string& atlasName, const std::vector<std::string>& textureNames, unsigned pageSize)
 {
-	// Deallocate the appropriate type.
-	switch (type)
+	// Reuse the pages if every texture is already on one that is still loaded.
+	bool pagesLoaded = true;
+	for (auto it = textureNames.begin(); it != textureNames.end() && pagesLoaded; ++it)
+	{
+		auto region = atlasRegions.find(*it);
+		pagesLoaded = region != atlasRegions.end() && textures.Find(region->second.page).IsValid();
+	}
+
+	if (pagesLoaded)
+	{
+		for (auto it = textureNames.begin(); it != textureNames.end(); ++it)
+			textures.Reference(textures.Find(atlasRegions.at(*it).page));
+		return;
+	}
+
+	TextureAtlas atlas(pageSize, pageSize);
+	for (auto it = textureNames.begin(); it != textureNames.end(); ++it)
 	{
-	case ResourceType::MESH:
-		delete mesh;
-		break;
-	case ResourceType::SPRITESOURCE:
-		delete spriteSource;
-		break;
-	case ResourceType::TEXTURE:
-		delete texture;
-		break;
+		if (!atlas.AddImageFile(*it))
+			OutputDebugStringA(("Texture " + *it + " could not be added to atlas " + atlasName + "\n").c_str());
 	}
+
+	atlas.Pack();
+
+	// Pages are only created here, so they can't be loaded from a file later.
+	std::vector<Color> pixels;
+	for (unsigned page = 0; page < atlas.GetPageCount(); page++)
+	{
+		std::string pageName = TextureAtlas::GetPageName(atlasName, page);
+		atlas.GetPagePixels(page, pixels);
+		AddTexture(pageName, new Texture(pixels, atlas.GetPageWidth(), atlas.GetPageHeight()));
+
+		if (std::find(builtAtlasPages.begin(), builtAtlasPages.end(), pageName) == builtAtlasPages.end())
+			builtAtlasPages.push_back(pageName);
+	}
+
+	atlas.GetRegions(atlasName, atlasRegions);
 }
 
 //------------------------------------------------------------------------------
 // Private Functions:
 //------------------------------------------------------------------------------
 
+// Creates a quad mesh, remembering its shape so that FitMesh can make copies of it.
+// Params:
+//   objectName = The name of the mesh.
+//   textureSize = The UV size of the mesh.
+//   extents = The extents of the mesh.
+Mesh* ResourceManager::AddQuadMesh(const std::string& objectName, Vector2D textureSize, Vector2D extents)
+{
+	quadShapes[objectName] = std::make_pair(textureSize, extents);
+	return AddMesh(objectName, CreateQuadMesh(textureSize, extents));
+}
+
 // Creates a texture if the given texture name is not "none"
 // Params:
 //   textureName = The file to load the texture from.
@@ -319,22 +520,56 @@ Texture* ResourceManager::CreateTextureFromFile(const std::string& textureName)
 {
 	if (textureName == "none")
 		return nullptr;
+
+	// Use the cached copy of the image if it is up to date, or decode it and add it to the cache.
+	DecodedImage image;
+	if (AssetLoader::DecodeImageFile(Texture::GetFilePath() + textureName, image, &textureCache))
+		return new Texture(image.pixels, image.width, image.height);
+
+	// Fall back to the regular loader, so errors are reported the same way.
 	return Texture::CreateTextureFromFile(textureName);
 }
 
-// Gets the number of references to the specified resource.
+// Creates the texture for a decoded image and gives it to the sprite source waiting on it.
 // Params:
-//   objectName = The name of the object.
-// Returns:
-//   How many times the resource has been referenced.
-unsigned ResourceManager::GetResourceReferenceCount(const std::string& objectName)
+//   image = The decoded image.
+void ResourceManager::FinishTextureLoad(DecodedImage& image)
 {
-	auto it = resources.find(objectName);
+	// Ignore images that were requested before the resources were unloaded.
+	auto pending = std::find(pendingTextures.begin(), pendingTextures.end(), image.name);
+	if (pending == pendingTextures.end())
+		return;
+
+	pendingTextures.erase(pending);
+
+	// Preloaded textures that no sprite source is waiting on yet are left unreferenced until a level asks for them.
+	SpriteSource* spriteSource = spriteSources.Get(spriteSources.Find(image.name));
 
-	if (it == resources.end())
-		return 0;
+	// The texture may have been loaded directly while this one was decoding.
+	Texture* texture = textures.Get(textures.Find(image.name));
+	if (texture == nullptr)
+	{
+		// If the image couldn't be decoded here, fall back to the regular loader so errors are reported the same way.
+		if (image.succeeded)
+			texture = new Texture(image.pixels, image.width, image.height);
+		else
+			texture = Texture::CreateTextureFromFile(image.name);
+
+		texture = textures.Get(textures.Add(image.name, texture, spriteSource != nullptr));
+	}
+
+	if (spriteSource != nullptr)
+		spriteSource->SetTexture(texture);
+}
+
+// Returns the texture used by sprite sources whose textures are still loading.
+Texture* ResourceManager::GetPlaceholderTexture()
+{
+	// A single transparent pixel, so nothing shows up until the real texture is ready.
+	if (placeholderTexture == nullptr)
+		placeholderTexture = new Texture(std::vector<Color>(1, Color(1.0f, 1.0f, 1.0f, 0.0f)), 1, 1);
 
-	return it->second->references;
+	return placeholderTexture;
 }
 
 //------------------------------------------------------------------------------
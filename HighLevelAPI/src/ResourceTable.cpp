@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ResourceTable.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "ResourceTable.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Hashes a resource name using 32-bit FNV-1a.
+// Params:
+//   name = The name to hash.
+// Returns:
+//   The hash of the name.
+unsigned HashResourceName(const std::string& name)
+{
+	unsigned hash = 2166136261u;
+	for (auto it = name.begin(); it != name.end(); ++it)
+	{
+		hash ^= static_cast<unsigned char>(*it);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------
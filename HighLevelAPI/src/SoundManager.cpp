@@ -43,7 +43,8 @@ namespace
 //------------------------------------------------------------------------------
 
 // Constructor - initializes FMOD.
-SoundManager::SoundManager() : BetaObject("SoundManager"), numSounds(0), numBanks(0),
+SoundManager::SoundManager() : BetaObject("SoundManager"),
+	soundLoadTime(0.0f), bankLoadTime(0.0f), effectVoices(defaultMaxEffectVoices), effectStartCount(0),
 	musicChannel(nullptr), effectsChannelGroup(nullptr), system(nullptr), studioSystem(nullptr),
 	musicVolume(1.0f), effectsVolume(0.0f),
 	audioFilePath("Audio/"), bankFilePath("Banks/"), eventPrefix("event:/")
@@ -75,24 +76,46 @@ void SoundManager::Update(float dt)
 
 	// Update all sounds.
 	FMOD_Assert(studioSystem->update());
+
+	// Make room for new effects where old ones have finished.
+	UpdateVoices();
+
+	// Check on banks that are loading.
+	UpdateBanks();
 }
 
 // Shutdown the sound manager.
 void SoundManager::Shutdown(void)
 {
+	// Releasing the sounds stops their channels, so forget about them.
+	for (auto it = effectVoices.begin(); it != effectVoices.end(); ++it)
+		it->channel = nullptr;
+	musicChannel = nullptr;
+
 	// Unload all sounds.
-	for (size_t i = 0; i < numSounds; i++)
+	for (auto it = soundList.begin(); it != soundList.end(); ++it)
 	{
-		FMOD_Assert(soundList[i]->release());
+		FMOD_Assert((*it)->release());
 	}
-	numSounds = 0;
+	soundList.clear();
+	soundsByName.clear();
 
-	// Unload all banks.
-	for (size_t i = 0; i < numBanks; i++)
+	// Unload all banks, including ones that haven't finished loading.
+	for (auto it = bankList.begin(); it != bankList.end(); ++it)
 	{
-		FMOD_Assert(bankList[i]->unload());
+		FMOD_Assert((*it)->unload());
 	}
-	numBanks = 0;
+	bankList.clear();
+	bankNames.clear();
+
+	for (auto it = pendingBanks.begin(); it != pendingBanks.end(); ++it)
+	{
+		FMOD_Assert(it->bank->unload());
+	}
+	pendingBanks.clear();
+
+	// Unloading the banks invalidates their events.
+	eventDescriptions.clear();
 }
 
 // Creates a non-looping FMOD sound.
@@ -108,21 +131,41 @@ void SoundManager::AddEffect(const std::string& filename)
 //	 filename = Name of the music file (MP3).
 void SoundManager::AddMusic(const std::string& filename)
 {
-	AddSound(filename, FMOD_DEFAULT | FMOD_LOOP_NORMAL);
+	// Stream music from disk instead of decoding the whole track into memory.
+	AddSound(filename, FMOD_CREATESTREAM | FMOD_LOOP_NORMAL);
 }
 
-// Creates an FMOD sound bank
+// Starts loading an FMOD sound bank in the background. Its events
+// can't be played until IsBankLoaded returns true.
 // Params:
 //   filename = Name of the FMOD bank file.
 void SoundManager::AddBank(const std::string& filename)
 {
 	// Build the full bank file path.
 	std::string fullFilePath = "Assets/" + audioFilePath + bankFilePath + filename;
-	FMOD::Studio::Bank* bank;
+	PendingBank pendingBank = { filename, nullptr, std::chrono::steady_clock::now() };
+
+	// Start loading the bank file. Update moves it to the bank list once it's ready.
+	FMOD_RESULT result = studioSystem->loadBankFile(fullFilePath.c_str(), FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &pendingBank.bank);
+	FMOD_Assert(result);
+	if (result == FMOD_OK)
+		pendingBanks.push_back(pendingBank);
+}
+
+// Checks whether a bank has finished loading.
+// Params:
+//   filename = Name of the FMOD bank file.
+// Returns:
+//   True if the bank is loaded, false if it is still loading, failed, or was never added.
+bool SoundManager::IsBankLoaded(const std::string& filename) const
+{
+	return std::find(bankNames.begin(), bankNames.end(), filename) != bankNames.end();
+}
 
-	// Load the bank file and add it to the bank list.
-	FMOD_Assert(studioSystem->loadBankFile(fullFilePath.c_str(), FMOD_STUDIO_LOAD_BANK_NORMAL, &bank));
-	bankList[numBanks++] = bank;
+// Checks whether any banks are still loading.
+bool SoundManager::IsLoading() const
+{
+	return !pendingBanks.empty();
 }
 
 // Plays a sound with the specified name.
@@ -132,36 +175,38 @@ void SoundManager::AddBank(const std::string& filename)
 //   The channel that was used to play the given sound.
 FMOD::Channel* SoundManager::PlaySound(const std::string& name_)
 {
-	// Temporary variables to store sound properties.
-	char soundName[100] = { 0 };
-	FMOD_MODE soundMode;
+	return PlaySound(name_, defaultPriority);
+}
 
-	// Loop through all loaded sounds.
-	for (size_t i = 0; i < numSounds; i++)
-	{
-		// Get the current sound's name.
-		FMOD_Assert(soundList[i]->getName(soundName, 100));
-		
-		// Skip the sound if its name does not match.
-		if (strcmp(soundName, name_.c_str()))
-			continue;
+// Plays a sound with the specified name and priority.
+// Params:
+//	 name = The name of the sound to be played.
+//   priority = How important the sound is, from 0 (most) to 256 (least). If every
+//     effect voice is busy, the least important effect that is not more important
+//     than this one is stopped to make room.
+// Return:
+//   The channel that was used to play the given sound, or nullptr if there was no room.
+FMOD::Channel* SoundManager::PlaySound(const std::string& name_, int priority)
+{
+	// Find the sound with the given name.
+	auto it = soundsByName.find(name_);
+	if (it == soundsByName.end())
+		return nullptr;
 
-		// Get the current sound's mode.
-		FMOD_Assert(soundList[i]->getMode(&soundMode));
+	// Get the sound's mode.
+	FMOD_MODE soundMode;
+	FMOD_Assert(it->second->getMode(&soundMode));
 
-		if (soundMode & FMOD_CREATESTREAM)
-		{
-			// If the sound is an MP3, it's music.
-			return PlayMusic(soundList[i]);
-		}
-		else
-		{
-			// If the sound is not an MP3, it's a sound effect.
-			return PlayEffect(soundList[i]);
-		}
+	if (soundMode & FMOD_CREATESTREAM)
+	{
+		// If the sound is an MP3, it's music.
+		return PlayMusic(it->second);
+	}
+	else
+	{
+		// If the sound is not an MP3, it's a sound effect.
+		return PlayEffect(it->second, priority);
 	}
-
-	return nullptr;
 }
 
 // Starts an audio event with the given name.
@@ -175,11 +220,28 @@ FMOD::Studio::EventInstance* SoundManager::PlayEvent(const std::string& name_)
 	FMOD::Studio::EventDescription* eventDescription;
 	FMOD::Studio::EventInstance* eventInstance;
 
-	// Find the specified event.
-	FMOD_Assert(studioSystem->getEvent(fullEventName.c_str(), &eventDescription));
+	// Find the specified event, asking FMOD only the first time it is played.
+	auto it = eventDescriptions.find(fullEventName);
+	if (it != eventDescriptions.end())
+	{
+		eventDescription = it->second;
+	}
+	else
+	{
+		// The event's bank may still be loading, so don't remember failures.
+		FMOD_RESULT result = studioSystem->getEvent(fullEventName.c_str(), &eventDescription);
+		FMOD_Assert(result);
+		if (result != FMOD_OK)
+			return nullptr;
+
+		eventDescriptions[fullEventName] = eventDescription;
+	}
 
 	// Create a new instance of the specified event.
-	FMOD_Assert(eventDescription->createInstance(&eventInstance));
+	FMOD_RESULT result = eventDescription->createInstance(&eventInstance);
+	FMOD_Assert(result);
+	if (result != FMOD_OK)
+		return nullptr;
 
 	return eventInstance;
 }
@@ -223,6 +285,37 @@ float SoundManager::GetEffectsVolume() const
 	return effectsVolume;
 }
 
+// Set how many sound effects can play at once.
+// Params:
+//   count = The number of effect voices.
+void SoundManager::SetMaxEffectVoices(unsigned count)
+{
+	// Stop the effects on any voices that are going away.
+	for (size_t i = count; i < effectVoices.size(); i++)
+	{
+		if (effectVoices[i].channel != nullptr)
+			effectVoices[i].channel->stop();
+	}
+
+	Voice freeVoice = { nullptr, 0, 0 };
+	effectVoices.resize(count, freeVoice);
+}
+
+// Gets memory and load time statistics for audio.
+SoundMetrics SoundManager::GetMetrics() const
+{
+	SoundMetrics metrics;
+
+	FMOD_Assert(FMOD::Memory_GetStats(&metrics.currentMemory, &metrics.peakMemory, false));
+	metrics.soundLoadTime = soundLoadTime;
+	metrics.bankLoadTime = bankLoadTime;
+	metrics.soundCount = soundList.size();
+	metrics.bankCount = bankList.size();
+	metrics.pendingBankCount = pendingBanks.size();
+
+	return metrics;
+}
+
 //------------------------------------------------------------------------------
 // Private Functions:
 //------------------------------------------------------------------------------
@@ -232,14 +325,29 @@ float SoundManager::GetEffectsVolume() const
 // Plays a sound effect.
 // Params:
 //   sound = The sound instance.
+//   priority = How important the sound is, from 0 (most) to 256 (least).
 // Returns:
-//   The channel the sound is using.
-FMOD::Channel* SoundManager::PlayEffect(FMOD::Sound* sound) const
+//   The channel the sound is using, or nullptr if no voice was free.
+FMOD::Channel* SoundManager::PlayEffect(FMOD::Sound* sound, int priority)
 {
+	Voice* voice = AcquireVoice(priority);
+	if (voice == nullptr)
+		return nullptr;
+
 	FMOD::Channel* channel;
 
-	// Play the sound in the sound effects channel group.
-	FMOD_Assert(system->playSound(sound, effectsChannelGroup, false, &channel));
+	// Play the sound in the sound effects channel group, paused until its priority is set.
+	FMOD_RESULT result = system->playSound(sound, effectsChannelGroup, true, &channel);
+	FMOD_Assert(result);
+	if (result != FMOD_OK)
+		return nullptr;
+
+	FMOD_Assert(channel->setPriority(priority));
+	FMOD_Assert(channel->setPaused(false));
+
+	voice->channel = channel;
+	voice->priority = priority;
+	voice->startOrder = effectStartCount++;
 
 	return channel;
 }
@@ -261,6 +369,106 @@ FMOD::Channel* SoundManager::PlayMusic(FMOD::Sound* sound)
 	return musicChannel;
 }
 
+// Finds a voice for a new effect, stopping a less important one if every voice is busy.
+// Params:
+//   priority = The priority of the new effect.
+// Returns:
+//   The voice to play the effect on, or nullptr if every voice is playing something more important.
+SoundManager::Voice* SoundManager::AcquireVoice(int priority)
+{
+	size_t index = FindVoice(effectVoices, priority);
+	if (index == effectVoices.size())
+		return nullptr;
+
+	// The effect may have already finished, in which case FMOD reports the channel as invalid.
+	Voice& voice = effectVoices[index];
+	if (voice.channel != nullptr)
+	{
+		voice.channel->stop();
+		voice.channel = nullptr;
+	}
+
+	return &voice;
+}
+
+// Picks the voice a new effect should use, without touching any channels.
+// Params:
+//   voices = The voices to pick from.
+//   priority = The priority of the new effect.
+// Returns:
+//   The index of a free voice, or else of the voice to steal, or voices.size() if there is no room.
+size_t SoundManager::FindVoice(const std::vector<Voice>& voices, int priority)
+{
+	size_t stolen = voices.size();
+
+	for (size_t i = 0; i < voices.size(); ++i)
+	{
+		if (voices[i].channel == nullptr)
+			return i;
+
+		// Larger numbers are less important. Of equally important effects, steal the oldest.
+		if (stolen == voices.size() || voices[i].priority > voices[stolen].priority
+			|| (voices[i].priority == voices[stolen].priority && voices[i].startOrder < voices[stolen].startOrder))
+			stolen = i;
+	}
+
+	// Don't interrupt anything more important than the new effect.
+	if (stolen == voices.size() || voices[stolen].priority < priority)
+		return voices.size();
+
+	return stolen;
+}
+
+// Frees the voices whose effects have finished playing.
+void SoundManager::UpdateVoices()
+{
+	for (auto it = effectVoices.begin(); it != effectVoices.end(); ++it)
+	{
+		if (it->channel == nullptr)
+			continue;
+
+		// Finished channels are reused by FMOD, so asking about them returns an error.
+		bool isPlaying = false;
+		if (it->channel->isPlaying(&isPlaying) != FMOD_OK || !isPlaying)
+			it->channel = nullptr;
+	}
+}
+
+// Moves banks that have finished loading into the bank list.
+void SoundManager::UpdateBanks()
+{
+	for (auto it = pendingBanks.begin(); it != pendingBanks.end(); )
+	{
+		FMOD_STUDIO_LOADING_STATE state;
+		FMOD_RESULT result = it->bank->getLoadingState(&state);
+
+		// Keep waiting on banks that are still loading.
+		if (result == FMOD_OK && state == FMOD_STUDIO_LOADING_STATE_LOADING)
+		{
+			++it;
+			continue;
+		}
+
+		if (result == FMOD_OK && state == FMOD_STUDIO_LOADING_STATE_LOADED)
+		{
+			std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - it->startTime;
+			bankLoadTime += elapsed.count();
+
+			bankList.push_back(it->bank);
+			bankNames.push_back(it->filename);
+		}
+		else
+		{
+			// The bank failed to load, so get rid of it.
+			std::cout << "Failed to load bank " << it->filename << std::endl;
+			FMOD_Assert(result);
+			it->bank->unload();
+		}
+
+		it = pendingBanks.erase(it);
+	}
+}
+
 // Add FX/BGM helper
 
 // Loads a sound file and adds it to the sound list.
@@ -272,10 +480,24 @@ void SoundManager::AddSound(const std::string& filename, FMOD_MODE mode)
 	// Build the full sound file path.
 	std::string fullFilePath = "Assets/" + audioFilePath + filename;
 	FMOD::Sound* sound;
+	auto start = std::chrono::steady_clock::now();
 
 	// Load the sound file with the specified mode and add it to the sound list.
-	FMOD_Assert(system->createSound(fullFilePath.c_str(), mode, nullptr, &sound));
-	soundList[numSounds++] = sound;
+	FMOD_RESULT result = system->createSound(fullFilePath.c_str(), mode, nullptr, &sound);
+	FMOD_Assert(result);
+
+	std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+	soundLoadTime += elapsed.count();
+
+	if (result != FMOD_OK)
+		return;
+
+	soundList.push_back(sound);
+
+	// Look the sound up by the name FMOD gives it, so playing it doesn't have to ask every sound.
+	char soundName[256] = { 0 };
+	FMOD_Assert(sound->getName(soundName, sizeof(soundName)));
+	soundsByName[soundName] = sound;
 }
 
 //------------------------------------------------------------------------------
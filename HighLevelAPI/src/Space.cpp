@@ -18,6 +18,15 @@
 
 // Systems
 #include "Level.h"
+#include "Parser.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Where level manifests are kept between runs, alongside the other cached data.
+	const std::string manifestDirectory = "Assets/Cache/";
+}
 
 //------------------------------------------------------------------------------
 
@@ -33,6 +42,8 @@
 Space::Space(const std::string& name) : BetaObject(name),
 	paused(false), currentLevel(nullptr), nextLevel(nullptr), objectManager(this)
 {
+	// Sprite sources use the atlas packed ahead of time, if there is one.
+	resourceManager.LoadAtlas(TextureAtlas::GetDefaultName());
 }
 
 // Destructor
@@ -46,6 +57,9 @@ Space::~Space()
 //   dt = The change in time since the last call to this function.
 void Space::Update(float dt)
 {
+	// Finish any textures that were loaded in the background.
+	resourceManager.Update();
+
 	objectManager.Update(dt);
 
 	// If there is a next level, handle level changing logic.
@@ -126,6 +140,9 @@ void Space::SetLevel(Level* level)
 	if (nextLevel != nullptr)
 	{
 		nextLevel->SetParent(this);
+
+		// Start on the level's textures now, so fewer are left to load when the level changes.
+		PreloadLevel(nextLevel->GetName());
 	}
 }
 
@@ -135,6 +152,50 @@ void Space::RestartLevel()
 	nextLevel = currentLevel;
 }
 
+// Starts loading a level's textures in the background while the current level runs.
+// Only levels that have been loaded before, in this run or an earlier one, have a known manifest; others are ignored.
+// SetLevel already calls this, so only call it to start even earlier.
+// Params:
+//   levelName = The name of the level that will be loaded.
+void Space::PreloadLevel(const std::string& levelName)
+{
+	auto manifest = levelManifests.find(levelName);
+	if (manifest == levelManifests.end())
+	{
+		// Levels that haven't been loaded in this run may have been in an earlier one.
+		ResourceManifest savedManifest;
+		if (!LoadManifest(levelName, savedManifest))
+			return;
+
+		manifest = levelManifests.emplace(levelName, savedManifest).first;
+	}
+
+	resourceManager.Preload(manifest->second);
+}
+
+// Returns how long, in seconds, the most recent change to the current level took to load and initialize.
+float Space::GetLevelLoadTime() const
+{
+	if (currentLevel == nullptr)
+		return 0.0f;
+
+	return GetLevelLoadTime(currentLevel->GetName());
+}
+
+// Returns how long, in seconds, a level took to load and initialize the last time it was changed to.
+// Params:
+//   levelName = The name of the level.
+// Returns:
+//   The load time, or 0 if the level hasn't been loaded in this space.
+float Space::GetLevelLoadTime(const std::string& levelName) const
+{
+	auto loadTime = levelLoadTimes.find(levelName);
+	if (loadTime == levelLoadTimes.end())
+		return 0.0f;
+
+	return loadTime->second;
+}
+
 // Returns the object manager, which you can use to retrieve and add objects.
 GameObjectManager& Space::GetObjectManager()
 {
@@ -154,6 +215,8 @@ ResourceManager& Space::GetResourceManager()
 // Updates current/next level pointers and calls shutdown/unload/load/init
 void Space::ChangeLevel()
 {
+	auto start = std::chrono::steady_clock::now();
+
 	// If the current level exists, shut it down.
 	if (currentLevel != nullptr)
 		currentLevel->Shutdown();
@@ -180,16 +243,97 @@ void Space::ChangeLevel()
 		// Set the current level to the next level.
 		currentLevel = nextLevel;
 
-		// Load the next level.
+		// Load the next level. Resources the last level also used are still loaded, and are kept.
 		currentLevel->Load();
 		resourceManager.OnLevelLoad();
+
+		// Remember what the level used, so it can be preloaded next time, even in a later run.
+		ResourceManifest& manifest = levelManifests[currentLevel->GetName()];
+		manifest = resourceManager.GetManifest();
+		SaveManifest(currentLevel->GetName(), manifest);
 	}
 
 	// Initialize the next level.
 	currentLevel->Initialize();
 
+	std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+	levelLoadTimes[currentLevel->GetName()] = elapsed.count();
+
 	// Set the next level to a nullptr 
 	nextLevel = nullptr;
 }
 
+// Returns the file a level's manifest is kept in between runs.
+// Params:
+//   levelName = The name of the level.
+std::string Space::GetManifestPath(const std::string& levelName)
+{
+	return manifestDirectory + levelName + ".manifest";
+}
+
+// Reads a level's manifest from the last run that loaded it.
+// Params:
+//   levelName = The name of the level.
+//   manifest = The manifest to fill in.
+// Returns:
+//   True if the manifest was read, false otherwise.
+bool Space::LoadManifest(const std::string& levelName, ResourceManifest& manifest)
+{
+	// Levels that have never been loaded have no file, which isn't worth reporting.
+	if (GetFileAttributesA(GetManifestPath(levelName).c_str()) == INVALID_FILE_ATTRIBUTES)
+		return false;
+
+	try
+	{
+		Parser parser(GetManifestPath(levelName), std::fstream::in);
+
+		size_t textureCount;
+		parser.ReadVariable("textureCount", textureCount);
+
+		parser.ReadSkip("textures");
+		parser.ReadSkip(':');
+		parser.ReadSkip("{");
+
+		manifest.textures.resize(textureCount);
+		for (size_t i = 0; i < textureCount; i++)
+			parser.ReadValue(manifest.textures[i]);
+
+		parser.ReadSkip("}");
+	}
+	catch (const ParseException& parseException)
+	{
+		OutputDebugStringA((std::string(parseException.what()) + "\n").c_str());
+		return false;
+	}
+
+	return true;
+}
+
+// Writes a level's manifest, so later runs can preload the level the first time it is loaded.
+// Params:
+//   levelName = The name of the level.
+//   manifest = The manifest to save.
+void Space::SaveManifest(const std::string& levelName, const ResourceManifest& manifest)
+{
+	// Make sure the folder exists. This fails harmlessly if it already does.
+	CreateDirectoryA(manifestDirectory.c_str(), nullptr);
+
+	try
+	{
+		Parser parser(GetManifestPath(levelName), std::fstream::out);
+
+		parser.WriteVariable("textureCount", manifest.textures.size());
+
+		parser.WriteValue("textures : ");
+		parser.BeginScope();
+		for (auto it = manifest.textures.begin(); it != manifest.textures.end(); ++it)
+			parser.WriteValue(*it);
+		parser.EndScope();
+	}
+	catch (const ParseException& parseException)
+	{
+		OutputDebugStringA((std::string(parseException.what()) + "\n").c_str());
+	}
+}
+
 //------------------------------------------------------------------------------
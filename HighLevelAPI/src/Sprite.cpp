@@ -46,7 +46,7 @@
 //------------------------------------------------------------------------------
 
 // Create a new sprite object.
-Sprite::Sprite() : Component("Sprite"), frameIndex(0), spriteSource(nullptr), mesh(nullptr), color(Colors::White), transform(nullptr)
+Sprite::Sprite() : Component("Sprite"), frameIndex(0), spriteSource(nullptr), mesh(nullptr), fittedMesh(nullptr), color(Colors::White), transform(nullptr)
 {
 
 }
@@ -61,6 +61,7 @@ Component* Sprite::Clone() const
 void Sprite::Initialize()
 {
 	transform = static_cast<Transform*>(GetOwner()->GetComponent<Transform>());
+	FitMesh();
 }
 
 // Loads object data from a file.
@@ -99,7 +100,7 @@ void Sprite::Draw(const Vector2D& offset)
 	}
 
 	// Exit if there is no mesh.
-	if (mesh == nullptr)
+	if (fittedMesh == nullptr)
 	{
 		return;
 	}
@@ -117,7 +118,7 @@ void Sprite::Draw(const Vector2D& offset)
 	}
 
 	CS230::Matrix2D offsetTransform = CS230::Matrix2D::TranslationMatrix(offset.x, offset.y);
-	CS230::Matrix2D fullTransform = offsetTransform * transform->GetMatrix();
+	CS230::Matrix2D fullTransform = offsetTransform * transform->GetDrawMatrix();
 
 	// Set the translation & scale for the mesh.
 	Graphics::GetInstance().SetTransform(reinterpret_cast<const Matrix2D&>(fullTransform));
@@ -125,7 +126,7 @@ void Sprite::Draw(const Vector2D& offset)
 	Graphics::GetInstance().SetSpriteBlendColor(color);
 
 	// Draw the mesh.
-	mesh->Draw();
+	fittedMesh->Draw();
 }
 
 // Set a sprite's transparency (between 0.0f and 1.0f).
@@ -165,6 +166,7 @@ unsigned Sprite::GetFrame() const
 void Sprite::SetMesh(Mesh* mesh_)
 {
 	mesh = mesh_;
+	FitMesh();
 }
 
 // Set a new SpriteSource for the specified sprite.
@@ -173,6 +175,7 @@ void Sprite::SetMesh(Mesh* mesh_)
 void Sprite::SetSpriteSource(SpriteSource* spriteSource_)
 {
 	spriteSource = spriteSource_;
+	FitMesh();
 }
 
 // Set the blend color for the specified sprite.
@@ -190,3 +193,20 @@ const Color& Sprite::GetColor() const
 }
 
 //------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Picks the mesh to draw with, once the sprite is in a space that can make fitted meshes.
+// A sprite source packed into an atlas only covers part of its page, so a mesh that
+// wasn't made for it is swapped for a copy with UVs the size of one frame.
+void Sprite::FitMesh()
+{
+	fittedMesh = mesh;
+
+	if (mesh == nullptr || spriteSource == nullptr || GetOwner() == nullptr || GetOwner()->GetSpace() == nullptr)
+		return;
+
+	fittedMesh = GetOwner()->GetSpace()->GetResourceManager().FitMesh(mesh, spriteSource);
+}
+
+//------------------------------------------------------------------------------
@@ -38,7 +38,8 @@
 //	 numCols = The number of columns in the sprite sheet.
 //	 numRows = The number of rows in the sprite sheet.
 //	 texture = A pointer to a texture that has been loaded by the Alpha Engine.
-SpriteSource::SpriteSource(int numCols, int numRows, Texture* texture) : numCols(numCols), numRows(numRows), texture(texture)
+SpriteSource::SpriteSource(int numCols, int numRows, Texture* texture) : numCols(numCols), numRows(numRows), texture(texture), ready(true),
+	regionOffset(0.0f, 0.0f), regionSize(1.0f, 1.0f)
 {
 }
 
@@ -50,6 +51,30 @@ Texture* SpriteSource::GetTexture() const
 	return texture;
 }
 
+// Sets the texture once it has finished loading, marking the sprite source as ready.
+// Params:
+//   texture = The loaded texture.
+void SpriteSource::SetTexture(Texture* texture_)
+{
+	texture = texture_;
+	ready = true;
+}
+
+// Uses a stand-in texture until the real one is given with SetTexture.
+// Params:
+//   placeholder = The texture to draw with while loading.
+void SpriteSource::SetPlaceholder(Texture* placeholder)
+{
+	texture = placeholder;
+	ready = false;
+}
+
+// Returns whether the texture has finished loading. If not, GetTexture returns a placeholder.
+bool SpriteSource::IsReady() const
+{
+	return ready;
+}
+
 // Returns the maximum number of frames possible, given the dimensions of the sprite sheet.
 // Returns:
 //	 The calculated frame count.
@@ -65,16 +90,15 @@ unsigned SpriteSource::GetFrameCount() const
 void SpriteSource::GetUV(unsigned int frameIndex, Vector2D& textureCoords) const
 {
 	// Calculate the size of a single cell on the UV.
-	float uSize = 1.0f / numCols;
-	float vSize = 1.0f / numRows;
+	Vector2D frameSize = GetFrameSize();
 
 	// Calculate the column & row of the specified frame index.
 	int col = frameIndex % numCols;
 	int row = frameIndex / numCols;
 
-	// Set the output texture coordinates to the proper location.
-	textureCoords.x = col * uSize;
-	textureCoords.y = row * vSize;
+	// Set the output texture coordinates to the proper location within the region.
+	textureCoords.x = regionOffset.x + col * frameSize.x;
+	textureCoords.y = regionOffset.y + row * frameSize.y;
 }
 
 // Returns the number of rows in the sprite source.
@@ -89,4 +113,26 @@ unsigned SpriteSource::GetNumCols() const
 	return numCols;
 }
 
+// Limits the sprite sheet to a region of the texture, such as when it has been packed into an atlas.
+// Params:
+//   offset = The UV coordinates of the top left of the region.
+//   size = The UV size of the region.
+void SpriteSource::SetRegion(const Vector2D& offset, const Vector2D& size)
+{
+	regionOffset = offset;
+	regionSize = size;
+}
+
+// Returns whether the sprite sheet only covers a region of the texture.
+bool SpriteSource::HasRegion() const
+{
+	return regionOffset.x != 0.0f || regionOffset.y != 0.0f || regionSize.x != 1.0f || regionSize.y != 1.0f;
+}
+
+// Returns the UV size of a single frame, taking the region into account.
+Vector2D SpriteSource::GetFrameSize() const
+{
+	return Vector2D(regionSize.x / numCols, regionSize.y / numRows);
+}
+
 //----------------------------------------------------------------------------
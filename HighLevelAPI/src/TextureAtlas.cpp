@@ -0,0 +1,552 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TextureAtlas.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "TextureAtlas.h"
+
+// Systems
+#include <Texture.h>
+#include "AssetLoader.h"
+#include "Parser.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// The name of the atlas packed ahead of time.
+	const std::string defaultAtlasName = "Atlas";
+
+	// Checks whether a file is one of the pages of an atlas.
+	// Params:
+	//   fileName = The name of the file, without its folder.
+	//   atlasName = The name of the atlas.
+	// Returns:
+	//   True if the file is named like a page of the atlas, false otherwise.
+	bool IsPageFile(const std::string& fileName, const std::string& atlasName)
+	{
+		const std::string extension = ".png";
+		if (fileName.size() <= atlasName.size() + extension.size() || fileName.compare(0, atlasName.size(), atlasName) != 0)
+			return false;
+
+		size_t numberEnd = fileName.size() - extension.size();
+		if (fileName.compare(numberEnd, extension.size(), extension) != 0)
+			return false;
+
+		for (size_t i = atlasName.size(); i < numberEnd; i++)
+		{
+			if (fileName[i] < '0' || fileName[i] > '9')
+				return false;
+		}
+
+		return true;
+	}
+
+	// Converts a color channel to a byte, clamping it to the valid range.
+	// Params:
+	//   value = The channel, from 0 to 1.
+	// Returns:
+	//   The channel, from 0 to 255.
+	BYTE ChannelToByte(float value)
+	{
+		return static_cast<BYTE>(max(0.0f, min(1.0f, value)) * 255.0f + 0.5f);
+	}
+
+	// Saves colors as a PNG file using the Windows Imaging Component.
+	// Params:
+	//   filename = The path of the file to write.
+	//   pixels = The image's colors, starting at the top left, one row at a time.
+	//   width = The width of the image.
+	//   height = The height of the image.
+	// Returns:
+	//   True if the file was written, false otherwise.
+	bool SavePNGFile(const std::string& filename, const std::vector<Color>& pixels, unsigned width, unsigned height)
+	{
+		std::vector<BYTE> bytes(pixels.size() * 4);
+		for (size_t i = 0; i < pixels.size(); i++)
+		{
+			bytes[i * 4 + 0] = ChannelToByte(pixels[i].b);
+			bytes[i * 4 + 1] = ChannelToByte(pixels[i].g);
+			bytes[i * 4 + 2] = ChannelToByte(pixels[i].r);
+			bytes[i * 4 + 3] = ChannelToByte(pixels[i].a);
+		}
+
+		HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+		IWICImagingFactory* factory = nullptr;
+		IWICStream* stream = nullptr;
+		IWICBitmapEncoder* encoder = nullptr;
+		IWICBitmapFrameEncode* frame = nullptr;
+		std::wstring wideFilename(filename.begin(), filename.end());
+		WICPixelFormatGUID format = GUID_WICPixelFormat32bppBGRA;
+
+		HRESULT result = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory));
+		if (SUCCEEDED(result))
+			result = factory->CreateStream(&stream);
+		if (SUCCEEDED(result))
+			result = stream->InitializeFromFilename(wideFilename.c_str(), GENERIC_WRITE);
+		if (SUCCEEDED(result))
+			result = factory->CreateEncoder(GUID_ContainerFormatPng, nullptr, &encoder);
+		if (SUCCEEDED(result))
+			result = encoder->Initialize(stream, WICBitmapEncoderNoCache);
+		if (SUCCEEDED(result))
+			result = encoder->CreateNewFrame(&frame, nullptr);
+		if (SUCCEEDED(result))
+			result = frame->Initialize(nullptr);
+		if (SUCCEEDED(result))
+			result = frame->SetSize(width, height);
+		if (SUCCEEDED(result))
+			result = frame->SetPixelFormat(&format);
+
+		// The encoder may pick a different format, which this doesn't convert to.
+		if (SUCCEEDED(result) && format != GUID_WICPixelFormat32bppBGRA)
+			result = E_FAIL;
+
+		if (SUCCEEDED(result))
+			result = frame->WritePixels(height, width * 4, static_cast<UINT>(bytes.size()), bytes.data());
+		if (SUCCEEDED(result))
+			result = frame->Commit();
+		if (SUCCEEDED(result))
+			result = encoder->Commit();
+
+		if (frame != nullptr)
+			frame->Release();
+		if (encoder != nullptr)
+			encoder->Release();
+		if (stream != nullptr)
+			stream->Release();
+		if (factory != nullptr)
+			factory->Release();
+		if (SUCCEEDED(comResult))
+			CoUninitialize();
+
+		return SUCCEEDED(result);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   pageWidth = The width of each page, in pixels.
+//   pageHeight = The height of each page, in pixels.
+//   padding = How many pixels to leave around each image. The padding is filled with
+//     copies of the image's edges, so filtering near the edge doesn't pick up neighboring images.
+TextureAtlas::TextureAtlas(unsigned pageWidth, unsigned pageHeight, unsigned padding)
+	: pageWidth(pageWidth), pageHeight(pageHeight), padding(padding), pageCount(0)
+{
+}
+
+// Adds an image to be packed.
+// Params:
+//   name = The texture name of the image.
+//   pixels = The image's colors, starting at the top left, one row at a time.
+//   width = The width of the image.
+//   height = The height of the image.
+// Returns:
+//   True if the image was added, false if it is too large to fit on a page.
+bool TextureAtlas::AddImage(const std::string& name, const std::vector<Color>& pixels, unsigned width, unsigned height)
+{
+	if (width == 0 || height == 0 || width + 2 * padding > pageWidth || height + 2 * padding > pageHeight)
+		return false;
+
+	Image image;
+	image.name = name;
+	image.pixels = pixels;
+	image.width = width;
+	image.height = height;
+	image.page = 0;
+	image.x = 0;
+	image.y = 0;
+	images.push_back(image);
+
+	return true;
+}
+
+// Reads, decodes, and adds an image from the texture folder.
+// Params:
+//   textureName = The filename of the texture.
+// Returns:
+//   True if the image was added, false if it couldn't be read or is too large to fit on a page.
+bool TextureAtlas::AddImageFile(const std::string& textureName)
+{
+	DecodedImage image;
+	if (!AssetLoader::DecodeImageFile(Texture::GetFilePath() + textureName, image))
+		return false;
+
+	return AddImage(textureName, image.pixels, image.width, image.height);
+}
+
+// Adds every PNG in the texture folder, except the pages of an earlier save of the same atlas.
+// Images that can't be added are reported and left out, to be loaded on their own.
+// Params:
+//   atlasName = The name the atlas will be saved as.
+// Returns:
+//   True if any images were added, false otherwise.
+bool TextureAtlas::AddAllImageFiles(const std::string& atlasName)
+{
+	const std::string& texturePath = Texture::GetFilePath();
+
+	WIN32_FIND_DATAA findData;
+	HANDLE find = FindFirstFileA((texturePath + "*.png").c_str(), &findData);
+	if (find == INVALID_HANDLE_VALUE)
+	{
+		OutputDebugStringA(("No textures found to pack in " + texturePath + "\n").c_str());
+		return false;
+	}
+
+	size_t imageCount = images.size();
+	do
+	{
+		std::string textureName = findData.cFileName;
+		if (IsPageFile(textureName, atlasName))
+			continue;
+
+		if (!AddImageFile(textureName))
+			OutputDebugStringA(("Texture " + textureName + " could not be added to atlas " + atlasName + "\n").c_str());
+	} while (FindNextFileA(find, &findData));
+
+	FindClose(find);
+	return images.size() > imageCount;
+}
+
+// Places every image that has been added on a page.
+void TextureAtlas::Pack()
+{
+	// Placing tall images first leaves a flatter skyline for the short ones.
+	std::vector<size_t> order(images.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+
+	std::sort(order.begin(), order.end(), [this](size_t a, size_t b)
+	{
+		if (images[a].height != images[b].height)
+			return images[a].height > images[b].height;
+		return images[a].width > images[b].width;
+	});
+
+	std::vector<std::vector<SkylineNode>> skylines;
+
+	for (auto it = order.begin(); it != order.end(); ++it)
+	{
+		Image& image = images[*it];
+		unsigned width = image.width + 2 * padding;
+		unsigned height = image.height + 2 * padding;
+
+		// Use the first page with room, or start a new one.
+		unsigned x = 0;
+		unsigned y = 0;
+		size_t index = 0;
+		unsigned page = 0;
+		while (page < skylines.size() && !FindPosition(skylines[page], width, height, x, y, index))
+			++page;
+
+		if (page == skylines.size())
+		{
+			SkylineNode ground = { 0, 0, pageWidth };
+			skylines.push_back(std::vector<SkylineNode>(1, ground));
+			FindPosition(skylines[page], width, height, x, y, index);
+		}
+
+		AddToSkyline(skylines[page], index, x, y, width, height);
+		image.page = page;
+		image.x = x;
+		image.y = y;
+	}
+
+	pageCount = static_cast<unsigned>(skylines.size());
+}
+
+// Returns how many pages the images were packed into.
+unsigned TextureAtlas::GetPageCount() const
+{
+	return pageCount;
+}
+
+// Creates the colors of a page, including the padding around each image.
+// Params:
+//   page = The index of the page.
+//   pixels = The page's colors, starting at the top left, one row at a time.
+void TextureAtlas::GetPagePixels(unsigned page, std::vector<Color>& pixels) const
+{
+	pixels.assign(static_cast<size_t>(pageWidth) * pageHeight, Color(0.0f, 0.0f, 0.0f, 0.0f));
+
+	for (auto it = images.begin(); it != images.end(); ++it)
+	{
+		if (it->page != page)
+			continue;
+
+		// Copy the image, extending its edges out into the padding.
+		unsigned paddedWidth = it->width + 2 * padding;
+		unsigned paddedHeight = it->height + 2 * padding;
+		for (unsigned row = 0; row < paddedHeight; row++)
+		{
+			unsigned sourceRow = min(it->height - 1, row > padding ? row - padding : 0);
+			for (unsigned col = 0; col < paddedWidth; col++)
+			{
+				unsigned sourceCol = min(it->width - 1, col > padding ? col - padding : 0);
+				pixels[(it->y + row) * pageWidth + it->x + col] = it->pixels[sourceRow * it->width + sourceCol];
+			}
+		}
+	}
+}
+
+// Returns the width of each page, in pixels.
+unsigned TextureAtlas::GetPageWidth() const
+{
+	return pageWidth;
+}
+
+// Returns the height of each page, in pixels.
+unsigned TextureAtlas::GetPageHeight() const
+{
+	return pageHeight;
+}
+
+// Gets where each image was packed.
+// Params:
+//   atlasName = The name of the atlas, used to name the pages.
+//   regions = The map to add the regions to, by texture name.
+void TextureAtlas::GetRegions(const std::string& atlasName, std::map<std::string, AtlasRegion>& regions) const
+{
+	for (auto it = images.begin(); it != images.end(); ++it)
+	{
+		AtlasRegion& region = regions[it->name];
+		region.page = GetPageName(atlasName, it->page);
+		region.uvOffset = Vector2D(static_cast<float>(it->x + padding) / pageWidth, static_cast<float>(it->y + padding) / pageHeight);
+		region.uvSize = Vector2D(static_cast<float>(it->width) / pageWidth, static_cast<float>(it->height) / pageHeight);
+	}
+}
+
+// Saves the pages as PNG files and writes a manifest listing where each image was packed.
+// Everything is written to the texture folder, so the pages can be loaded like any other texture.
+// Params:
+//   atlasName = The name of the atlas. The manifest is saved as atlasName.txt.
+// Returns:
+//   True if every file was written, false otherwise.
+bool TextureAtlas::Save(const std::string& atlasName) const
+{
+	std::vector<Color> pixels;
+	for (unsigned page = 0; page < pageCount; page++)
+	{
+		GetPagePixels(page, pixels);
+		if (!SavePNGFile(Texture::GetFilePath() + GetPageName(atlasName, page), pixels, pageWidth, pageHeight))
+			return false;
+	}
+
+	try
+	{
+		Parser parser(Texture::GetFilePath() + atlasName + ".txt", std::fstream::out);
+
+		parser.WriteVariable("pageWidth", pageWidth);
+		parser.WriteVariable("pageHeight", pageHeight);
+		parser.WriteVariable("pageCount", pageCount);
+		parser.WriteVariable("regionCount", images.size());
+
+		// Each region is written as its name, page, and pixel rectangle.
+		parser.WriteValue("regions : ");
+		parser.BeginScope();
+		for (auto it = images.begin(); it != images.end(); ++it)
+		{
+			parser.WriteValue(it->name + " " + std::to_string(it->page) + " " + std::to_string(it->x + padding) + " "
+				+ std::to_string(it->y + padding) + " " + std::to_string(it->width) + " " + std::to_string(it->height));
+		}
+		parser.EndScope();
+	}
+	catch (const ParseException& parseException)
+	{
+		std::cout << parseException.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+// Reads a manifest written by Save.
+// Params:
+//   atlasName = The name of the atlas.
+//   regions = The map to add the regions to, by texture name.
+// Returns:
+//   True if the manifest was read, false otherwise.
+bool TextureAtlas::LoadManifest(const std::string& atlasName, std::map<std::string, AtlasRegion>& regions)
+{
+	try
+	{
+		Parser parser(Texture::GetFilePath() + atlasName + ".txt", std::fstream::in);
+
+		float atlasWidth;
+		float atlasHeight;
+		unsigned atlasPageCount;
+		size_t regionCount;
+		parser.ReadVariable("pageWidth", atlasWidth);
+		parser.ReadVariable("pageHeight", atlasHeight);
+		parser.ReadVariable("pageCount", atlasPageCount);
+		parser.ReadVariable("regionCount", regionCount);
+
+		parser.ReadSkip("regions");
+		parser.ReadSkip(':');
+		parser.ReadSkip("{");
+
+		for (size_t i = 0; i < regionCount; i++)
+		{
+			std::string name;
+			unsigned page;
+			float x, y, width, height;
+			parser.ReadValue(name);
+			parser.ReadValue(page);
+			parser.ReadValue(x);
+			parser.ReadValue(y);
+			parser.ReadValue(width);
+			parser.ReadValue(height);
+
+			AtlasRegion& region = regions[name];
+			region.page = GetPageName(atlasName, page);
+			region.uvOffset = Vector2D(x / atlasWidth, y / atlasHeight);
+			region.uvSize = Vector2D(width / atlasWidth, height / atlasHeight);
+		}
+
+		parser.ReadSkip("}");
+	}
+	catch (const ParseException& parseException)
+	{
+		std::cout << parseException.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+// Returns the texture name of a page of an atlas.
+// Params:
+//   atlasName = The name of the atlas.
+//   page = The index of the page.
+std::string TextureAtlas::GetPageName(const std::string& atlasName, unsigned page)
+{
+	return atlasName + std::to_string(page) + ".png";
+}
+
+// Returns the name of the atlas packed ahead of time with the "-atlas" command line option.
+const std::string& TextureAtlas::GetDefaultName()
+{
+	return defaultAtlasName;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Finds the lowest spot on a page that a rectangle fits in.
+// Params:
+//   skyline = The page's skyline.
+//   width = The width of the rectangle.
+//   height = The height of the rectangle.
+//   x = The left of the spot that was found.
+//   y = The top of the spot that was found.
+//   index = The skyline node the spot starts at.
+// Returns:
+//   True if the rectangle fits on the page, false otherwise.
+bool TextureAtlas::FindPosition(const std::vector<SkylineNode>& skyline, unsigned width, unsigned height,
+	unsigned& x, unsigned& y, size_t& index) const
+{
+	bool found = false;
+	unsigned bestBottom = 0;
+	unsigned bestWidth = 0;
+
+	for (size_t i = 0; i < skyline.size(); i++)
+	{
+		// Nodes are in order from left to right, so nothing further along fits either.
+		unsigned left = skyline[i].x;
+		if (left + width > pageWidth)
+			break;
+
+		// The rectangle has to sit on the highest node it spans.
+		unsigned top = 0;
+		unsigned covered = 0;
+		for (size_t j = i; covered < width; j++)
+		{
+			top = max(top, skyline[j].y);
+			covered += skyline[j].width;
+		}
+
+		if (top + height > pageHeight)
+			continue;
+
+		// Prefer the spot that keeps the skyline lowest, then the one that wastes the least of a node.
+		if (!found || top + height < bestBottom || (top + height == bestBottom && skyline[i].width < bestWidth))
+		{
+			found = true;
+			bestBottom = top + height;
+			bestWidth = skyline[i].width;
+			x = left;
+			y = top;
+			index = i;
+		}
+	}
+
+	return found;
+}
+
+// Raises the skyline over a rectangle that was just placed.
+// Params:
+//   skyline = The page's skyline.
+//   index = The skyline node the rectangle starts at.
+//   x = The left of the rectangle.
+//   y = The top of the rectangle.
+//   width = The width of the rectangle.
+//   height = The height of the rectangle.
+void TextureAtlas::AddToSkyline(std::vector<SkylineNode>& skyline, size_t index, unsigned x, unsigned y, unsigned width, unsigned height)
+{
+	SkylineNode node = { x, y + height, width };
+	skyline.insert(skyline.begin() + index, node);
+
+	// Shrink or remove the nodes the rectangle now covers.
+	for (size_t i = index + 1; i < skyline.size();)
+	{
+		unsigned coveredRight = skyline[i - 1].x + skyline[i - 1].width;
+		if (skyline[i].x >= coveredRight)
+			break;
+
+		unsigned overlap = coveredRight - skyline[i].x;
+		if (skyline[i].width <= overlap)
+		{
+			skyline.erase(skyline.begin() + i);
+			continue;
+		}
+
+		skyline[i].x += overlap;
+		skyline[i].width -= overlap;
+		break;
+	}
+
+	// Join neighboring nodes at the same height.
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
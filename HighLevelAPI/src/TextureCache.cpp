@@ -0,0 +1,306 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TextureCache.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "TextureCache.h"
+
+// Systems
+#include <Texture.h>
+#include "AssetLoader.h"
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Increase this whenever the layout of an entry changes, so old entries are rebuilt.
+	const unsigned cacheVersion = 2;
+
+	// The pixel formats an entry can be stored in.
+	enum CacheFormat
+	{
+		CacheFormatRGBA8 = 0,
+	};
+
+	// The start of every cache entry. The pixels follow directly after.
+	struct EntryHeader
+	{
+		char magic[4];                 // Always "BTXC".
+		unsigned version;              // The cacheVersion the entry was written with.
+		unsigned long long sourceHash; // The hash of the source file's contents, checked when cooking.
+		unsigned long long sourceSize; // The size of the source file.
+		unsigned long long sourceTime; // The last time the source file was written to.
+		unsigned width;
+		unsigned height;
+		unsigned format;               // A CacheFormat.
+		unsigned reserved;
+	};
+
+	static_assert(sizeof(EntryHeader) == 48, "Cache entries are read straight from disk, so the header can't have hidden padding.");
+
+	const char entryMagic[4] = { 'B', 'T', 'X', 'C' };
+
+	// Hashes a block of memory using 64-bit FNV-1a.
+	// Params:
+	//   data = The memory to hash.
+	//   size = How many bytes to hash.
+	// Returns:
+	//   The hash of the memory.
+	unsigned long long HashBytes(const char* data, size_t size)
+	{
+		unsigned long long hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	// Gets the size and last write time of a source file, which together stand in for its contents.
+	// Params:
+	//   filename = The path of the source file.
+	//   size = The size of the file.
+	//   time = The last time the file was written to.
+	// Returns:
+	//   True if the file exists, false otherwise.
+	bool GetSourceStamp(const std::string& filename, unsigned long long& size, unsigned long long& time)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+		if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &attributes))
+			return false;
+
+		size = (static_cast<unsigned long long>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+		time = (static_cast<unsigned long long>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+		return true;
+	}
+
+	// Checks whether an entry header belongs to the current version of a source file, without reading the source.
+	// Params:
+	//   header = The header of the entry.
+	//   filename = The path of the source file.
+	// Returns:
+	//   True if the header matches the source file's size and last write time, false otherwise.
+	bool MatchesSource(const EntryHeader& header, const std::string& filename)
+	{
+		unsigned long long size;
+		unsigned long long time;
+		return GetSourceStamp(filename, size, time)
+			&& std::equal(entryMagic, entryMagic + 4, header.magic)
+			&& header.version == cacheVersion
+			&& header.format == CacheFormatRGBA8
+			&& header.sourceSize == size
+			&& header.sourceTime == time;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   directory = The folder to keep cache entries in.
+TextureCache::TextureCache(const std::string& directory) : directory(directory)
+{
+}
+
+// Reads the cached image for a source file, if there is one and it is up to date.
+// Entries are matched on the source file's size and last write time, so the source is never read.
+// Params:
+//   filename = The path of the source file.
+//   image = The image to store the cached size and colors in.
+// Returns:
+//   True if a matching entry was found, false otherwise.
+bool TextureCache::Read(const std::string& filename, DecodedImage& image) const
+{
+	HANDLE file = CreateFileA(GetEntryPath(filename).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Map the entry instead of reading it, so the pixels are only copied once.
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = nullptr;
+	const char* view = nullptr;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= static_cast<LONGLONG>(sizeof(EntryHeader)))
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping != nullptr)
+		view = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+	bool found = false;
+	if (view != nullptr)
+	{
+		const EntryHeader& header = *reinterpret_cast<const EntryHeader*>(view);
+		unsigned long long pixelBytes = static_cast<unsigned long long>(header.width) * header.height * 4;
+
+		// Only use entries for this version of the file, written by this version, that weren't cut short.
+		found = MatchesSource(header, filename)
+			&& static_cast<unsigned long long>(fileSize.QuadPart) == sizeof(EntryHeader) + pixelBytes;
+
+		if (found)
+		{
+			const BYTE* pixels = reinterpret_cast<const BYTE*>(view + sizeof(EntryHeader));
+			const float scale = 1.0f / 255.0f;
+
+			image.width = header.width;
+			image.height = header.height;
+			image.pixels.resize(static_cast<size_t>(header.width) * header.height);
+			for (size_t i = 0; i < image.pixels.size(); i++)
+			{
+				const BYTE* pixel = &pixels[i * 4];
+				image.pixels[i] = Color(pixel[0] * scale, pixel[1] * scale, pixel[2] * scale, pixel[3] * scale);
+			}
+		}
+
+		UnmapViewOfFile(view);
+	}
+
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	CloseHandle(file);
+
+	return found;
+}
+
+// Writes a decoded image to the cache, replacing any older entry for the same file.
+// Params:
+//   filename = The path of the source file.
+//   sourceData = The contents of the source file.
+//   image = The decoded image.
+// Returns:
+//   True if the entry was written, false otherwise.
+bool TextureCache::Write(const std::string& filename, const std::vector<char>& sourceData, const DecodedImage& image) const
+{
+	EntryHeader header;
+	if (!GetSourceStamp(filename, header.sourceSize, header.sourceTime))
+		return false;
+
+	// Make sure the folder exists. This fails harmlessly if it already does.
+	CreateDirectoryA(directory.c_str(), nullptr);
+
+	std::copy(entryMagic, entryMagic + 4, header.magic);
+	header.version = cacheVersion;
+	header.sourceHash = HashBytes(sourceData.data(), sourceData.size());
+	header.width = image.width;
+	header.height = image.height;
+	header.format = CacheFormatRGBA8;
+	header.reserved = 0;
+
+	std::vector<BYTE> pixels(image.pixels.size() * 4);
+	for (size_t i = 0; i < image.pixels.size(); i++)
+	{
+		const Color& color = image.pixels[i];
+		pixels[i * 4 + 0] = static_cast<BYTE>(max(0.0f, min(1.0f, color.r)) * 255.0f + 0.5f);
+		pixels[i * 4 + 1] = static_cast<BYTE>(max(0.0f, min(1.0f, color.g)) * 255.0f + 0.5f);
+		pixels[i * 4 + 2] = static_cast<BYTE>(max(0.0f, min(1.0f, color.b)) * 255.0f + 0.5f);
+		pixels[i * 4 + 3] = static_cast<BYTE>(max(0.0f, min(1.0f, color.a)) * 255.0f + 0.5f);
+	}
+
+	std::ofstream file(GetEntryPath(filename), std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+	return static_cast<bool>(file);
+}
+
+// Decodes an image file and writes it to the cache, unless an up to date entry already exists.
+// Unlike Read, this hashes the source file, so entries whose source changed without its
+// size or write time changing (or that were copied from elsewhere) are rebuilt.
+// Params:
+//   filename = The path of the source file.
+// Returns:
+//   True if the cache has an up to date entry afterward, false otherwise.
+bool TextureCache::Cook(const std::string& filename) const
+{
+	std::ifstream source(filename, std::ios::binary);
+	if (!source.is_open())
+		return false;
+
+	std::vector<char> sourceData((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+	source.close();
+
+	EntryHeader header;
+	std::ifstream entry(GetEntryPath(filename), std::ios::binary);
+	bool upToDate = entry.read(reinterpret_cast<char*>(&header), sizeof(header))
+		&& MatchesSource(header, filename)
+		&& header.sourceHash == HashBytes(sourceData.data(), sourceData.size());
+	entry.close();
+
+	if (upToDate)
+		return true;
+
+	// Throw the stale entry away, so decoding can't be skipped by reading it.
+	DeleteFileA(GetEntryPath(filename).c_str());
+
+	DecodedImage image;
+	return AssetLoader::DecodeImageFile(filename, image, this);
+}
+
+// Cooks every PNG file in the texture folder. Problems are reported with OutputDebugString,
+// since this runs before the engine (and its console) starts.
+// Returns:
+//   True if at least one file was found and every file was cooked, false otherwise.
+bool TextureCache::CookAll() const
+{
+	const std::string& texturePath = Texture::GetFilePath();
+
+	// Finding nothing to cook almost certainly means the cooker is running from the wrong folder.
+	WIN32_FIND_DATAA findData;
+	HANDLE find = FindFirstFileA((texturePath + "*.png").c_str(), &findData);
+	if (find == INVALID_HANDLE_VALUE)
+	{
+		OutputDebugStringA(("No textures found to cook in " + texturePath + "\n").c_str());
+		return false;
+	}
+
+	bool succeeded = true;
+	do
+	{
+		std::string filename = texturePath + findData.cFileName;
+		if (!Cook(filename))
+		{
+			OutputDebugStringA(("Texture " + filename + " could not be cooked.\n").c_str());
+			succeeded = false;
+		}
+	} while (FindNextFileA(find, &findData));
+
+	FindClose(find);
+	return succeeded;
+}
+
+// Returns the path of the cache entry for a source file.
+// Params:
+//   filename = The path of the source file.
+std::string TextureCache::GetEntryPath(const std::string& filename) const
+{
+	// Flatten the source path into a single file name.
+	std::string entryName = filename;
+	std::replace_if(entryName.begin(), entryName.end(), [](char c) { return c == '/' || c == '\\' || c == ':'; }, '_');
+
+	return directory + entryName + ".cache";
+}
+
+// Returns the format version written to new entries. Entries with other versions are ignored.
+unsigned TextureCache::GetVersion()
+{
+	return cacheVersion;
+}
+
+//------------------------------------------------------------------------------
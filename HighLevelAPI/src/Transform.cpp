@@ -19,6 +19,7 @@
 
 // Systems
 #include "../include/Parser.h"
+#include <Interpolation.h>
 
 //------------------------------------------------------------------------------
 
@@ -40,7 +41,8 @@
 //	 y = Initial world position on the y-axis.
 Transform::Transform(float x, float y) : Component("Transform"),
 	translation(Vector2D(x, y)), scale(Vector2D(50.0f, 50.0f)), rotation(0.0f),
-	matrix(CS230::Matrix2D()), isDirty(true)
+	matrix(CS230::Matrix2D()), rotationDirection(1.0f, 0.0f), isAxisAligned(true), isDirty(true), matrixVersion(0),
+	previousRotation(0.0f), hasPreviousState(false), isDrawInterpolated(false)
 {
 }
 
@@ -51,7 +53,8 @@ Transform::Transform(float x, float y) : Component("Transform"),
 //   rotation	 = Rotation of the object about the z-axis.
 Transform::Transform(Vector2D translation, Vector2D scale, float rotation) : Component("Transform"),
 	translation(translation), scale(scale), rotation(rotation),
-	matrix(CS230::Matrix2D()), isDirty(true)
+	matrix(CS230::Matrix2D()), rotationDirection(1.0f, 0.0f), isAxisAligned(true), isDirty(true), matrixVersion(0),
+	previousRotation(0.0f), hasPreviousState(false), isDrawInterpolated(false)
 {
 }
 
@@ -101,6 +104,17 @@ const CS230::Matrix2D& Transform::GetInverseMatrix()
 	return inverseMatrix;
 }
 
+// Get a counter that changes every time the transform matrix changes.
+// Lets other components cache data derived from the matrix.
+// Returns:
+//	 The current version of the transform matrix.
+unsigned Transform::GetMatrixVersion()
+{
+	CalculateMatrices();
+
+	return matrixVersion;
+}
+
 // Set the translation of a transform component.
 // Params:
 //	 translation = Reference to a translation vector.
@@ -143,6 +157,26 @@ float Transform::GetRotation() const
 	return rotation;
 }
 
+// Get the direction the object's x-axis points in, (cos, sin) of the rotation.
+// Cached with the matrix, so it is cheaper than calling cos and sin directly.
+// Returns:
+//	 A reference to the unit vector.
+const Vector2D& Transform::GetRotationDirection()
+{
+	CalculateMatrices();
+
+	return rotationDirection;
+}
+
+// Get whether the rotation is a multiple of 90 degrees, so anything
+// aligned with the object's axes is also aligned with the world's axes.
+bool Transform::IsAxisAligned()
+{
+	CalculateMatrices();
+
+	return isAxisAligned;
+}
+
 // Set the scale of a transform component.
 // Params:
 //	 translation = Reference to a scale vector.
@@ -164,6 +198,61 @@ const Vector2D& Transform::GetScale() const
 	return scale;
 }
 
+// Remembers the current translation, rotation, and scale as the start of a fixed step,
+// so drawing can blend between them and the state at the end of the step.
+void Transform::SavePreviousState()
+{
+	previousTranslation = translation;
+	previousRotation = rotation;
+	previousScale = scale;
+	hasPreviousState = true;
+}
+
+// Forgets the previous state so the object is drawn exactly where it is.
+// Call this after teleporting an object so it doesn't smear across the screen.
+void Transform::ResetInterpolation()
+{
+	if (hasPreviousState)
+		SavePreviousState();
+
+	isDrawInterpolated = false;
+}
+
+// Blends the previous and current state to get the matrix used for drawing.
+// Params:
+//   alpha = How far between the last fixed step and the next one the frame is (0 to 1).
+void Transform::Interpolate(float alpha)
+{
+	// Objects that haven't moved since the last step are drawn with the regular matrix.
+	isDrawInterpolated = hasPreviousState && (previousRotation != rotation
+		|| !AlmostEqual(previousTranslation, translation) || !AlmostEqual(previousScale, scale));
+
+	if (!isDrawInterpolated)
+		return;
+
+	// Turn the shortest way around, so wrapping from -PI to PI doesn't spin the object.
+	float rotationDelta = std::remainder(rotation - previousRotation, 2.0f * M_PI_F);
+
+	Vector2D drawTranslation = ::Interpolate(previousTranslation, translation, alpha);
+	float drawRotation = previousRotation + rotationDelta * alpha;
+	Vector2D drawScale = ::Interpolate(previousScale, scale, alpha);
+
+	drawMatrix = CS230::Matrix2D::TranslationMatrix(drawTranslation.x, drawTranslation.y)
+		* CS230::Matrix2D::RotationMatrixRadians(drawRotation)
+		* CS230::Matrix2D::ScalingMatrix(drawScale.x, drawScale.y);
+}
+
+// Get the matrix objects should be drawn with.
+// Returns:
+//	 The blended matrix if the object has moved since its last fixed step, the transform matrix otherwise.
+const CS230::Matrix2D& Transform::GetDrawMatrix()
+{
+	if (isDrawInterpolated)
+		return drawMatrix;
+
+	return GetMatrix();
+}
+
 //------------------------------------------------------------------------------
 // Private Functions:
 //------------------------------------------------------------------------------
@@ -175,22 +264,40 @@ void Transform::CalculateMatrices()
 	// Check if the matrix needs to be recalculated.
 	if (isDirty)
 	{
-		// Recalculate the matrix.
-		CS230::Matrix2D translationMatrix = CS230::Matrix2D::TranslationMatrix(translation.x, translation.y);
-		CS230::Matrix2D rotationMatrix = CS230::Matrix2D::RotationMatrixRadians(rotation);
-		CS230::Matrix2D scalingMatrix = CS230::Matrix2D::ScalingMatrix(scale.x, scale.y);
+		float cosine = cosf(rotation);
+		float sine = sinf(rotation);
+		rotationDirection = Vector2D(cosine, sine);
 
-		matrix = translationMatrix * rotationMatrix * scalingMatrix;
+		// sin(2x) is only zero at multiples of 90 degrees.
+		isAxisAligned = AlmostEqual(sine * cosine, 0.0f);
 
-		// Recalculate the inverse matrix.
-		CS230::Matrix2D invTranslationMatrix = CS230::Matrix2D::TranslationMatrix(-translation.x, -translation.y);
-		CS230::Matrix2D invRotationMatrix = CS230::Matrix2D::RotationMatrixRadians(-rotation);
-		CS230::Matrix2D invScalingMatrix = CS230::Matrix2D::ScalingMatrix(1.0f / scale.x, 1.0f / scale.y);
+		// Recalculate the matrix, translation * rotation * scale written out.
+		matrix.m[0][0] = cosine * scale.x;
+		matrix.m[0][1] = -sine * scale.y;
+		matrix.m[0][2] = translation.x;
+		matrix.m[1][0] = sine * scale.x;
+		matrix.m[1][1] = cosine * scale.y;
+		matrix.m[1][2] = translation.y;
+		matrix.m[2][0] = 0.0f;
+		matrix.m[2][1] = 0.0f;
+		matrix.m[2][2] = 1.0f;
 
-		inverseMatrix = invScalingMatrix * invRotationMatrix * invTranslationMatrix;
+		// Recalculate the inverse matrix, inverse scale * inverse rotation * inverse translation written out.
+		float inverseScaleX = 1.0f / scale.x;
+		float inverseScaleY = 1.0f / scale.y;
+		inverseMatrix.m[0][0] = cosine * inverseScaleX;
+		inverseMatrix.m[0][1] = sine * inverseScaleX;
+		inverseMatrix.m[0][2] = -(cosine * translation.x + sine * translation.y) * inverseScaleX;
+		inverseMatrix.m[1][0] = -sine * inverseScaleY;
+		inverseMatrix.m[1][1] = cosine * inverseScaleY;
+		inverseMatrix.m[1][2] = (sine * translation.x - cosine * translation.y) * inverseScaleY;
+		inverseMatrix.m[2][0] = 0.0f;
+		inverseMatrix.m[2][1] = 0.0f;
+		inverseMatrix.m[2][2] = 1.0f;
 
 		// Mark the current matrix as clean.
 		isDirty = false;
+		++matrixVersion;
 	}
 }
 
@@ -37,7 +37,8 @@ namespace Behaviors
 	// Forward Declarations:
 	//------------------------------------------------------------------------------
 
-	void ColorChangeCollisionHandler(GameObject& object, GameObject& other);
+	void ColorChangeCollisionEnterHandler(GameObject& object, GameObject& other);
+	void ColorChangeCollisionExitHandler(GameObject& object, GameObject& other);
 
 	//------------------------------------------------------------------------------
 	// Public Functions:
@@ -50,7 +51,7 @@ namespace Behaviors
 	//   collidedColorTime = The amount of time the object will retain the collided color.
 	ColorChange::ColorChange(const Color& normalColor, const Color& collidedColor, float collidedColorTime) :
 		Component("ColorChange"), sprite(nullptr), normalColor(normalColor), collidedColor(collidedColor),
-		collidedColorTime(collidedColorTime), collided(false), timer(0.0f)
+		collidedColorTime(collidedColorTime), contactCount(0), timer(0.0f)
 	{
 	}
 
@@ -66,9 +67,11 @@ namespace Behaviors
 		// Store the required components for ease of access.
 		sprite = GetOwner()->GetComponent<Sprite>();
 
-		// Set the object's collision handler to ours.
+		// Set the object's collision handlers to ours. We only need to know when
+		// contacts start and end, not every step they persist.
 		Collider* collider = GetOwner()->GetComponent<Collider>();
-		collider->SetCollisionHandler(&Behaviors::ColorChangeCollisionHandler);
+		collider->SetCollisionEnterHandler(&Behaviors::ColorChangeCollisionEnterHandler);
+		collider->SetCollisionExitHandler(&Behaviors::ColorChangeCollisionExitHandler);
 	}
 
 	// Loads object data from a file.
@@ -96,15 +99,12 @@ namespace Behaviors
 	//   dt = The (fixed) change in time since the last step.
 	void ColorChange::Update(float dt)
 	{
-		if (collided)
+		if (contactCount != 0)
 		{
 			// If the object is colliding with something, change its color.
 			sprite->SetColor(collidedColor);
 
-			// Mark that we have acknowledged this collision.
-			collided = false;
-
-			// Set the timer so the color persists for a short time.
+			// Set the timer so the color persists for a short time after the last contact ends.
 			timer = collidedColorTime;
 		}
 		else if (timer <= 0.0f)
@@ -116,16 +116,30 @@ namespace Behaviors
 		timer -= dt;
 	}
 
-	// Collision handler for ColorChange objects.
+	// Collision enter handler for ColorChange objects.
+	// Params:
+	//   object = The first object.
+	//   other  = The other object the first object started colliding with.
+	void ColorChangeCollisionEnterHandler(GameObject& object, GameObject& other)
+	{
+		UNREFERENCED_PARAMETER(other);
+
+		// Count the new contact.
+		ColorChange* colorChange = object.GetComponent<ColorChange>();
+		++colorChange->contactCount;
+	}
+
+	// Collision exit handler for ColorChange objects.
 	// Params:
 	//   object = The first object.
-	//   other  = The other object the first object is colliding with.
-	void ColorChangeCollisionHandler(GameObject& object, GameObject& other)
+	//   other  = The other object the first object stopped colliding with.
+	void ColorChangeCollisionExitHandler(GameObject& object, GameObject& other)
 	{
 		UNREFERENCED_PARAMETER(other);
 
-		// Mark the object as collided.
+		// Forget the contact that ended.
 		ColorChange* colorChange = object.GetComponent<ColorChange>();
-		colorChange->collided = true;
+		if (colorChange->contactCount != 0)
+			--colorChange->contactCount;
 	}
 }
@@ -68,11 +68,17 @@ namespace Behaviors
 		//   dt = The (fixed) change in time since the last step.
 		void Update(float dt) override;
 
-		// Collision handler for ColorChange objects.
+		// Collision enter handler for ColorChange objects.
 		// Params:
 		//   object = The first object.
-		//   other  = The other object the first object is colliding with.
-		friend void ColorChangeCollisionHandler(GameObject& object, GameObject& other);
+		//   other  = The other object the first object started colliding with.
+		friend void ColorChangeCollisionEnterHandler(GameObject& object, GameObject& other);
+
+		// Collision exit handler for ColorChange objects.
+		// Params:
+		//   object = The first object.
+		//   other  = The other object the first object stopped colliding with.
+		friend void ColorChangeCollisionExitHandler(GameObject& object, GameObject& other);
 
 	private:
 		//------------------------------------------------------------------------------
@@ -88,7 +94,7 @@ namespace Behaviors
 		float collidedColorTime;
 
 		// Other variables
-		bool collided;
+		unsigned contactCount;
 		float timer;
 	};
 }
@@ -19,6 +19,8 @@
 #include <Engine.h>
 
 // Engine modules
+#include <ModuleRegistry.h>
+#include <JobSystem.h>
 #include "Space.h"
 
 // Initial game state
@@ -27,6 +29,10 @@
 // Game object factory
 #include <GameObjectFactory.h>
 
+// Texture cooking and atlas packing
+#include <TextureCache.h>
+#include <TextureAtlas.h>
+
 // Components
 #include "ColorChange.h"
 #include "MonkeyAnimation.h"
@@ -53,10 +59,29 @@ int WINAPI WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In
 
 	// Unused parameters
 	UNREFERENCED_PARAMETER(prevInstance);
-	UNREFERENCED_PARAMETER(command_line);
 	UNREFERENCED_PARAMETER(show);
 	UNREFERENCED_PARAMETER(instance);
 
+	// "-cook" fills the texture cache ahead of time and exits without starting the engine.
+	// It fails if any texture can't be cooked, or if there are none to cook.
+	if (strstr(command_line, "-cook") != nullptr)
+	{
+		TextureCache cache;
+		return cache.CookAll() ? 0 : 1;
+	}
+
+	// "-atlas" packs every texture into the atlas that spaces load on startup, and exits.
+	// It fails if there are no textures to pack, or if the atlas can't be saved.
+	if (strstr(command_line, "-atlas") != nullptr)
+	{
+		TextureAtlas atlas;
+		if (!atlas.AddAllImageFiles(TextureAtlas::GetDefaultName()))
+			return 1;
+
+		atlas.Pack();
+		return atlas.Save(TextureAtlas::GetDefaultName()) ? 0 : 1;
+	}
+
 	GameObjectFactory& objectFactory = GameObjectFactory::GetInstance();
 
 	// Register components with the game object factory so game objects can be fully deserialized.
@@ -77,10 +102,16 @@ int WINAPI WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In
 	space->SetLevel<Levels::Level1>();
 
 	// Add additional modules to engine
-	Engine::GetInstance().AddModule(space);
+	ModuleRegistry& moduleRegistry = ModuleRegistry::GetInstance();
+	moduleRegistry.RegisterModule(new JobSystem());
+	moduleRegistry.RegisterModule<Space, JobSystem>(space);
+	moduleRegistry.AddModulesToEngine();
 	
 	// Game engine goes!
 	Engine::GetInstance().Start(940, 720, 200);
 
+	// The engine deleted its modules when it stopped.
+	moduleRegistry.ReleaseModules();
+
 	return 0;
 }
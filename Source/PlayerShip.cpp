@@ -90,8 +90,8 @@ namespace Behaviors
 		transform = GetOwner()->GetComponent<Transform>();
 		physics = GetOwner()->GetComponent<Physics>();
 
-		// Add the collision handler to the collider.
-		GetOwner()->GetComponent<Collider>()->SetCollisionHandler(CollisionHandlerShip);
+		// Add the collision handler to the collider. Only new contacts can start the death animation.
+		GetOwner()->GetComponent<Collider>()->SetCollisionEnterHandler(CollisionHandlerShip);
 
 		GameObject* owner = GetOwner();
 		Space* space = owner->GetSpace();
@@ -228,8 +228,10 @@ namespace Behaviors
 			bulletTransform->SetTranslation(transform->GetTranslation() + direction * 32.0f);
 			bulletTransform->SetRotation(transform->GetRotation());
 
-			// Set the bullet's velocity.
-			bullet->GetComponent<Physics>()->SetVelocity(direction * bulletSpeed);
+			// Set the bullet's velocity. Bullets are fast and small, so sweep their collisions.
+			Physics* bulletPhysics = bullet->GetComponent<Physics>();
+			bulletPhysics->SetVelocity(direction * bulletSpeed);
+			bulletPhysics->SetContinuousCollision(true);
 
 			// Set the bullet's spawner.
 			bullet->GetComponent<PlayerProjectile>()->SetSpawner(this);
@@ -95,8 +95,12 @@ namespace Behaviors
 			translation.y = screenDimensions.top + scale.y;
 		}
 
-		// Set the udpated translation.
-		transform->SetTranslation(translation);
+		// Set the udpated translation, snapping instead of blending if the object wrapped.
+		if (!AlmostEqual(translation, transform->GetTranslation()))
+		{
+			transform->SetTranslation(translation);
+			transform->ResetInterpolation();
+		}
 	}
 }
 